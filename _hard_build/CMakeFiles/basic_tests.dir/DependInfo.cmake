@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/tests/binary_conversions.cpp" "CMakeFiles/basic_tests.dir/src/tests/binary_conversions.cpp.o" "gcc" "CMakeFiles/basic_tests.dir/src/tests/binary_conversions.cpp.o.d"
+  "/root/repo/src/tests/constants.cpp" "CMakeFiles/basic_tests.dir/src/tests/constants.cpp.o" "gcc" "CMakeFiles/basic_tests.dir/src/tests/constants.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_hard_build/CMakeFiles/sac-format.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
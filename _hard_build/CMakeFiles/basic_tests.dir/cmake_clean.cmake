@@ -0,0 +1,14 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/basic_tests.dir/src/tests/binary_conversions.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/tests/binary_conversions.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/tests/constants.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/tests/constants.cpp.o.d"
+  "basic_tests"
+  "basic_tests.pdb"
+  "basic_tests_tests-b12d07c.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/basic_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datetime_tests.dir/src/tests/datetime.cpp.o"
+  "CMakeFiles/datetime_tests.dir/src/tests/datetime.cpp.o.d"
+  "datetime_tests"
+  "datetime_tests.pdb"
+  "datetime_tests_tests-b12d07c.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/datetime_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/list_sac.dir/src/examples/list_sac.cpp.o"
+  "CMakeFiles/list_sac.dir/src/examples/list_sac.cpp.o.d"
+  "list_sac"
+  "list_sac.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/list_sac.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/processing_tests.dir/src/tests/processing.cpp.o"
+  "CMakeFiles/processing_tests.dir/src/tests/processing.cpp.o.d"
+  "processing_tests"
+  "processing_tests.pdb"
+  "processing_tests_tests-b12d07c.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/processing_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sac-format.dir/src/processing.cpp.o"
+  "CMakeFiles/sac-format.dir/src/processing.cpp.o.d"
+  "CMakeFiles/sac-format.dir/src/sac_format.cpp.o"
+  "CMakeFiles/sac-format.dir/src/sac_format.cpp.o.d"
+  "libsac-format.a"
+  "libsac-format.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sac-format.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trace_tests.dir/src/tests/trace.cpp.o"
+  "CMakeFiles/trace_tests.dir/src/tests/trace.cpp.o.d"
+  "trace_tests"
+  "trace_tests.pdb"
+  "trace_tests_tests-b12d07c.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trace_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,128 @@
+# This file will be configured to contain variables for CPack. These variables
+# should be set in the CMake list file of the project before CPack module is
+# included. The list of available CPACK_xxx variables and their associated
+# documentation may be obtained using
+#  cpack --help-variable-list
+#
+# Some variables are common to all generators (e.g. CPACK_PACKAGE_NAME)
+# and some are specific to a generator
+# (e.g. CPACK_NSIS_EXTRA_INSTALL_COMMANDS). The generator specific variables
+# usually begin with CPACK_<GENNAME>_xxxx.
+
+
+set(CPACK_ARCHIVE_COMPONENT_INSTALL "ON")
+set(CPACK_ARCHIVE_FILE_NAME "sac-format-0.6.0-Linux-x86_64")
+set(CPACK_BINARY_DEB "OFF")
+set(CPACK_BINARY_FREEBSD "OFF")
+set(CPACK_BINARY_IFW "OFF")
+set(CPACK_BINARY_NSIS "OFF")
+set(CPACK_BINARY_RPM "OFF")
+set(CPACK_BINARY_STGZ "ON")
+set(CPACK_BINARY_TBZ2 "OFF")
+set(CPACK_BINARY_TGZ "ON")
+set(CPACK_BINARY_TXZ "OFF")
+set(CPACK_BINARY_TZ "ON")
+set(CPACK_BUILD_SOURCE_DIRS "/root/repo;/root/repo/_hard_build")
+set(CPACK_CMAKE_GENERATOR "Unix Makefiles")
+set(CPACK_COMPONENTS_GROUPING "ALL_COMPONENTS_IN_ONE")
+set(CPACK_COMPONENT_UNSPECIFIED_HIDDEN "TRUE")
+set(CPACK_COMPONENT_UNSPECIFIED_REQUIRED "TRUE")
+set(CPACK_COMPONENT_license_HIDDEN "TRUE")
+set(CPACK_COMPONENT_license_REQUIRED "TRUE")
+set(CPACK_DEBIAN_PACKAGE_DEPENDS "")
+set(CPACK_DEBIAN_PACKAGE_MAINTAINER "Alexander R. Blanchette <arbCoding@gmail.com>")
+set(CPACK_DEB_COMPONENT_INSTALL "ON")
+set(CPACK_DEFAULT_PACKAGE_DESCRIPTION_FILE "/usr/share/cmake-3.25/Templates/CPack.GenericDescription.txt")
+set(CPACK_DEFAULT_PACKAGE_DESCRIPTION_SUMMARY "sac-format built using CMake")
+set(CPACK_GENERATOR "STGZ;TGZ;TZ")
+set(CPACK_INSTALL_CMAKE_PROJECTS "/root/repo/_hard_build;sac-format;ALL;/")
+set(CPACK_INSTALL_PREFIX "/usr/local")
+set(CPACK_MODULE_PATH "/usr/lib/cmake/Catch2;/extras")
+set(CPACK_NSIS_DISPLAY_NAME "sac-format")
+set(CPACK_NSIS_ENABLE_UNINSTALL_BEFORE_INSTALL "ON")
+set(CPACK_NSIS_HELP_LINK "https://arbCoding.github.io/sac-format/")
+set(CPACK_NSIS_INSTALLER_ICON_CODE "")
+set(CPACK_NSIS_INSTALLER_MUI_ICON_CODE "")
+set(CPACK_NSIS_INSTALL_ROOT "$PROGRAMFILES")
+set(CPACK_NSIS_PACKAGE_NAME "sac-format")
+set(CPACK_NSIS_UNINSTALL_NAME "Uninstall")
+set(CPACK_OBJCOPY_EXECUTABLE "/usr/bin/objcopy")
+set(CPACK_OBJDUMP_EXECUTABLE "/usr/bin/objdump")
+set(CPACK_OUTPUT_CONFIG_FILE "/root/repo/_hard_build/CPackConfig.cmake")
+set(CPACK_PACKAGE_CHECKSUM "SHA512")
+set(CPACK_PACKAGE_DEFAULT_LOCATION "/")
+set(CPACK_PACKAGE_DESCRIPTION_FILE "/usr/share/cmake-3.25/Templates/CPack.GenericDescription.txt")
+set(CPACK_PACKAGE_DESCRIPTION_SUMMARY "C++20 Single-Header SAC File library")
+set(CPACK_PACKAGE_FILE_NAME "sac-format")
+set(CPACK_PACKAGE_HOMEPAGE_URL "https://arbCoding.github.io/sac-format/")
+set(CPACK_PACKAGE_INSTALL_DIRECTORY "sac-format")
+set(CPACK_PACKAGE_INSTALL_REGISTRY_KEY "sac-format")
+set(CPACK_PACKAGE_NAME "sac-format")
+set(CPACK_PACKAGE_RELOCATABLE "true")
+set(CPACK_PACKAGE_VENDER "https://arbCoding.github.io/sac-format/")
+set(CPACK_PACKAGE_VENDOR "Alexander R. Blanchette <arbCoding@gmail.com>")
+set(CPACK_PACKAGE_VERSION "0.6.0")
+set(CPACK_PACKAGE_VERSION_MAJOR "0")
+set(CPACK_PACKAGE_VERSION_MINOR "6")
+set(CPACK_PACKAGE_VERSION_PATCH "0")
+set(CPACK_READELF_EXECUTABLE "/usr/bin/readelf")
+set(CPACK_RESOURCE_FILE_LICENSE "/root/repo/LICENSE")
+set(CPACK_RESOURCE_FILE_README "/usr/share/cmake-3.25/Templates/CPack.GenericDescription.txt")
+set(CPACK_RESOURCE_FILE_WELCOME "/usr/share/cmake-3.25/Templates/CPack.GenericWelcome.txt")
+set(CPACK_RPM_COMPONENT_INSTALL "ON")
+set(CPACK_RPM_SPEC_MORE_DEFINE "%define __spec_install_post /bin/true")
+set(CPACK_SET_DESTDIR "OFF")
+set(CPACK_SOURCE_GENERATOR "TBZ2;TGZ;TXZ;TZ")
+set(CPACK_SOURCE_OUTPUT_CONFIG_FILE "/root/repo/_hard_build/CPackSourceConfig.cmake")
+set(CPACK_SOURCE_RPM "OFF")
+set(CPACK_SOURCE_TBZ2 "ON")
+set(CPACK_SOURCE_TGZ "ON")
+set(CPACK_SOURCE_TXZ "ON")
+set(CPACK_SOURCE_TZ "ON")
+set(CPACK_SOURCE_ZIP "OFF")
+set(CPACK_SYSTEM_NAME "Linux")
+set(CPACK_THREADS "1")
+set(CPACK_TOPLEVEL_TAG "Linux")
+set(CPACK_WIX_SIZEOF_VOID_P "8")
+
+if(NOT CPACK_PROPERTIES_FILE)
+  set(CPACK_PROPERTIES_FILE "/root/repo/_hard_build/CPackProperties.cmake")
+endif()
+
+if(EXISTS ${CPACK_PROPERTIES_FILE})
+  include(${CPACK_PROPERTIES_FILE})
+endif()
+
+# Configuration for component "library"
+
+SET(CPACK_COMPONENTS_ALL benchmarks library license list_sac tests)
+set(CPACK_COMPONENT_LIBRARY_DISPLAY_NAME "sac-format")
+set(CPACK_COMPONENT_LIBRARY_DESCRIPTION "sac-format library to use in your own programs.")
+set(CPACK_COMPONENT_LIBRARY_GROUP development)
+
+# Configuration for component "tests"
+
+SET(CPACK_COMPONENTS_ALL benchmarks library license list_sac tests)
+set(CPACK_COMPONENT_TESTS_DISPLAY_NAME "Unit/Integration Testing")
+set(CPACK_COMPONENT_TESTS_DESCRIPTION "Collection of command line unit and integration tests that ensure sac-format is working correctly.")
+set(CPACK_COMPONENT_TESTS_GROUP misc)
+
+# Configuration for component "benchmarks"
+
+SET(CPACK_COMPONENTS_ALL benchmarks library license list_sac tests)
+set(CPACK_COMPONENT_BENCHMARKS_DISPLAY_NAME "Benchmarks")
+set(CPACK_COMPONENT_BENCHMARKS_DESCRIPTION "benchmarks.exe - Collection of command line benchmarks for determining sac-format performance.")
+set(CPACK_COMPONENT_BENCHMARKS_GROUP misc)
+
+# Configuration for component "list_sac"
+
+SET(CPACK_COMPONENTS_ALL benchmarks library license list_sac tests)
+set(CPACK_COMPONENT_LIST_SAC_DISPLAY_NAME "list_sac")
+set(CPACK_COMPONENT_LIST_SAC_DESCRIPTION "list_sac.exe - Example command line program that lists all header information from an input SAC file.")
+set(CPACK_COMPONENT_LIST_SAC_GROUP programs)
+
+# Configuration for component "license"
+
+SET(CPACK_COMPONENTS_ALL benchmarks library license list_sac tests)
+set(CPACK_COMPONENT_LICENSE_DISPLAY_NAME "license")
+set(CPACK_COMPONENT_LICENSE_DESCRIPTION "sac-format license file.")
@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_hard_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_hard_build/basic_tests_include-b12d07c.cmake")
+include("/root/repo/_hard_build/trace_tests_include-b12d07c.cmake")
+include("/root/repo/_hard_build/geometry_tests_include-b12d07c.cmake")
+include("/root/repo/_hard_build/datetime_tests_include-b12d07c.cmake")
+include("/root/repo/_hard_build/processing_tests_include-b12d07c.cmake")
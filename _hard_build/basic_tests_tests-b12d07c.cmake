@@ -0,0 +1,57 @@
+add_test( [==[Binary Conversion: Booleans]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Booleans]==]  )
+set_tests_properties( [==[Binary Conversion: Booleans]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Integer: Zero]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Integer: Zero]==]  )
+set_tests_properties( [==[Binary Conversion: Integer: Zero]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Integer: Negative]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Integer: Negative]==]  )
+set_tests_properties( [==[Binary Conversion: Integer: Negative]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Integer: Positive]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Integer: Positive]==]  )
+set_tests_properties( [==[Binary Conversion: Integer: Positive]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Float: Zero]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Float: Zero]==]  )
+set_tests_properties( [==[Binary Conversion: Float: Zero]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Float: Negative]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Float: Negative]==]  )
+set_tests_properties( [==[Binary Conversion: Float: Negative]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Float: Positive]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Float: Positive]==]  )
+set_tests_properties( [==[Binary Conversion: Float: Positive]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Double: Zero]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Double: Zero]==]  )
+set_tests_properties( [==[Binary Conversion: Double: Zero]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Double: Negative]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Double: Negative]==]  )
+set_tests_properties( [==[Binary Conversion: Double: Negative]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Double: Positive]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Double: Positive]==]  )
+set_tests_properties( [==[Binary Conversion: Double: Positive]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Perfect]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Perfect]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Perfect]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Empty]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Empty]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Empty]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: One Word]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: One Word]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: One Word]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Half Word]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Half Word]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Half Word]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Overflow]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Overflow]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Overflow]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Multiple Spaces]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Multiple Spaces]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Multiple Spaces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Two Words: Leading/Trailing Spaces]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Two Words: Leading/Trailing Spaces]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Two Words: Leading/Trailing Spaces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Perfect]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Perfect]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Perfect]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Empty]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Empty]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Empty]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: One Word]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: One Word]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: One Word]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Half Word]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Half Word]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Half Word]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Three Words]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Three Words]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Three Words]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Three and a Half Words]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Three and a Half Words]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Three and a Half Words]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Overflow]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Overflow]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Overflow]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Multiple Spaces]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Multiple Spaces]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Multiple Spaces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Binary Conversion: Strings: Four Words: Leading/Trailing Spaces]==] /root/repo/_hard_build/basic_tests [==[Binary Conversion: Strings: Four Words: Leading/Trailing Spaces]==]  )
+set_tests_properties( [==[Binary Conversion: Strings: Four Words: Leading/Trailing Spaces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Fundamental Constants]==] /root/repo/_hard_build/basic_tests [==[Fundamental Constants]==]  )
+set_tests_properties( [==[Fundamental Constants]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Data Word calcualtion]==] /root/repo/_hard_build/basic_tests [==[Data Word calcualtion]==]  )
+set_tests_properties( [==[Data Word calcualtion]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+set( basic_tests_TESTS [==[Binary Conversion: Booleans]==] [==[Binary Conversion: Integer: Zero]==] [==[Binary Conversion: Integer: Negative]==] [==[Binary Conversion: Integer: Positive]==] [==[Binary Conversion: Float: Zero]==] [==[Binary Conversion: Float: Negative]==] [==[Binary Conversion: Float: Positive]==] [==[Binary Conversion: Double: Zero]==] [==[Binary Conversion: Double: Negative]==] [==[Binary Conversion: Double: Positive]==] [==[Binary Conversion: Strings: Two Words: Perfect]==] [==[Binary Conversion: Strings: Two Words: Empty]==] [==[Binary Conversion: Strings: Two Words: One Word]==] [==[Binary Conversion: Strings: Two Words: Half Word]==] [==[Binary Conversion: Strings: Two Words: Overflow]==] [==[Binary Conversion: Strings: Two Words: Multiple Spaces]==] [==[Binary Conversion: Strings: Two Words: Leading/Trailing Spaces]==] [==[Binary Conversion: Strings: Four Words: Perfect]==] [==[Binary Conversion: Strings: Four Words: Empty]==] [==[Binary Conversion: Strings: Four Words: One Word]==] [==[Binary Conversion: Strings: Four Words: Half Word]==] [==[Binary Conversion: Strings: Four Words: Three Words]==] [==[Binary Conversion: Strings: Four Words: Three and a Half Words]==] [==[Binary Conversion: Strings: Four Words: Overflow]==] [==[Binary Conversion: Strings: Four Words: Multiple Spaces]==] [==[Binary Conversion: Strings: Four Words: Leading/Trailing Spaces]==] [==[Fundamental Constants]==] [==[Data Word calcualtion]==])
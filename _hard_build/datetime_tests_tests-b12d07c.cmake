@@ -0,0 +1,7 @@
+add_test( [==[DateTime: Default Trace]==] /root/repo/_hard_build/datetime_tests [==[DateTime: Default Trace]==]  )
+set_tests_properties( [==[DateTime: Default Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[DateTime: Standard Fake Trace]==] /root/repo/_hard_build/datetime_tests [==[DateTime: Standard Fake Trace]==]  )
+set_tests_properties( [==[DateTime: Standard Fake Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[DateTime: Reference Epoch]==] /root/repo/_hard_build/datetime_tests [==[DateTime: Reference Epoch]==]  )
+set_tests_properties( [==[DateTime: Reference Epoch]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+set( datetime_tests_TESTS [==[DateTime: Default Trace]==] [==[DateTime: Standard Fake Trace]==] [==[DateTime: Reference Epoch]==])
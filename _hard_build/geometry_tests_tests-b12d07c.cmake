@@ -0,0 +1,63 @@
+add_test( [==[Geometric Operations: Coordinates: Degrees In]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Coordinates: Degrees In]==]  )
+set_tests_properties( [==[Geometric Operations: Coordinates: Degrees In]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Coordiantes: Radians In]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Coordiantes: Radians In]==]  )
+set_tests_properties( [==[Geometric Operations: Coordiantes: Radians In]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Coordinates: Setters]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Coordinates: Setters]==]  )
+set_tests_properties( [==[Geometric Operations: Coordinates: Setters]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Coordinates: Getters]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Coordinates: Getters]==]  )
+set_tests_properties( [==[Geometric Operations: Coordinates: Getters]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Points]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Points]==]  )
+set_tests_properties( [==[Geometric Operations: Points]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: No Adjustment]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 360 \[0\, 360\]: No Adjustment]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: No Adjustment]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Negatives]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 360 \[0\, 360\]: Negatives]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Negatives]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by One Loop]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 360 \[0\, 360\]: Adjust by One Loop]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by One Loop]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by Many Loops]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 360 \[0\, 360\]: Adjust by Many Loops]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by Many Loops]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: No Adjustment]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 180 \[-180\, 180\]: No Adjustment]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: No Adjustment]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Positives]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 180 \[-180\, 180\]: Adjustment Positives]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Positives]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Negatives]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 180 \[-180\, 180\]: Adjustment Negatives]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Negatives]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Multiple Loops]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 180 \[-180\, 180\]: Multiple Loops]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Multiple Loops]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: No Adjustment]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 90 \[-90\, 90\]: No Adjustment]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: No Adjustment]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Positives]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 90 \[-90\, 90\]: Adjustment Positives]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Positives]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Negatives]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Helper Functions: Limit 90 \[-90\, 90\]: Adjustment Negatives]==]  )
+set_tests_properties( [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Negatives]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 0]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0\, Long 0]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 90, Long 0]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 90\, Long 0]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 90, Long 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat -90, Long 0]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat -90\, Long 0]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat -90, Long 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 180]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0\, Long 180]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 180]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long -180]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0\, Long -180]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long -180]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole to South Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole to South Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole to South Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole to North Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole to North Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole to North Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: North Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: North Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: North Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: South Pole]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: South Pole]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: South Pole]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Along Equator]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Along Equator]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Along Equator]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Calc Distance/Azimuth: Taken From Real SAC File]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Calc Distance/Azimuth: Taken From Real SAC File]==]  )
+set_tests_properties( [==[Geometric Operations: Calc Distance/Azimuth: Taken From Real SAC File]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Trace Geometry: Default Trace]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Trace Geometry: Default Trace]==]  )
+set_tests_properties( [==[Geometric Operations: Trace Geometry: Default Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Geometric Operations: Trace Geometry: Standard Fake Trace]==] /root/repo/_hard_build/geometry_tests [==[Geometric Operations: Trace Geometry: Standard Fake Trace]==]  )
+set_tests_properties( [==[Geometric Operations: Trace Geometry: Standard Fake Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+set( geometry_tests_TESTS [==[Geometric Operations: Coordinates: Degrees In]==] [==[Geometric Operations: Coordiantes: Radians In]==] [==[Geometric Operations: Coordinates: Setters]==] [==[Geometric Operations: Coordinates: Getters]==] [==[Geometric Operations: Points]==] [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: No Adjustment]==] [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Negatives]==] [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by One Loop]==] [==[Geometric Operations: Helper Functions: Limit 360 [0, 360]: Adjust by Many Loops]==] [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: No Adjustment]==] [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Positives]==] [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Adjustment Negatives]==] [==[Geometric Operations: Helper Functions: Limit 180 [-180, 180]: Multiple Loops]==] [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: No Adjustment]==] [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Positives]==] [==[Geometric Operations: Helper Functions: Limit 90 [-90, 90]: Adjustment Negatives]==] [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 0]==] [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 90, Long 0]==] [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat -90, Long 0]==] [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long 180]==] [==[Geometric Operations: Calc Distance/Azimuth: Same: Lat 0, Long -180]==] [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: North Pole to South Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Equator vs. Pole: South Pole to North Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: North Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Over Pole: South Pole]==] [==[Geometric Operations: Calc Distance/Azimuth: Along Equator]==] [==[Geometric Operations: Calc Distance/Azimuth: Taken From Real SAC File]==] [==[Geometric Operations: Trace Geometry: Default Trace]==] [==[Geometric Operations: Trace Geometry: Standard Fake Trace]==])
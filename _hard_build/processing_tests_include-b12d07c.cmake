@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_hard_build/processing_tests_tests-b12d07c.cmake")
+  include("/root/repo/_hard_build/processing_tests_tests-b12d07c.cmake")
+else()
+  add_test(processing_tests_NOT_BUILT-b12d07c processing_tests_NOT_BUILT-b12d07c)
+endif()
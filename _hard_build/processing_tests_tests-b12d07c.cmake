@@ -0,0 +1,83 @@
+add_test( [==[Processing: Data Views]==] /root/repo/_hard_build/processing_tests [==[Processing: Data Views]==]  )
+set_tests_properties( [==[Processing: Data Views]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Fit Trend]==] /root/repo/_hard_build/processing_tests [==[Processing: Fit Trend]==]  )
+set_tests_properties( [==[Processing: Fit Trend]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Rmean]==] /root/repo/_hard_build/processing_tests [==[Processing: Rmean]==]  )
+set_tests_properties( [==[Processing: Rmean]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Rtrend]==] /root/repo/_hard_build/processing_tests [==[Processing: Rtrend]==]  )
+set_tests_properties( [==[Processing: Rtrend]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Taper]==] /root/repo/_hard_build/processing_tests [==[Processing: Taper]==]  )
+set_tests_properties( [==[Processing: Taper]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Preprocess]==] /root/repo/_hard_build/processing_tests [==[Processing: Preprocess]==]  )
+set_tests_properties( [==[Processing: Preprocess]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: FFT: Next Fast Size]==] /root/repo/_hard_build/processing_tests [==[Processing: FFT: Next Fast Size]==]  )
+set_tests_properties( [==[Processing: FFT: Next Fast Size]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: FFT: Complex]==] /root/repo/_hard_build/processing_tests [==[Processing: FFT: Complex]==]  )
+set_tests_properties( [==[Processing: FFT: Complex]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: FFT: Real]==] /root/repo/_hard_build/processing_tests [==[Processing: FFT: Real]==]  )
+set_tests_properties( [==[Processing: FFT: Real]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: FFT: Spectral Trace]==] /root/repo/_hard_build/processing_tests [==[Processing: FFT: Spectral Trace]==]  )
+set_tests_properties( [==[Processing: FFT: Spectral Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: FFT: Spectral Trace: Errors]==] /root/repo/_hard_build/processing_tests [==[Processing: FFT: Spectral Trace: Errors]==]  )
+set_tests_properties( [==[Processing: FFT: Spectral Trace: Errors]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Filter: Design]==] /root/repo/_hard_build/processing_tests [==[Processing: Filter: Design]==]  )
+set_tests_properties( [==[Processing: Filter: Design]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Filter: Apply]==] /root/repo/_hard_build/processing_tests [==[Processing: Filter: Apply]==]  )
+set_tests_properties( [==[Processing: Filter: Apply]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Filter: Traces]==] /root/repo/_hard_build/processing_tests [==[Processing: Filter: Traces]==]  )
+set_tests_properties( [==[Processing: Filter: Traces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Resample: Design]==] /root/repo/_hard_build/processing_tests [==[Processing: Resample: Design]==]  )
+set_tests_properties( [==[Processing: Resample: Design]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Resample: Apply]==] /root/repo/_hard_build/processing_tests [==[Processing: Resample: Apply]==]  )
+set_tests_properties( [==[Processing: Resample: Apply]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Resample: Trace]==] /root/repo/_hard_build/processing_tests [==[Processing: Resample: Trace]==]  )
+set_tests_properties( [==[Processing: Resample: Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: To Even: Interpolate]==] /root/repo/_hard_build/processing_tests [==[Processing: To Even: Interpolate]==]  )
+set_tests_properties( [==[Processing: To Even: Interpolate]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: To Even: Trace]==] /root/repo/_hard_build/processing_tests [==[Processing: To Even: Trace]==]  )
+set_tests_properties( [==[Processing: To Even: Trace]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Parallel For]==] /root/repo/_hard_build/processing_tests [==[Processing: Parallel For]==]  )
+set_tests_properties( [==[Processing: Parallel For]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Cross-Correlation]==] /root/repo/_hard_build/processing_tests [==[Processing: Cross-Correlation]==]  )
+set_tests_properties( [==[Processing: Cross-Correlation]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: STA/LTA]==] /root/repo/_hard_build/processing_tests [==[Processing: STA/LTA]==]  )
+set_tests_properties( [==[Processing: STA/LTA]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Trigger]==] /root/repo/_hard_build/processing_tests [==[Processing: Trigger]==]  )
+set_tests_properties( [==[Processing: Trigger]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Coincidence]==] /root/repo/_hard_build/processing_tests [==[Processing: Coincidence]==]  )
+set_tests_properties( [==[Processing: Coincidence]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Coincidence: Traces]==] /root/repo/_hard_build/processing_tests [==[Processing: Coincidence: Traces]==]  )
+set_tests_properties( [==[Processing: Coincidence: Traces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Analytic Signal]==] /root/repo/_hard_build/processing_tests [==[Processing: Analytic Signal]==]  )
+set_tests_properties( [==[Processing: Analytic Signal]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Analytic Signal: Traces]==] /root/repo/_hard_build/processing_tests [==[Processing: Analytic Signal: Traces]==]  )
+set_tests_properties( [==[Processing: Analytic Signal: Traces]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Pole-Zero Files]==] /root/repo/_hard_build/processing_tests [==[Processing: Pole-Zero Files]==]  )
+set_tests_properties( [==[Processing: Pole-Zero Files]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Instrument Response]==] /root/repo/_hard_build/processing_tests [==[Processing: Instrument Response]==]  )
+set_tests_properties( [==[Processing: Instrument Response]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Merge]==] /root/repo/_hard_build/processing_tests [==[Processing: Merge]==]  )
+set_tests_properties( [==[Processing: Merge]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Rotation]==] /root/repo/_hard_build/processing_tests [==[Processing: Rotation]==]  )
+set_tests_properties( [==[Processing: Rotation]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Integration and Differentiation]==] /root/repo/_hard_build/processing_tests [==[Processing: Integration and Differentiation]==]  )
+set_tests_properties( [==[Processing: Integration and Differentiation]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Spectrogram]==] /root/repo/_hard_build/processing_tests [==[Processing: Spectrogram]==]  )
+set_tests_properties( [==[Processing: Spectrogram]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Stacking]==] /root/repo/_hard_build/processing_tests [==[Processing: Stacking]==]  )
+set_tests_properties( [==[Processing: Stacking]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Array Processing]==] /root/repo/_hard_build/processing_tests [==[Processing: Array Processing]==]  )
+set_tests_properties( [==[Processing: Array Processing]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Amplitude Metrics]==] /root/repo/_hard_build/processing_tests [==[Processing: Amplitude Metrics]==]  )
+set_tests_properties( [==[Processing: Amplitude Metrics]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Level of Detail]==] /root/repo/_hard_build/processing_tests [==[Processing: Level of Detail]==]  )
+set_tests_properties( [==[Processing: Level of Detail]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Time Shifting]==] /root/repo/_hard_build/processing_tests [==[Processing: Time Shifting]==]  )
+set_tests_properties( [==[Processing: Time Shifting]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Noise Correlation]==] /root/repo/_hard_build/processing_tests [==[Processing: Noise Correlation]==]  )
+set_tests_properties( [==[Processing: Noise Correlation]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Welch PSD and PPSD]==] /root/repo/_hard_build/processing_tests [==[Processing: Welch PSD and PPSD]==]  )
+set_tests_properties( [==[Processing: Welch PSD and PPSD]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Processing: Phase Picking]==] /root/repo/_hard_build/processing_tests [==[Processing: Phase Picking]==]  )
+set_tests_properties( [==[Processing: Phase Picking]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+set( processing_tests_TESTS [==[Processing: Data Views]==] [==[Processing: Fit Trend]==] [==[Processing: Rmean]==] [==[Processing: Rtrend]==] [==[Processing: Taper]==] [==[Processing: Preprocess]==] [==[Processing: FFT: Next Fast Size]==] [==[Processing: FFT: Complex]==] [==[Processing: FFT: Real]==] [==[Processing: FFT: Spectral Trace]==] [==[Processing: FFT: Spectral Trace: Errors]==] [==[Processing: Filter: Design]==] [==[Processing: Filter: Apply]==] [==[Processing: Filter: Traces]==] [==[Processing: Resample: Design]==] [==[Processing: Resample: Apply]==] [==[Processing: Resample: Trace]==] [==[Processing: To Even: Interpolate]==] [==[Processing: To Even: Trace]==] [==[Processing: Parallel For]==] [==[Processing: Cross-Correlation]==] [==[Processing: STA/LTA]==] [==[Processing: Trigger]==] [==[Processing: Coincidence]==] [==[Processing: Coincidence: Traces]==] [==[Processing: Analytic Signal]==] [==[Processing: Analytic Signal: Traces]==] [==[Processing: Pole-Zero Files]==] [==[Processing: Instrument Response]==] [==[Processing: Merge]==] [==[Processing: Rotation]==] [==[Processing: Integration and Differentiation]==] [==[Processing: Spectrogram]==] [==[Processing: Stacking]==] [==[Processing: Array Processing]==] [==[Processing: Amplitude Metrics]==] [==[Processing: Level of Detail]==] [==[Processing: Time Shifting]==] [==[Processing: Noise Correlation]==] [==[Processing: Welch PSD and PPSD]==] [==[Processing: Phase Picking]==])
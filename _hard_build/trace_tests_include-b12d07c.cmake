@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_hard_build/trace_tests_tests-b12d07c.cmake")
+  include("/root/repo/_hard_build/trace_tests_tests-b12d07c.cmake")
+else()
+  add_test(trace_tests_NOT_BUILT-b12d07c trace_tests_NOT_BUILT-b12d07c)
+endif()
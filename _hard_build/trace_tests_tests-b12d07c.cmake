@@ -0,0 +1,239 @@
+add_test( [==[Trace: Default: Floats]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Floats]==]  )
+set_tests_properties( [==[Trace: Default: Floats]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Default: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Doubles]==]  )
+set_tests_properties( [==[Trace: Default: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Default: Ints]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Ints]==]  )
+set_tests_properties( [==[Trace: Default: Ints]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Default: Bools]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Bools]==]  )
+set_tests_properties( [==[Trace: Default: Bools]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Default: Strings]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Strings]==]  )
+set_tests_properties( [==[Trace: Default: Strings]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Default: Data]==] /root/repo/_hard_build/trace_tests [==[Trace: Default: Data]==]  )
+set_tests_properties( [==[Trace: Default: Data]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: Floats]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: Floats]==]  )
+set_tests_properties( [==[Trace: Setters: Floats]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: Doubles]==]  )
+set_tests_properties( [==[Trace: Setters: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: Ints]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: Ints]==]  )
+set_tests_properties( [==[Trace: Setters: Ints]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: Bools]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: Bools]==]  )
+set_tests_properties( [==[Trace: Setters: Bools]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: String]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: String]==]  )
+set_tests_properties( [==[Trace: Setters: String]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Setters: Data]==] /root/repo/_hard_build/trace_tests [==[Trace: Setters: Data]==]  )
+set_tests_properties( [==[Trace: Setters: Data]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Convenience Functions]==] /root/repo/_hard_build/trace_tests [==[Trace: Convenience Functions]==]  )
+set_tests_properties( [==[Trace: Convenience Functions]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: Default]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: Default]==]  )
+set_tests_properties( [==[Trace: Equality: Default]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: Inequality]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: Inequality]==]  )
+set_tests_properties( [==[Trace: Equality: Inequality]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: Inequality: Data2]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: Inequality: Data2]==]  )
+set_tests_properties( [==[Trace: Equality: Inequality: Data2]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: ULP Distance]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: ULP Distance]==]  )
+set_tests_properties( [==[Trace: Equality: ULP Distance]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: First Mismatch]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: First Mismatch]==]  )
+set_tests_properties( [==[Trace: Equality: First Mismatch]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Equality: Compare]==] /root/repo/_hard_build/trace_tests [==[Trace: Equality: Compare]==]  )
+set_tests_properties( [==[Trace: Equality: Compare]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Float]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Float]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Float]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Doubles]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Integers]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Integers]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Integers]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Booleans]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Booleans]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Booleans]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Strings]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Strings]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Strings]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Data Vectors]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Data Vectors]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Data Vectors]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Default Construction: Everything]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Default Construction: Everything]==]  )
+set_tests_properties( [==[Trace: I/O: Default Construction: Everything]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Floats]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Floats]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Floats]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Doubles]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Integers]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Integers]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Integers]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Booleans]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Booleans]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Booleans]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Strings]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Strings]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Strings]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Data Vectors]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Data Vectors]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Data Vectors]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Everything]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Everything]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Everything]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Resize Data]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Resize Data]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Resize Data]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Modify Header: EvDp]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Modify Header: EvDp]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Modify Header: EvDp]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Random Data Vectors: Modify Data]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Random Data Vectors: Modify Data]==]  )
+set_tests_properties( [==[Trace: I/O: Random Data Vectors: Modify Data]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Fingerprint: CRC-32C]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Fingerprint: CRC-32C]==]  )
+set_tests_properties( [==[Trace: I/O: Fingerprint: CRC-32C]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Fingerprint: Read/Write]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Fingerprint: Read/Write]==]  )
+set_tests_properties( [==[Trace: I/O: Fingerprint: Read/Write]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Stats: Update]==] /root/repo/_hard_build/trace_tests [==[Trace: Stats: Update]==]  )
+set_tests_properties( [==[Trace: Stats: Update]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Stats On Write]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Stats On Write]==]  )
+set_tests_properties( [==[Trace: I/O: Stats On Write]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: nVHdr Conversions]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: nVHdr Conversions]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: nVHdr Conversions]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Floats]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Floats]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Floats]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Doubles]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Integers]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Integers]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Integers]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Booleans]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Booleans]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Booleans]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Strings]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Strings]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Strings]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Data]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Data]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Data]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Format: Everything]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Format: Everything]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Format: Everything]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: lEven]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: lEven]==]  )
+set_tests_properties( [==[Trace: Linked Headers: lEven]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: iFType]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: iFType]==]  )
+set_tests_properties( [==[Trace: Linked Headers: iFType]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: nPts: No Data2]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: nPts: No Data2]==]  )
+set_tests_properties( [==[Trace: Linked Headers: nPts: No Data2]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: nPts: Data2: Uneven Timeseries]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: nPts: Data2: Uneven Timeseries]==]  )
+set_tests_properties( [==[Trace: Linked Headers: nPts: Data2: Uneven Timeseries]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: nPts: Data2: Even Spectral]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: nPts: Data2: Even Spectral]==]  )
+set_tests_properties( [==[Trace: Linked Headers: nPts: Data2: Even Spectral]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data1: Even Timeseries]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data1: Even Timeseries]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data1: Even Timeseries]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data1: Uneven Timeseries]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data1: Uneven Timeseries]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data1: Uneven Timeseries]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data1: Spectral]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data1: Spectral]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data1: Spectral]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data2: Even Timeseries]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data2: Even Timeseries]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data2: Even Timeseries]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data2: Uneven Timeseries]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data2: Uneven Timeseries]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data2: Uneven Timeseries]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Linked Headers: Data2: Spectral]==] /root/repo/_hard_build/trace_tests [==[Trace: Linked Headers: Data2: Spectral]==]  )
+set_tests_properties( [==[Trace: Linked Headers: Data2: Spectral]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Floats]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Floats]==]  )
+set_tests_properties( [==[Trace: Unsetting: Floats]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Doubles]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Doubles]==]  )
+set_tests_properties( [==[Trace: Unsetting: Doubles]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Integers]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Integers]==]  )
+set_tests_properties( [==[Trace: Unsetting: Integers]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Booleans]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Booleans]==]  )
+set_tests_properties( [==[Trace: Unsetting: Booleans]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Strings]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Strings]==]  )
+set_tests_properties( [==[Trace: Unsetting: Strings]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Data Vectors]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Data Vectors]==]  )
+set_tests_properties( [==[Trace: Unsetting: Data Vectors]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: Convenience Functions]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: Convenience Functions]==]  )
+set_tests_properties( [==[Trace: Unsetting: Convenience Functions]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: Unsetting: I/O]==] /root/repo/_hard_build/trace_tests [==[Trace: Unsetting: I/O]==]  )
+set_tests_properties( [==[Trace: Unsetting: I/O]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Legacy Write]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Legacy Write]==]  )
+set_tests_properties( [==[Trace: I/O: Legacy Write]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Execptions: Bad Read Path]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Execptions: Bad Read Path]==]  )
+set_tests_properties( [==[Trace: I/O: Execptions: Bad Read Path]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Execptions: Bad Write Path]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Execptions: Bad Write Path]==]  )
+set_tests_properties( [==[Trace: I/O: Execptions: Bad Write Path]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 10 Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: 10 Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 10 Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 0 Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: 0 Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 0 Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 75 Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: 75 Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 75 Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 76 Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: 76 Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: 76 Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word - 1 Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word - 1 Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word - 1 Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word Header Fields]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word Header Fields]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word Header Fields]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1000, Real_nPts 999]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1000\, Real_nPts 999]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1000, Real_nPts 999]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 10]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10\, Real_nPts 10]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 10]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 0, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 0\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 0, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1000, Real_nPts 999]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1000\, Real_nPts 999]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1000, Real_nPts 999]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 10]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10\, Real_nPts 10]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 10]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 0, Real_nPts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 0\, Real_nPts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 0, Real_nPts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0\, Footer 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10\, Footer 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 10]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0\, Footer 10]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 10]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 10]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10\, Footer 10]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 10]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer num_footer - 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10\, Footer num_footer - 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer num_footer - 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer - 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000\, Footer num_footer - 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer - 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer num_footer]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0\, Footer num_footer]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer num_footer]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000\, Footer num_footer]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0\, Footer 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10\, Footer 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 10]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10\, Footer 10]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 10]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer num_footer -1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10\, Footer num_footer -1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer num_footer -1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1000, Footer num_footer - 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1000\, Footer num_footer - 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1000, Footer num_footer - 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1, Footer num_footer]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1\, Footer num_footer]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1, Footer num_footer]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer num_footer]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0\, Footer num_footer]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer num_footer]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 100, Footer num_footers]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 100\, Footer num_footers]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 100, Footer num_footers]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 10, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 10\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 10, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 100, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 100\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 100, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 100]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0\, Excess Npts 100]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 100]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 57, Excess Npts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 57\, Excess Npts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 57, Excess Npts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 0, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 0\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 0, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 1000, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 1000\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 1000, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100\, Excess Npts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 0, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 0\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 0, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 101]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100\, Excess Npts 101]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 101]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 10, Excess Npts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 10\, Excess Npts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 10, Excess Npts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 0, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 0\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 0, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 1]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100\, Excess Npts 1]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 1]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 100]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100\, Excess Npts 100]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 100]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+add_test( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 0]==] /root/repo/_hard_build/trace_tests [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100\, Excess Npts 0]==]  )
+set_tests_properties( [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 0]==] PROPERTIES WORKING_DIRECTORY /root/repo/_hard_build)
+set( trace_tests_TESTS [==[Trace: Default: Floats]==] [==[Trace: Default: Doubles]==] [==[Trace: Default: Ints]==] [==[Trace: Default: Bools]==] [==[Trace: Default: Strings]==] [==[Trace: Default: Data]==] [==[Trace: Setters: Floats]==] [==[Trace: Setters: Doubles]==] [==[Trace: Setters: Ints]==] [==[Trace: Setters: Bools]==] [==[Trace: Setters: String]==] [==[Trace: Setters: Data]==] [==[Trace: Convenience Functions]==] [==[Trace: Equality: Default]==] [==[Trace: Equality: Inequality]==] [==[Trace: Equality: Inequality: Data2]==] [==[Trace: Equality: ULP Distance]==] [==[Trace: Equality: First Mismatch]==] [==[Trace: Equality: Compare]==] [==[Trace: I/O: Default Construction: Float]==] [==[Trace: I/O: Default Construction: Doubles]==] [==[Trace: I/O: Default Construction: Integers]==] [==[Trace: I/O: Default Construction: Booleans]==] [==[Trace: I/O: Default Construction: Strings]==] [==[Trace: I/O: Default Construction: Data Vectors]==] [==[Trace: I/O: Default Construction: Everything]==] [==[Trace: I/O: Random Data Vectors: Floats]==] [==[Trace: I/O: Random Data Vectors: Doubles]==] [==[Trace: I/O: Random Data Vectors: Integers]==] [==[Trace: I/O: Random Data Vectors: Booleans]==] [==[Trace: I/O: Random Data Vectors: Strings]==] [==[Trace: I/O: Random Data Vectors: Data Vectors]==] [==[Trace: I/O: Random Data Vectors: Everything]==] [==[Trace: I/O: Random Data Vectors: Resize Data]==] [==[Trace: I/O: Random Data Vectors: Modify Header: EvDp]==] [==[Trace: I/O: Random Data Vectors: Modify Data]==] [==[Trace: I/O: Fingerprint: CRC-32C]==] [==[Trace: I/O: Fingerprint: Read/Write]==] [==[Trace: Stats: Update]==] [==[Trace: I/O: Stats On Write]==] [==[Trace: I/O: Legacy Format: nVHdr Conversions]==] [==[Trace: I/O: Legacy Format: Floats]==] [==[Trace: I/O: Legacy Format: Doubles]==] [==[Trace: I/O: Legacy Format: Integers]==] [==[Trace: I/O: Legacy Format: Booleans]==] [==[Trace: I/O: Legacy Format: Strings]==] [==[Trace: I/O: Legacy Format: Data]==] [==[Trace: I/O: Legacy Format: Everything]==] [==[Trace: Linked Headers: lEven]==] [==[Trace: Linked Headers: iFType]==] [==[Trace: Linked Headers: nPts: No Data2]==] [==[Trace: Linked Headers: nPts: Data2: Uneven Timeseries]==] [==[Trace: Linked Headers: nPts: Data2: Even Spectral]==] [==[Trace: Linked Headers: Data1: Even Timeseries]==] [==[Trace: Linked Headers: Data1: Uneven Timeseries]==] [==[Trace: Linked Headers: Data1: Spectral]==] [==[Trace: Linked Headers: Data2: Even Timeseries]==] [==[Trace: Linked Headers: Data2: Uneven Timeseries]==] [==[Trace: Linked Headers: Data2: Spectral]==] [==[Trace: Unsetting: Floats]==] [==[Trace: Unsetting: Doubles]==] [==[Trace: Unsetting: Integers]==] [==[Trace: Unsetting: Booleans]==] [==[Trace: Unsetting: Strings]==] [==[Trace: Unsetting: Data Vectors]==] [==[Trace: Unsetting: Convenience Functions]==] [==[Trace: Unsetting: I/O]==] [==[Trace: I/O: Legacy Write]==] [==[Trace: I/O: Execptions: Bad Read Path]==] [==[Trace: I/O: Execptions: Bad Write Path]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: 10 Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: 0 Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: 75 Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: 76 Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word - 1 Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Header Throw: data_word Header Fields]==] [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 1000, Real_nPts 999]==] [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 10, Real_nPts 10]==] [==[Trace: I/O: Corrupt SAC-File: Data1 Throw: Fake_nPts 0, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 1000, Real_nPts 999]==] [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 10, Real_nPts 10]==] [==[Trace: I/O: Corrupt SAC-File: Data2 Throw: Fake_nPts 0, Real_nPts 0]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 0]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 0]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer 10]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer 10]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 10, Footer num_footer - 1]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer - 1]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 0, Footer num_footer]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: Without Data2: Npts 1000, Footer num_footer]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer 0]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 0]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer 10]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 10, Footer num_footer -1]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1000, Footer num_footer - 1]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 1, Footer num_footer]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 0, Footer num_footer]==] [==[Trace: I/O: Corrupt SAC-File: Footer Throw: With Data2: Npts 100, Footer num_footers]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 10, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 100, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 0, Excess Npts 100]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: Without Footer: Npts 57, Excess Npts 0]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 0, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 1000, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: Without Footer: Npts 100, Excess Npts 0]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 0, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 100, Excess Npts 101]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: Without Data2: With Footer: Npts 10, Excess Npts 0]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 0, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 1]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 100]==] [==[Trace: I/O: Corrupt SAC-File: Excess Data Throw: With Data2: With Footer: Npts 100, Excess Npts 0]==])
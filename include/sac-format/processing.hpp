@@ -0,0 +1,1355 @@
+// Copyright 2023-2024 Alexander R. Blanchette
+
+/*!
+  \file processing.hpp
+
+  \brief Interface of the sac-format signal-processing functions.
+
+  \author Alexander R. Blanchette
+
+  This file is the interface for the signal-processing functions that operate
+  on Trace data in place. Everything in this file is targeted for testing
+  coverage.
+  */
+
+#ifndef SAC_FORMAT_PROCESSING_HPP_20240601_0900
+#define SAC_FORMAT_PROCESSING_HPP_20240601_0900
+#pragma once
+// sac-format
+#include "sac-format/sac_format.hpp"
+// Standard Library
+//   https://en.cppreference.com/w/cpp/standard_library
+// std::array
+#include <array>
+// std::atomic
+#include <atomic>
+// std::toupper
+#include <cctype>
+// std::complex
+#include <complex>
+// std::exception_ptr, std::rethrow_exception
+#include <exception>
+// std::filesystem::path
+#include <filesystem>
+// std::deque
+#include <deque>
+// std::function, std::greater_equal
+#include <functional>
+// std::map
+#include <map>
+// std::shared_ptr
+#include <memory>
+// std::mutex, std::scoped_lock
+#include <mutex>
+// std::istream
+#include <istream>
+// std::gcd
+#include <numeric>
+// std::ostream
+#include <ostream>
+// std::span
+#include <span>
+// std::string
+#include <string>
+// std::thread
+#include <thread>
+// std::tuple
+#include <tuple>
+// std::unordered_map
+#include <unordered_map>
+// std::pair
+#include <utility>
+// std::vector
+#include <vector>
+
+//! sac-format namespace
+namespace sacfmt {
+//--------------------------------------------------------------------------
+// Constants
+//--------------------------------------------------------------------------
+//! Default taper width (fraction of the data length at each end).
+constexpr double default_taper_width{0.05};
+//! Maximum taper width (fraction of the data length at each end).
+constexpr double max_taper_width{0.5};
+//! Largest prime factor transformed by a direct butterfly (else Bluestein).
+constexpr size_t max_direct_radix{32};
+//! Maximum Butterworth filter order.
+constexpr int max_filter_order{16};
+//! Number of traces filtered together (interleaved) by batched filtering.
+constexpr size_t filter_lanes{4};
+//! Number of samples per filtering block (kept in cache between sections).
+constexpr size_t filter_block{1024};
+//! Number of partial sums in a dot product (breaks the addition chain).
+constexpr size_t dot_lanes{4};
+//! Resampling filter half-width (zero crossings of the sinc on each side).
+constexpr size_t resample_half_width{16};
+//! Kaiser window shape parameter for resampling filters (~80 dB stopband).
+constexpr double resample_kaiser_beta{8.0};
+//! Maximum (reduced) interpolation or decimation factor for resampling.
+constexpr size_t max_resample_factor{1000};
+//! Minimum cross-correlation (overlap-save) transform size.
+constexpr size_t xcorr_min_fft{4096};
+//! Overlap-save blocks per cross-correlation work item (parallel split).
+constexpr size_t xcorr_chunk_blocks{16};
+//! Number of pick headers (t0..t9 and kt0..kt9).
+constexpr size_t max_picks{10};
+//! Default response water level (dB below the peak of the response).
+constexpr double default_water_level{60.0};
+//! Maximum number of FFT plans (per plan type) kept in the cache.
+constexpr size_t max_cached_plans{64};
+//! Maximum number of resampling filters kept in the cache.
+constexpr size_t max_cached_resamplers{64};
+//! Maximum number of filter designs kept in the cache.
+constexpr size_t max_cached_filters{64};
+//! Maximum number of evaluated instrument responses kept in the cache.
+constexpr size_t max_cached_responses{64};
+//! Relative difference of sampling intervals accepted when merging.
+constexpr double merge_delta_tolerance{1e-6};
+//! Start time difference accepted for aligned components (fraction of delta).
+constexpr double alignment_tolerance{0.01};
+//! Inclination difference from horizontal accepted for horizontal components.
+constexpr double horizontal_tolerance{0.1};
+/*! \enum interpolation
+  \brief Interpolation methods (for unevenly-sampled data).
+ */
+enum class interpolation {
+  //! Straight lines between samples.
+  linear,
+  //! Akima cubic (piecewise cubic, no overshoot near outliers).
+  akima
+};
+/*! \enum sta_lta_method
+  \brief STA/LTA averaging methods.
+ */
+enum class sta_lta_method {
+  //! Moving averages of the energy over the short and long windows.
+  classic,
+  //! Exponential averages of the energy (time constants of the windows).
+  recursive
+};
+/*! \enum signal_attribute
+  \brief Instantaneous attributes of the analytic signal.
+ */
+enum class signal_attribute {
+  //! Amplitude (magnitude of the analytic signal).
+  envelope,
+  //! Phase (radians, -pi to pi).
+  phase,
+  //! Frequency (Hz; rate of change of the phase).
+  frequency
+};
+/*! \enum overlap_policy
+  \brief Handling of overlapping samples when merging.
+ */
+enum class overlap_policy {
+  //! Keep the samples of the piece that starts first.
+  keep_first,
+  //! Keep the samples of the piece that starts last.
+  keep_last,
+  //! Average the overlapping samples.
+  average
+};
+/*! \enum gap_policy
+  \brief Handling of gaps when merging.
+ */
+enum class gap_policy {
+  //! Fill with zeros.
+  zero,
+  //! Fill with a straight line between the samples around the gap.
+  interpolate,
+  //! Fill with NaN.
+  nan,
+  //! Start a new Trace after the gap.
+  split
+};
+/*! \enum integration_method
+  \brief Time-domain integration methods.
+ */
+enum class integration_method {
+  //! Trapezoidal rule (npts - 1 values, at the midpoints of the samples).
+  trapezoid,
+  //! Rectangle rule (npts values, at the samples).
+  rectangle
+};
+/*! \enum difference_method
+  \brief Time-domain differentiation methods.
+ */
+enum class difference_method {
+  //! Three-point central difference (npts - 2 values).
+  central,
+  //! Five-point central difference (npts - 4 values).
+  five_point
+};
+/*! \enum time_marker
+  \brief Time markers (alignment references).
+ */
+enum class time_marker { b, o, a, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9 };
+/*! \enum stack_method
+  \brief Stacking methods.
+ */
+enum class stack_method {
+  //! Mean of the inputs.
+  linear,
+  //! nth power of the mean of the nth roots (keeping signs).
+  nth_root,
+  //! Linear stack weighted by the coherence of the instantaneous phases.
+  phase_weighted
+};
+/*! \enum shift_method
+  \brief Fractional-sample shift methods.
+ */
+enum class shift_method {
+  //! Kaiser-windowed sinc interpolation (::resample_half_width per side).
+  sinc,
+  //! Linear phase ramp in the frequency domain (zero-padded).
+  fft
+};
+/*! \enum temporal_normalization
+  \brief Temporal normalization of ambient noise (suppresses earthquakes).
+ */
+enum class temporal_normalization {
+  //! No normalization.
+  none,
+  //! Keep only the sign of each sample.
+  one_bit,
+  //! Divide by the running absolute mean.
+  running_mean
+};
+/*! \enum picker_method
+  \brief Automatic phase picking methods.
+ */
+enum class picker_method {
+  //! Minimum of the Akaike information criterion (Maeda).
+  aic,
+  //! Steepest rise of the sliding kurtosis.
+  kurtosis,
+  //! First STA/LTA crossing, refined by the AIC minimum.
+  sta_lta
+};
+/*! \enum taper_window
+  \brief Taper window shapes (SAC taper types).
+ */
+enum class taper_window {
+  //! \f$0.5 - 0.5\cos(\pi j/N)\f$
+  hann,
+  //! \f$0.54 - 0.46\cos(\pi j/N)\f$
+  hamming,
+  //! \f$\sin(\pi j/(2N))\f$
+  cosine
+};
+/*! \struct linear_fit
+  \brief Least-squares line \f$y = a + b(x - c)\f$.
+
+  For evenly-spaced data \f$x\f$ is the sample index.
+ */
+struct linear_fit {
+  double intercept{0.0};  //!< Value at the center (\f$a\f$).
+  double slope{0.0};      //!< Slope (\f$b\f$).
+  double center{0.0};     //!< Center of the independent variable (\f$c\f$).
+};
+//--------------------------------------------------------------------------
+// Kernels
+//--------------------------------------------------------------------------
+// Least-squares line through evenly-spaced data (single pass).
+linear_fit fit_trend(std::span<const double> data) noexcept;
+// Least-squares line through data with independent variable x.
+linear_fit fit_trend(std::span<const double> data,
+                     std::span<const double> x) noexcept;
+// Number of samples tapered at each end.
+size_t taper_length(size_t size, double width) noexcept;
+// Subtract a line and taper the ends in a single pass.
+void remove_fit(std::span<double> data, const linear_fit &fit,
+                std::span<const double> x = {}, size_t n_taper = 0,
+                taper_window window = taper_window::hann) noexcept;
+// Dot product (equal sizes).
+double dot_product(std::span<const double> lhs,
+                   std::span<const double> rhs) noexcept;
+// Require an evenly-sampled time-series Trace with a positive delta.
+void check_time_series(const Trace &trace);
+// Run task(0) ... task(count - 1) on a pool of threads.
+void parallel_for(size_t count, const std::function<void(size_t)> &task,
+                  size_t threads = 0);
+//--------------------------------------------------------------------------
+// Preprocessing
+//--------------------------------------------------------------------------
+// Remove the mean.
+void rmean(std::span<double> data) noexcept;
+void rmean(Trace *trace) noexcept;
+// Remove the least-squares linear trend (evenly-spaced).
+void rtrend(std::span<double> data) noexcept;
+// Remove the least-squares linear trend (arbitrary independent variable).
+void rtrend(std::span<double> data, std::span<const double> x) noexcept;
+void rtrend(Trace *trace) noexcept;
+// Taper both ends.
+void taper(std::span<double> data, double width = default_taper_width,
+           taper_window window = taper_window::hann) noexcept;
+void taper(Trace *trace, double width = default_taper_width,
+           taper_window window = taper_window::hann) noexcept;
+// Fused rmean, rtrend, and taper.
+void preprocess(std::span<double> data, double width = default_taper_width,
+                taper_window window = taper_window::hann) noexcept;
+void preprocess(Trace *trace, double width = default_taper_width,
+                taper_window window = taper_window::hann) noexcept;
+//--------------------------------------------------------------------------
+// Fourier Transform
+//--------------------------------------------------------------------------
+//! Complex value type used by the Fourier transforms.
+using complex = std::complex<double>;
+// Complex multiplication (no special handling of infinities/NaN).
+complex complex_multiply(complex val1, complex val2) noexcept;
+// Smallest size >= input with no prime factors other than 2, 3, and 5.
+size_t next_fast_size(size_t size) noexcept;
+/*! \class fft_plan
+  \brief Mixed-radix complex FFT of a fixed size.
+
+  Sizes are factored into radix-4, 2, 3, and 5 butterflies (other prime
+  factors up to ::max_direct_radix use a generic DFT butterfly). The transform
+  is a Stockham autosort (no bit-reversal); twiddle factors are precomputed per
+  stage. Sizes with a larger prime factor use Bluestein's algorithm (chirp
+  convolution through a fast-size transform). Plans are immutable and
+  thread-safe; use fft_plan::get to share them through the plan cache (bounded
+  by ::max_cached_plans).
+ */
+class fft_plan {
+public:
+  explicit fft_plan(size_t size);
+  [[nodiscard]] size_t size() const noexcept;
+  // Forward transform (in place, unscaled).
+  void forward(std::span<complex> data) const;
+  // Inverse transform (in place, scaled by 1/size).
+  void inverse(std::span<complex> data) const;
+  // Cached plan for size.
+  static std::shared_ptr<const fft_plan> get(size_t size);
+
+private:
+  /*! \struct stage
+    \brief One radix pass of the transform.
+   */
+  struct stage {
+    size_t radix{};                  //!< Butterfly radix.
+    size_t length{};                 //!< Sub-transform length at this pass.
+    std::vector<complex> twiddles{};  //!< Per-butterfly twiddle factors.
+    std::vector<complex> roots{};    //!< Radix roots (generic radix only).
+  };
+  size_t n{};                  //!< Transform size.
+  std::vector<stage> stages{};  //!< Radix passes.
+  //! Fast-size transform for Bluestein's algorithm (empty if not used).
+  std::shared_ptr<const fft_plan> convolution{};
+  std::vector<complex> chirp{};           //!< Bluestein chirp.
+  std::vector<complex> chirp_spectrum{};  //!< Transform of the chirp filter.
+  void pass(const stage &current, size_t stride, const complex *input,
+            complex *output) const;
+  void bluestein(std::span<complex> data) const;
+  //! Cache of plans by size.
+  static std::unordered_map<size_t, std::shared_ptr<const fft_plan>> cache;
+  //! Cache keys in insertion order (oldest evicted first).
+  static std::deque<size_t> cache_order;
+  //! Cache lock.
+  static std::mutex cache_mutex;
+};
+/*! \class rfft_plan
+  \brief Real-input FFT of a fixed size.
+
+  Even sizes pack the real data into a half-size complex transform; odd sizes
+  use a full-size complex transform. Only the non-negative frequencies
+  (size/2 + 1 bins) are produced/consumed. Use rfft_plan::get to share plans
+  through the plan cache (bounded by ::max_cached_plans).
+ */
+class rfft_plan {
+public:
+  explicit rfft_plan(size_t size);
+  [[nodiscard]] size_t size() const noexcept;
+  [[nodiscard]] size_t bins() const noexcept;
+  // Forward transform (input zero-padded to size, unscaled).
+  void forward(std::span<const double> input, std::span<complex> output) const;
+  // Inverse transform (Hermitian input, scaled by 1/size).
+  void inverse(std::span<const complex> input, std::span<double> output) const;
+  // Cached plan for size.
+  static std::shared_ptr<const rfft_plan> get(size_t size);
+
+private:
+  size_t n{};                                  //!< Transform size.
+  std::shared_ptr<const fft_plan> complex_plan{};  //!< Underlying transform.
+  std::vector<complex> twiddles{};  //!< Packing twiddles (even sizes).
+  //! Cache of plans by size.
+  static std::unordered_map<size_t, std::shared_ptr<const rfft_plan>> cache;
+  //! Cache keys in insertion order (oldest evicted first).
+  static std::deque<size_t> cache_order;
+  //! Cache lock.
+  static std::mutex cache_mutex;
+};
+// Real-to-complex FFT (non-negative frequencies).
+std::vector<complex> rfft(std::span<const double> data, size_t n_fft = 0);
+// Complex-to-real inverse FFT.
+std::vector<double> irfft(std::span<const complex> spectrum, size_t n_fft);
+// Convert a time-series Trace to a spectral Trace.
+void to_spectral(Trace *trace, int type = irlim);
+// Convert a spectral Trace to a time-series Trace.
+void to_time(Trace *trace);
+// Analytic signal (data + i * Hilbert transform of data).
+void analytic_signal(std::span<const double> data, std::span<complex> output);
+// Instantaneous attribute of data (output may be data).
+void instantaneous(std::span<const double> data, std::span<double> output,
+                   signal_attribute attribute, double delta = 1.0);
+// Replace a Trace's data with an instantaneous attribute.
+void instantaneous(Trace *trace, signal_attribute attribute);
+// Replace many Traces' data with an instantaneous attribute (in parallel).
+void instantaneous(std::span<Trace> traces, signal_attribute attribute,
+                   size_t threads = 0);
+// Replace a Trace's data with its envelope.
+void envelope(Trace *trace);
+// Replace many Traces' data with their envelopes (in parallel).
+void envelope(std::span<Trace> traces, size_t threads = 0);
+//--------------------------------------------------------------------------
+// Filtering
+//--------------------------------------------------------------------------
+/*! \enum filter_type
+  \brief Butterworth filter types.
+ */
+enum class filter_type {
+  //! Pass below corner1.
+  lowpass,
+  //! Pass above corner1.
+  highpass,
+  //! Pass between corner1 and corner2.
+  bandpass,
+  //! Reject between corner1 and corner2.
+  bandstop
+};
+/*! \struct filter_spec
+  \brief Butterworth filter specification (corners in Hz).
+ */
+struct filter_spec {
+  filter_type type{filter_type::lowpass};  //!< Filter type.
+  int order{4};                            //!< Number of poles (lowpass).
+  double corner1{0.0};                     //!< (Low) corner frequency.
+  double corner2{0.0};                     //!< High corner (band filters).
+};
+/*! \struct biquad
+  \brief Second-order section (normalized, \f$a_0 = 1\f$).
+
+  \f$H(z) = (b_0 + b_1 z^{-1} + b_2 z^{-2})/(1 + a_1 z^{-1} + a_2 z^{-2})\f$
+ */
+struct biquad {
+  double b0{1.0};  //!< Numerator coefficient (z^0).
+  double b1{0.0};  //!< Numerator coefficient (z^-1).
+  double b2{0.0};  //!< Numerator coefficient (z^-2).
+  double a1{0.0};  //!< Denominator coefficient (z^-1).
+  double a2{0.0};  //!< Denominator coefficient (z^-2).
+};
+// Frequency response of a second-order-section cascade.
+complex sos_response(std::span<const biquad> sections, double omega) noexcept;
+// Butterworth design (bilinear transform to second-order sections).
+std::vector<biquad> butterworth(const filter_spec &spec, double delta);
+/*! \class iir_filter
+  \brief Butterworth filter designed for a sampling interval.
+
+  The design (second-order sections) is immutable and shared through a cache
+  keyed on (type, order, corners, delta) and bounded by ::max_cached_filters;
+  use iir_filter::get. Filtering is
+  done in blocks of ::filter_block samples, section by section, so the block
+  stays in cache. Batched filtering interleaves ::filter_lanes traces so that
+  each step of the recursion processes all of them together (one vector lane
+  per trace).
+ */
+class iir_filter {
+public:
+  iir_filter(const filter_spec &spec, double delta);
+  [[nodiscard]] const std::vector<biquad> &sections() const noexcept;
+  // Filter one data vector in place (causal or zero-phase).
+  void apply(std::span<double> data, bool zero_phase = false) const noexcept;
+  // Filter several data vectors in place (interleaved).
+  void apply(std::span<const std::span<double>> channels,
+             bool zero_phase = false) const noexcept;
+  // Cached filter.
+  static std::shared_ptr<const iir_filter> get(const filter_spec &spec,
+                                               double delta);
+
+private:
+  std::vector<biquad> sos{};  //!< Second-order sections.
+  void run(std::span<double> data, bool reverse) const noexcept;
+  void run_lanes(std::span<const std::span<double>> channels,
+                 bool reverse) const noexcept;
+  //! Cache key (type, order, corner1, corner2, delta).
+  using cache_key = std::tuple<int, int, double, double, double>;
+  //! Cache of filters by design.
+  static std::map<cache_key, std::shared_ptr<const iir_filter>> cache;
+  //! Cache keys in insertion order (oldest evicted first).
+  static std::deque<cache_key> cache_order;
+  //! Cache lock.
+  static std::mutex cache_mutex;
+};
+// Filter a Trace (data1, in place).
+void filter(Trace *trace, const filter_spec &spec, bool zero_phase = false);
+// Filter many Traces (batched by delta and npts).
+void filter(std::span<Trace> traces, const filter_spec &spec,
+            bool zero_phase = false);
+//--------------------------------------------------------------------------
+// Resampling
+//--------------------------------------------------------------------------
+// Modified Bessel function of the first kind, order zero.
+double bessel_i0(double x) noexcept;
+// Kaiser-windowed sinc lowpass (2 * half_length + 1 taps, unit DC gain).
+std::vector<double> kaiser_lowpass(size_t half_length, double cutoff,
+                                   double beta);
+// Rational factors (up, down) with delta * down / up == new_delta.
+std::pair<size_t, size_t> resample_factors(double delta, double new_delta);
+/*! \class resampler
+  \brief Polyphase FIR resampler by a rational factor up/down.
+
+  Conceptually, the data is upsampled by inserting up - 1 zeros between
+  samples, lowpass filtered (Kaiser-windowed sinc at the lower of the two
+  Nyquist frequencies, ::resample_half_width zero crossings per side), and
+  downsampled by keeping every down-th sample. Only the taps that meet
+  non-zero samples are evaluated: the taps are stored by phase, so each output
+  sample is one contiguous dot product. The filter is centered (zero phase),
+  so the first output sample is at the time of the first input sample.
+
+  The taps are immutable and shared through a cache keyed on (up, down) and
+  bounded by ::max_cached_resamplers; use resampler::get.
+ */
+class resampler {
+public:
+  resampler(size_t up, size_t down);
+  [[nodiscard]] size_t up() const noexcept;
+  [[nodiscard]] size_t down() const noexcept;
+  [[nodiscard]] size_t output_size(size_t input_size) const noexcept;
+  // Resample into an output vector (output_size(input.size()) samples).
+  void apply(std::span<const double> input,
+             std::span<double> output) const noexcept;
+  // Resample in place (down >= up); returns the output size.
+  size_t apply(std::span<double> data) const;
+  // Cached resampler (factors are reduced).
+  static std::shared_ptr<const resampler> get(size_t up, size_t down);
+
+private:
+  size_t n_up{1};        //!< Interpolation factor.
+  size_t n_down{1};      //!< Decimation factor.
+  size_t phase_taps{1};  //!< Taps per phase.
+  size_t delay{0};       //!< Filter delay (upsampled samples).
+  //! Taps by phase (phase-major, reversed within each phase).
+  std::vector<double> taps{};
+  [[nodiscard]] double output_sample(std::span<const double> input,
+                                     size_t index) const noexcept;
+  //! Cache key (up, down).
+  using cache_key = std::pair<size_t, size_t>;
+  //! Cache of resamplers by factors.
+  static std::map<cache_key, std::shared_ptr<const resampler>> cache;
+  //! Cache keys in insertion order (oldest evicted first).
+  static std::deque<cache_key> cache_order;
+  //! Cache lock.
+  static std::mutex cache_mutex;
+};
+// Resample a Trace by a rational factor (data1 and headers).
+void resample(Trace *trace, size_t up, size_t down);
+// Resample a Trace to a new sampling interval.
+void resample(Trace *trace, double new_delta);
+// Decimate a Trace by an integer factor (anti-aliased).
+void decimate(Trace *trace, size_t factor);
+// Interpolate (x, y) samples onto an even grid (streaming merge).
+void interpolate(std::span<const double> x, std::span<const double> y,
+                 double start, double step, std::span<double> output,
+                 interpolation method = interpolation::linear) noexcept;
+// Interpolate an unevenly-sampled Trace onto an even grid.
+void to_even(Trace *trace, double delta,
+             interpolation method = interpolation::linear);
+//--------------------------------------------------------------------------
+// Cross-Correlation
+//--------------------------------------------------------------------------
+/*! \class template_bank
+  \brief Templates prepared for normalized cross-correlation.
+
+  Each template is demeaned, scaled to unit norm, and transformed once (the
+  conjugate spectrum is kept). Continuous data is correlated by overlap-save:
+  each block of data is transformed once and reused for every template, so
+  the cost per lag is a spectral product and an inverse transform per
+  template instead of a template-length sum. The normalized correlation
+  divides by the norm of the demeaned data window, updated in O(1) per lag.
+
+  Lag k compares the template with data[k, k + template size); there are
+  data.size() - template size + 1 lags.
+ */
+class template_bank {
+public:
+  explicit template_bank(const std::vector<std::vector<double>> &templates);
+  [[nodiscard]] size_t size() const noexcept;
+  [[nodiscard]] size_t template_size(size_t index) const noexcept;
+  [[nodiscard]] size_t fft_size() const noexcept;
+  [[nodiscard]] size_t step() const noexcept;
+  [[nodiscard]] size_t lags(size_t data_size, size_t index) const noexcept;
+  // Normalized cross-correlation for lags [first, first + outputs[i].size()).
+  void correlate(std::span<const double> data,
+                 std::span<const std::span<double>> outputs,
+                 size_t first = 0) const;
+  // Normalized cross-correlation of every template (all lags).
+  [[nodiscard]] std::vector<std::vector<double>>
+  correlate(std::span<const double> data) const;
+
+private:
+  size_t n_fft{};                          //!< Overlap-save transform size.
+  size_t block_step{};                     //!< Lags per block.
+  std::vector<size_t> sizes{};             //!< Template sizes.
+  std::vector<size_t> distinct_sizes{};    //!< Distinct template sizes.
+  std::vector<size_t> size_index{};        //!< Template -> distinct size.
+  std::vector<std::vector<complex>> spectra{};  //!< Conjugate spectra.
+  std::shared_ptr<const rfft_plan> plan{};  //!< Overlap-save transform.
+};
+// Normalized cross-correlation of a template bank with many data vectors.
+std::vector<std::vector<std::vector<double>>>
+correlate(const template_bank &bank,
+          std::span<const std::span<const double>> traces, size_t threads = 0);
+// Normalized cross-correlation of a template bank with many Traces (data1).
+std::vector<std::vector<std::vector<double>>>
+correlate(const template_bank &bank, std::span<const Trace> traces,
+          size_t threads = 0);
+//--------------------------------------------------------------------------
+// Triggering
+//--------------------------------------------------------------------------
+/*! \struct sta_lta_spec
+  \brief STA/LTA trigger specification (windows in seconds).
+ */
+struct sta_lta_spec {
+  double sta{1.0};   //!< Short-term window (seconds).
+  double lta{10.0};  //!< Long-term window (seconds).
+  double on{3.5};    //!< Trigger-on threshold (ratio).
+  double off{1.0};   //!< Trigger-off threshold (ratio, at most on).
+  sta_lta_method method{sta_lta_method::recursive};  //!< Averaging method.
+};
+/*! \struct trigger_window
+  \brief Triggered samples [on, off).
+
+  Sample indices count from the first sample given to the trigger (across
+  chunks when streaming).
+ */
+struct trigger_window {
+  size_t on{0};   //!< First sample at or above the on threshold.
+  size_t off{0};  //!< First sample below the off threshold (or the end).
+};
+/*! \class sta_lta
+  \brief Streaming STA/LTA characteristic function for one or more channels.
+
+  Data is given in chunks of any size; the averages carry over from chunk to
+  chunk, so the output does not depend on how the data is split. Several
+  channels are processed together from sample-major (interleaved) chunks,
+  with the channel loop innermost so it vectorizes. Processing does not
+  allocate: all state (for the classic method, a ring of the last long-window
+  energies per channel) is allocated up front.
+
+  The ratio is 0 until the long window has been filled, and where the
+  long-term average is 0.
+ */
+class sta_lta {
+public:
+  sta_lta(size_t n_sta, size_t n_lta,
+          sta_lta_method method = sta_lta_method::recursive,
+          size_t channels = 1);
+  [[nodiscard]] size_t channels() const noexcept;
+  [[nodiscard]] size_t samples() const noexcept;
+  // Characteristic function of the next chunk (interleaved channels).
+  void process(std::span<const double> input,
+               std::span<double> ratio) noexcept;
+  // Forget all previous data.
+  void reset() noexcept;
+
+private:
+  size_t n_channels{1};    //!< Number of channels.
+  size_t short_window{1};  //!< Short-term window (samples).
+  size_t long_window{2};   //!< Long-term window (samples).
+  sta_lta_method type{sta_lta_method::recursive};  //!< Averaging method.
+  size_t count{0};                   //!< Samples processed (per channel).
+  std::vector<double> short_term{};  //!< Short-term sums/averages.
+  std::vector<double> long_term{};   //!< Long-term sums/averages.
+  std::vector<double> energies{};    //!< Energy ring (classic).
+};
+/*! \class trigger
+  \brief Streaming on/off threshold trigger.
+
+  A window opens at the first sample at or above the on threshold and closes
+  at the first later sample below the off threshold. An open window carries
+  over to the next chunk.
+ */
+class trigger {
+public:
+  trigger(double on, double off);
+  [[nodiscard]] bool active() const noexcept;
+  // Scan the next chunk (completed windows are appended).
+  void scan(std::span<const double> ratio,
+            std::vector<trigger_window> *windows);
+  // Close an open window at the end of the data.
+  void finish(std::vector<trigger_window> *windows);
+
+private:
+  double on_threshold{};   //!< Trigger-on threshold.
+  double off_threshold{};  //!< Trigger-off threshold.
+  bool is_on{false};       //!< Window open.
+  size_t onset{0};         //!< Start of the open window.
+  size_t position{0};      //!< Samples scanned.
+};
+// STA/LTA characteristic function of a Trace (data1).
+std::vector<double> sta_lta_ratio(const Trace &trace,
+                                  const sta_lta_spec &spec);
+// STA/LTA trigger windows of a Trace (data1).
+std::vector<trigger_window> detect_triggers(const Trace &trace,
+                                            const sta_lta_spec &spec);
+// Write a pick to a marker (t0..t9) with the matching label (kt0..kt9).
+void write_pick(Trace *trace, time_marker marker, double time,
+                const std::string &label);
+// Write trigger onsets to t0..t9 (kt0..kt9 = label); returns the number.
+size_t write_onsets(Trace *trace, std::span<const trigger_window> windows,
+                    const std::string &label = "STA/LTA");
+/*! \struct timed_trigger
+  \brief Trigger window in absolute time.
+ */
+struct timed_trigger {
+  std::string station{};  //!< Station key (knetwk.kstnm).
+  std::string channel{};  //!< Channel key (knetwk.kstnm.kcmpnm).
+  double on{0.0};         //!< Onset (seconds since the Unix epoch).
+  double off{0.0};        //!< End (seconds since the Unix epoch).
+};
+/*! \struct coincidence_spec
+  \brief Network coincidence specification.
+ */
+struct coincidence_spec {
+  double threshold{3.0};  //!< Weighted station count declaring an event.
+  //! Minimum time a trigger counts after its onset (seconds).
+  double window{10.0};
+  //! Station weights by station key (stations not listed weigh 1).
+  std::unordered_map<std::string, double> weights{};
+};
+/*! \struct coincidence_event
+  \brief Network coincidence (detected event).
+ */
+struct coincidence_event {
+  double on{0.0};    //!< Earliest onset of the coinciding triggers.
+  double off{0.0};   //!< Time the count fell below the threshold.
+  double peak{0.0};  //!< Largest weighted station count.
+  std::vector<std::string> stations{};  //!< Stations that took part.
+};
+// Station key (knetwk.kstnm).
+std::string station_key(const Trace &trace);
+// Trigger windows of a Trace in absolute time.
+std::vector<timed_trigger> timed_triggers(
+    const Trace &trace, std::span<const trigger_window> windows);
+// Network coincidence events (interval sweep over all triggers).
+std::vector<coincidence_event>
+coincidence(std::span<const timed_trigger> triggers,
+            const coincidence_spec &spec);
+//--------------------------------------------------------------------------
+// Instrument Response
+//--------------------------------------------------------------------------
+/*! \struct pole_zero
+  \brief Instrument response as poles and zeros (SAC PZ).
+
+  \f$H(s) = C\prod_i(s - z_i)/\prod_j(s - p_j)\f$ with \f$s = 2\pi if\f$,
+  from ground displacement to the recorded units (counts).
+ */
+struct pole_zero {
+  std::vector<complex> zeros{};  //!< Zeros (radians/second).
+  std::vector<complex> poles{};  //!< Poles (radians/second).
+  double constant{1.0};          //!< Normalization constant (\f$C\f$).
+};
+/*! \struct response_prefilter
+  \brief Cosine prefilter corners (Hz) for response removal.
+
+  The prefilter is zero below f1 and above f4, one from f2 to f3, and a
+  half-cosine between. A non-positive f4 disables the prefilter.
+ */
+struct response_prefilter {
+  double f1{0.0};  //!< Low cut.
+  double f2{0.0};  //!< Low pass.
+  double f3{0.0};  //!< High pass.
+  double f4{0.0};  //!< High cut.
+};
+// Read a SAC pole-zero file.
+pole_zero read_pole_zero(std::istream *input);
+pole_zero read_pole_zero(const std::filesystem::path &path);
+// Instrument response at a frequency (Hz).
+complex evaluate_response(const pole_zero &pz, double frequency) noexcept;
+// Prefilter value at a frequency (Hz).
+double prefilter_weight(const response_prefilter &prefilter,
+                        double frequency) noexcept;
+/*! \class response_plan
+  \brief Inverse instrument response on the frequencies of an rfft.
+
+  Combines the water-level-limited inverse response, the conversion from
+  displacement to the output (multiplication by \f$s\f$ per derivative), and
+  the prefilter. Plans are immutable; use response_plan::get to share them
+  through the response cache (keyed by every parameter, bounded by
+  ::max_cached_responses).
+ */
+class response_plan {
+public:
+  response_plan(const pole_zero &pz, size_t n_fft, double delta,
+                const response_prefilter &prefilter, int output,
+                double water_level);
+  [[nodiscard]] size_t size() const noexcept;
+  [[nodiscard]] std::span<const complex> values() const noexcept;
+  // Multiply a spectrum (size/2 + 1 bins) by the inverse response.
+  void apply(std::span<complex> spectrum) const noexcept;
+  // Cached plan.
+  static std::shared_ptr<const response_plan>
+  get(const pole_zero &pz, size_t n_fft, double delta,
+      const response_prefilter &prefilter, int output, double water_level);
+
+private:
+  size_t n{};                       //!< Transform size.
+  std::vector<complex> inverse{};  //!< Inverse response per bin.
+  //! Cache of plans by parameters (see response_plan::get).
+  static std::map<std::vector<double>, std::shared_ptr<const response_plan>>
+      cache;
+  //! Cache keys in insertion order (oldest evicted first).
+  static std::deque<std::vector<double>> cache_order;
+  //! Cache lock.
+  static std::mutex cache_mutex;
+};
+// Remove the instrument response from a Trace (data1, in place).
+void remove_response(Trace *trace, const pole_zero &pz,
+                     const response_prefilter &prefilter = {},
+                     int output = idisp,
+                     double water_level = default_water_level);
+//--------------------------------------------------------------------------
+// Merging
+//--------------------------------------------------------------------------
+/*! \struct merge_policy
+  \brief Merge specification.
+ */
+struct merge_policy {
+  overlap_policy overlap{overlap_policy::keep_first};  //!< Overlaps.
+  gap_policy gap{gap_policy::split};                   //!< Gaps.
+};
+// Merge pieces of each channel into contiguous Traces.
+std::vector<Trace> merge(std::span<const Trace> pieces,
+                         const merge_policy &policy = {});
+//--------------------------------------------------------------------------
+// Rotation
+//--------------------------------------------------------------------------
+// Apply a 2x2 matrix (row-major) to two components in place (single pass).
+void rotate_components(std::span<double> first, std::span<double> second,
+                       const std::array<double, 4> &matrix) noexcept;
+// Apply a 3x3 matrix (row-major) to three components in place (single pass).
+void rotate_components(std::span<double> first, std::span<double> second,
+                       std::span<double> third,
+                       const std::array<double, 9> &matrix) noexcept;
+// Require aligned components (same npts, delta, and start time).
+void check_aligned(std::span<const Trace *const> traces);
+// Set a component's orientation (kcmpnm ends with component).
+void orient(Trace *trace, char component, double azimuth,
+            double inclination) noexcept;
+// Rotate two horizontal components to radial and transverse.
+void rotate_to_rt(Trace *first, Trace *second);
+// Rotate three components to L, Q, and T.
+void rotate_to_lqt(Trace *first, Trace *second, Trace *third,
+                   double incidence);
+//--------------------------------------------------------------------------
+// Integration and Differentiation
+//--------------------------------------------------------------------------
+// Integrate in place (single pass); returns the number of values.
+size_t integrate(std::span<double> data, double delta,
+                 integration_method method) noexcept;
+// Integrate a Trace (data1 in place, headers and idep updated).
+void integrate(Trace *trace,
+               integration_method method = integration_method::trapezoid);
+// Differentiate in place (single pass); returns the number of values.
+size_t differentiate(std::span<double> data, double delta,
+                     difference_method method) noexcept;
+// Differentiate a Trace (data1 in place, headers and idep updated).
+void differentiate(Trace *trace,
+                   difference_method method = difference_method::central);
+//--------------------------------------------------------------------------
+// Spectral Analysis
+//--------------------------------------------------------------------------
+/*! \class spectrogram_plan
+  \brief Short-time Fourier transform framing of a fixed window.
+
+  Frames of window samples, overlapping by overlap samples, have their mean
+  removed, are tapered (full-length window), zero-padded to n_fft, and
+  transformed; the one-sided power spectral density of each frame is stored.
+  The window weights and the (cached) rfft plan are built once; every frame
+  reuses per-thread workspace. Plans are immutable and thread-safe.
+ */
+class spectrogram_plan {
+public:
+  spectrogram_plan(size_t window, size_t overlap, size_t n_fft = 0,
+                   taper_window taper = taper_window::hann);
+  [[nodiscard]] size_t window() const noexcept;
+  [[nodiscard]] size_t step() const noexcept;
+  [[nodiscard]] size_t size() const noexcept;
+  [[nodiscard]] size_t bins() const noexcept;
+  // Number of frames in samples.
+  [[nodiscard]] size_t frames(size_t samples) const noexcept;
+  // Power spectral density of every frame (frames x bins, row-major).
+  void apply(std::span<const double> data, double delta,
+             std::span<double> output) const;
+  // Mean power spectral density of the frames (Welch); returns the frames.
+  size_t average(std::span<const double> data, double delta,
+                 std::span<double> output) const;
+
+private:
+  size_t length{};                 //!< Window length (samples).
+  size_t hop{};                    //!< Step between frames (samples).
+  std::vector<double> weights{};   //!< Window weights.
+  std::vector<double> scales{};    //!< PSD scale per bin (without delta).
+  std::shared_ptr<const rfft_plan> plan{};  //!< Transform.
+  void frame_power(std::span<const double> segment, double scale,
+                   std::span<double> row, bool accumulate) const;
+};
+/*! \struct spectrogram_matrix
+  \brief Time-frequency matrix (power spectral density).
+ */
+struct spectrogram_matrix {
+  size_t frames{0};             //!< Number of frames (rows).
+  size_t bins{0};               //!< Number of frequencies (columns).
+  double start{0.0};            //!< Time of the center of the first frame.
+  double time_step{0.0};        //!< Time between frames.
+  double frequency_step{0.0};   //!< Frequency between bins (Hz).
+  std::vector<double> values{};  //!< PSD (frames x bins, row-major).
+  // PSD of one frame.
+  [[nodiscard]] std::span<const double> frame(size_t index) const noexcept;
+};
+// Spectrogram of a Trace (data1).
+spectrogram_matrix spectrogram(const Trace &trace, size_t window,
+                               size_t overlap, size_t n_fft = 0,
+                               taper_window taper = taper_window::hann);
+// Spectrograms of many Traces (in parallel, one shared plan).
+std::vector<spectrogram_matrix>
+spectrogram(std::span<const Trace> traces, size_t window, size_t overlap,
+            size_t n_fft = 0, taper_window taper = taper_window::hann,
+            size_t threads = 0);
+/*! \struct power_spectrum
+  \brief Averaged power spectral density.
+ */
+struct power_spectrum {
+  size_t segments{0};           //!< Number of segments averaged.
+  double frequency_step{0.0};   //!< Frequency between bins (Hz).
+  std::vector<double> values{};  //!< One-sided PSD (from 0 Hz).
+};
+// Welch power spectral density of a Trace (data1).
+power_spectrum psd_welch(const Trace &trace, size_t segment, size_t overlap,
+                         size_t n_fft = 0,
+                         taper_window taper = taper_window::hann);
+// Welch power spectral densities of many Traces (in parallel).
+std::vector<power_spectrum>
+psd_welch(std::span<const Trace> traces, size_t segment, size_t overlap,
+          size_t n_fft = 0, taper_window taper = taper_window::hann,
+          size_t threads = 0);
+/*! \struct ppsd_spec
+  \brief Probabilistic power spectral density binning.
+ */
+struct ppsd_spec {
+  double period_min{0.02};      //!< Shortest period bin (seconds).
+  double period_max{1000.0};    //!< Longest period bin (seconds).
+  size_t bins_per_octave{8};    //!< Period bins per octave (log spacing).
+  double smoothing{1.0};        //!< PSD averaging width (octaves).
+  double db_min{-200.0};        //!< Lowest power bin edge (dB).
+  double db_max{-50.0};         //!< Highest power bin edge (dB).
+  double db_step{1.0};          //!< Power bin width (dB).
+};
+/*! \class ppsd
+  \brief Probabilistic power spectral density (2D histogram).
+
+  Each PSD is averaged over smoothing octaves around every period bin,
+  converted to dB, and counted in a (period, power) histogram; powers outside
+  the dB range count in the edge bins, periods the PSD does not resolve (longer
+  than its frequency step allows, or shorter than Nyquist) are skipped.
+  Histograms with the same specification merge by adding counts, so
+  channel-days can be accumulated in parallel.
+ */
+class ppsd {
+public:
+  explicit ppsd(const ppsd_spec &spec = {});
+  [[nodiscard]] const ppsd_spec &spec() const noexcept;
+  [[nodiscard]] size_t periods() const noexcept;
+  [[nodiscard]] size_t powers() const noexcept;
+  [[nodiscard]] size_t count() const noexcept;
+  // Center of a period bin (seconds).
+  [[nodiscard]] double period(size_t index) const noexcept;
+  // Center of a power bin (dB).
+  [[nodiscard]] double power(size_t index) const noexcept;
+  // Counts (periods x powers, row-major).
+  [[nodiscard]] std::span<const size_t> histogram() const noexcept;
+  // Accumulate a one-sided PSD (from 0 Hz).
+  void add(std::span<const double> psd, double frequency_step);
+  // Accumulate an averaged PSD.
+  void add(const power_spectrum &psd);
+  // Accumulate the Welch PSD of every segment of a Trace (data1).
+  size_t add(const Trace &trace, size_t segment, size_t overlap,
+             const spectrogram_plan &welch);
+  // Combine a partial histogram (same specification).
+  void merge(const ppsd &other);
+  // Power percentile per period (dB; NaN for empty periods).
+  [[nodiscard]] std::vector<double> percentile(double percent) const;
+  // Most common power per period (dB; NaN for empty periods).
+  [[nodiscard]] std::vector<double> mode() const;
+
+private:
+  ppsd_spec settings{};                //!< Binning.
+  size_t n_periods{0};                 //!< Number of period bins.
+  size_t n_powers{0};                  //!< Number of power bins.
+  size_t psds{0};                      //!< Number of PSDs accumulated.
+  std::vector<size_t> counts{};        //!< Histogram (periods x powers).
+};
+// Probabilistic PSD of many Traces (channel-days, in parallel).
+ppsd probabilistic_psd(std::span<const Trace> traces, size_t segment,
+                       size_t overlap, const spectrogram_plan &welch,
+                       const ppsd_spec &spec = {}, size_t threads = 0);
+//--------------------------------------------------------------------------
+// Stacking
+//--------------------------------------------------------------------------
+// Time of a marker (relative to the reference time; unset_double if unset).
+double marker_time(const Trace &trace, time_marker marker) noexcept;
+/*! \struct stack_spec
+  \brief Stack specification.
+ */
+struct stack_spec {
+  size_t length{0};    //!< Stack length (samples).
+  double delta{1.0};   //!< Sampling interval.
+  double begin{0.0};   //!< Time of the first sample (from the alignment).
+  stack_method method{stack_method::linear};  //!< Method.
+  double order{2.0};   //!< nth-root order or phase-weight exponent.
+};
+/*! \class stacker
+  \brief Streaming stack of aligned inputs.
+
+  Inputs are accumulated one at a time (memory is proportional to the stack
+  length, not the number of inputs); partial stacks (e.g. one per thread) are
+  combined with stacker::merge. Each stack sample is normalized by the number
+  of inputs that covered it.
+ */
+class stacker {
+public:
+  explicit stacker(const stack_spec &spec);
+  [[nodiscard]] const stack_spec &spec() const noexcept;
+  // Number of inputs added.
+  [[nodiscard]] size_t count() const noexcept;
+  // Accumulate data (data[j] at stack sample j + offset).
+  void add(std::span<const double> data, std::ptrdiff_t offset);
+  // Accumulate a Trace (data1) with time reference at stack time 0.
+  void add(const Trace &trace, double reference);
+  // Accumulate a Trace (data1) aligned on a marker.
+  void add(const Trace &trace, time_marker marker);
+  // Combine a partial stack (same specification).
+  void merge(const stacker &other);
+  // Stack (zero where no input contributed).
+  [[nodiscard]] std::vector<double> result() const;
+  // Stack as an evenly-sampled time-series Trace.
+  [[nodiscard]] Trace to_trace() const;
+
+private:
+  stack_spec settings{};         //!< Specification.
+  size_t inputs{0};              //!< Number of inputs added.
+  std::vector<double> sums{};    //!< Sums of the samples (or of their roots).
+  std::vector<complex> phases{};  //!< Sums of unit phasors (phase-weighted).
+  std::vector<size_t> counts{};  //!< Number of inputs per sample.
+};
+// Stack inputs added on demand (parallel reduction of partial stacks).
+stacker stack(size_t count,
+              const std::function<void(size_t, stacker *)> &add_input,
+              const stack_spec &spec, size_t threads = 0);
+// Stack Traces aligned on a marker (in parallel).
+stacker stack(std::span<const Trace> traces, time_marker marker,
+              const stack_spec &spec, size_t threads = 0);
+//--------------------------------------------------------------------------
+// Array Processing
+//--------------------------------------------------------------------------
+/*! \struct array_geometry
+  \brief Station positions relative to the array center (flat Earth).
+ */
+struct array_geometry {
+  double latitude{0.0};         //!< Array center latitude (degrees).
+  double longitude{0.0};        //!< Array center longitude (degrees).
+  std::vector<double> east{};   //!< Station offsets east (km).
+  std::vector<double> north{};  //!< Station offsets north (km).
+};
+// Station positions of Traces (stla, stlo) relative to their center.
+array_geometry array_coordinates(std::span<const Trace> traces);
+/*! \struct slowness_grid
+  \brief Square grid of horizontal slowness (east and north).
+ */
+struct slowness_grid {
+  double max{0.5};     //!< Largest slowness on each axis (seconds/km).
+  size_t points{101};  //!< Points on each axis (from -max to max).
+  // Slowness of a point on an axis (seconds/km).
+  [[nodiscard]] double value(size_t index) const noexcept;
+};
+/*! \struct fk_result
+  \brief Relative beam power over a slowness grid.
+ */
+struct fk_result {
+  //! Relative power (0 to 1; points x points, rows north, columns east).
+  std::vector<double> power{};
+  double peak{0.0};            //!< Largest relative power.
+  double slowness_east{0.0};   //!< East slowness of the peak (seconds/km).
+  double slowness_north{0.0};  //!< North slowness of the peak (seconds/km).
+  double back_azimuth{0.0};    //!< Back azimuth of the peak (degrees).
+  double velocity{0.0};        //!< Apparent velocity of the peak (km/s).
+};
+/*! \class fk_plan
+  \brief Frequency-wavenumber beam power of an array over a slowness grid.
+
+  For every grid point and station the phase factor of the first frequency in
+  the band and its change per frequency step are precomputed, so evaluating a
+  window is only complex multiply-adds (grid rows in parallel).
+ */
+class fk_plan {
+public:
+  fk_plan(const array_geometry &geometry, const slowness_grid &grid,
+          size_t window, double delta, double low, double high);
+  [[nodiscard]] size_t stations() const noexcept;
+  [[nodiscard]] size_t window() const noexcept;
+  [[nodiscard]] const slowness_grid &grid() const noexcept;
+  // Beam power of the window starting at sample start of every Trace.
+  [[nodiscard]] fk_result power(std::span<const Trace> traces, size_t start,
+                                size_t threads = 0) const;
+
+private:
+  slowness_grid slowness{};          //!< Grid.
+  size_t n_stations{};               //!< Number of stations.
+  size_t length{};                   //!< Window length (samples).
+  double interval{};                 //!< Sampling interval.
+  size_t first_bin{};                //!< First frequency bin of the band.
+  size_t n_bins{};                   //!< Number of frequency bins.
+  std::vector<double> weights{};     //!< Window taper.
+  std::shared_ptr<const rfft_plan> plan{};  //!< Transform.
+  std::vector<complex> phasors{};    //!< Phase factors (point, station).
+  std::vector<complex> steps{};      //!< Per-bin factor changes.
+};
+// Delay-and-sum beam of aligned Traces (nearest-sample delays).
+Trace delay_and_sum(std::span<const Trace> traces,
+                    const array_geometry &geometry, double slowness_east,
+                    double slowness_north);
+//--------------------------------------------------------------------------
+// Amplitude Metrics
+//--------------------------------------------------------------------------
+/*! \struct amplitude_spec
+  \brief Sliding-window amplitude metrics specification.
+ */
+struct amplitude_spec {
+  size_t window{100};  //!< Window length (samples).
+  size_t overlap{0};   //!< Overlap between windows (samples).
+  //! Percentiles of the absolute amplitude (0 to 100; none by default).
+  std::vector<double> percentiles{};
+};
+/*! \struct amplitude_metrics
+  \brief Amplitude metrics of every window (compact arrays).
+ */
+struct amplitude_metrics {
+  size_t windows{0};       //!< Number of windows.
+  double start{0.0};       //!< Time of the center of the first window.
+  double time_step{0.0};   //!< Time between windows.
+  std::vector<double> rms{};   //!< Root-mean-square per window.
+  std::vector<double> peak{};  //!< Peak absolute amplitude per window.
+  //! Percentiles per window (windows x percentiles, row-major).
+  std::vector<double> percentiles{};
+};
+// Sliding-window amplitude metrics of data (time in samples).
+amplitude_metrics amplitudes(std::span<const double> data,
+                             const amplitude_spec &spec);
+// Sliding-window amplitude metrics of a Trace (data1).
+amplitude_metrics amplitudes(const Trace &trace, const amplitude_spec &spec);
+// Sliding-window amplitude metrics of many Traces (in parallel).
+std::vector<amplitude_metrics> amplitudes(std::span<const Trace> traces,
+                                          const amplitude_spec &spec,
+                                          size_t threads = 0);
+//--------------------------------------------------------------------------
+// Level of Detail
+//--------------------------------------------------------------------------
+//! Samples per block of the finest level, and between levels.
+constexpr size_t lod_factor{4};
+//! Level-of-detail file identifier (and format version).
+constexpr std::array<char, 8> lod_magic{'S', 'A', 'C', 'L', 'O', 'D', '0', '1'};
+/*! \struct lod_pyramid
+  \brief Min/max level-of-detail pyramid of a Trace.
+
+  Level k summarizes blocks of lod_factor^(k + 1) samples (the last block may
+  be partial), down to a single block.
+ */
+struct lod_pyramid {
+  size_t npts{0};      //!< Number of samples summarized.
+  double begin{0.0};   //!< Time of the first sample (like b).
+  double delta{0.0};   //!< Sampling interval.
+  //! Interleaved minimum and maximum of every block, per level.
+  std::vector<std::vector<float>> levels{};
+  // Samples per block of a level.
+  [[nodiscard]] size_t block(size_t level) const noexcept;
+};
+/*! \struct lod_envelope
+  \brief Min/max envelope at pixel resolution.
+ */
+struct lod_envelope {
+  double start{0.0};   //!< Start time of the first pixel.
+  double step{0.0};    //!< Time per pixel.
+  size_t level{0};     //!< Pyramid level used.
+  std::vector<float> minimum{};  //!< Minimum per pixel (NaN if no data).
+  std::vector<float> maximum{};  //!< Maximum per pixel (NaN if no data).
+};
+// Build the level-of-detail pyramid of a Trace (data1).
+lod_pyramid build_lod(const Trace &trace);
+// Min/max envelope of a time range at pixel resolution.
+lod_envelope lod_range(const lod_pyramid &pyramid, double t0, double t1,
+                       size_t pixels);
+// Level-of-detail file next to a SAC-file (path + ".lod").
+std::filesystem::path lod_path(const std::filesystem::path &path);
+// Write a level-of-detail pyramid.
+void write_lod(const lod_pyramid &pyramid, std::ostream *output);
+// Write a level-of-detail pyramid to a file.
+void write_lod(const lod_pyramid &pyramid, const std::filesystem::path &path);
+// Read a level-of-detail pyramid.
+lod_pyramid read_lod(std::istream *input);
+// Read a level-of-detail pyramid from a file.
+lod_pyramid read_lod(const std::filesystem::path &path);
+//--------------------------------------------------------------------------
+// Time Shifting
+//--------------------------------------------------------------------------
+// Delay data by a (fractional) number of samples (zero outside the data).
+void fractional_shift(std::span<double> data, double shift,
+                      shift_method method = shift_method::sinc);
+// Delay a Trace by shift seconds (whole samples in b, the rest in data1).
+void time_shift(Trace *trace, double shift,
+                shift_method method = shift_method::sinc);
+// Move the sample times of a Trace by samples (keeping the waveform).
+void regrid(Trace *trace, double offset,
+            shift_method method = shift_method::sinc);
+// Resample Traces so that a marker falls on a sample (in parallel).
+void align(std::span<Trace> traces, time_marker marker,
+           shift_method method = shift_method::sinc, size_t threads = 0);
+// Resample Traces onto a common absolute time grid (in parallel).
+void align(std::span<Trace> traces, shift_method method = shift_method::sinc,
+           size_t threads = 0);
+//--------------------------------------------------------------------------
+// Noise Correlation
+//--------------------------------------------------------------------------
+/*! \struct noise_spec
+  \brief Ambient-noise cross-correlation specification.
+ */
+struct noise_spec {
+  size_t window{0};   //!< Correlation window (samples).
+  size_t overlap{0};  //!< Overlap between windows (samples).
+  size_t max_lag{0};  //!< Largest lag kept (samples, less than window).
+  //! Temporal normalization of each window.
+  temporal_normalization normalization{temporal_normalization::one_bit};
+  //! Running absolute mean window (samples, odd; running_mean only).
+  size_t running_window{0};
+  bool whiten{true};  //!< Spectral whitening (unit amplitude in the band).
+  //! Whitening amplitude smoothing half-width (bins; 0 keeps only phase).
+  size_t smoothing{0};
+  //! Frequency band (Hz, cosine-tapered corners; f4 <= 0 keeps all).
+  response_prefilter band{};
+};
+/*! \class noise_correlator
+  \brief Stacked ambient-noise cross-correlations of every station pair.
+
+  Each window of each station is demeaned, normalized in time, transformed
+  once, and whitened; the cross-spectrum of every pair is then accumulated in
+  the frequency domain (only the bins in the band are kept). Correlation and
+  stacking are linear, so the inverse transform is done once per pair when
+  the stack is read instead of once per pair per window.
+
+  For stations i and j, lag k is the correlation of data_i(t) with
+  data_j(t + k): positive lags are arrivals at j after i.
+ */
+class noise_correlator {
+public:
+  noise_correlator(size_t stations, double delta, const noise_spec &spec);
+  [[nodiscard]] const noise_spec &spec() const noexcept;
+  [[nodiscard]] size_t stations() const noexcept;
+  [[nodiscard]] size_t pairs() const noexcept;
+  [[nodiscard]] size_t windows() const noexcept;
+  [[nodiscard]] size_t fft_size() const noexcept;
+  [[nodiscard]] size_t bins() const noexcept;
+  // Normalized, whitened spectrum of one window (bins() values).
+  void spectrum(std::span<const double> data, std::span<complex> output) const;
+  // Accumulate one simultaneous window per station.
+  void add(std::span<const std::span<const double>> windows,
+           size_t threads = 0);
+  // Split aligned Traces (one per station) into windows and accumulate.
+  size_t add(std::span<const Trace> traces, size_t threads = 0);
+  // Combine a partial stack (same stations, sampling, and specification).
+  void merge(const noise_correlator &other);
+  // Stacked correlation of a pair (lags -max_lag to max_lag).
+  [[nodiscard]] std::vector<double> correlation(size_t first,
+                                                size_t second) const;
+
+private:
+  noise_spec settings{};     //!< Specification.
+  size_t n_stations{0};      //!< Number of stations.
+  double sampling{0.0};      //!< Sampling interval.
+  size_t n_fft{0};           //!< Transform size (window + max_lag, padded).
+  size_t first_bin{0};       //!< First frequency bin kept.
+  size_t stacked{0};         //!< Number of windows accumulated.
+  std::vector<double> weights{};  //!< Band weights of the kept bins.
+  std::vector<complex> sums{};    //!< Cross-spectra (pair-major).
+  std::shared_ptr<const rfft_plan> plan{};  //!< Transform.
+  [[nodiscard]] size_t pair_index(size_t first, size_t second) const noexcept;
+  void accumulate(size_t first, std::span<const complex> spectra,
+                  std::span<complex> output) const noexcept;
+};
+//--------------------------------------------------------------------------
+// Phase Picking
+//--------------------------------------------------------------------------
+/*! \struct pick_spec
+  \brief Automatic phase picker specification (times in seconds).
+ */
+struct pick_spec {
+  picker_method method{picker_method::aic};  //!< Picking method.
+  double before{5.0};   //!< Search window before the predicted time.
+  double after{5.0};    //!< Search window after the predicted time.
+  //! Kurtosis window, short-term window, and signal-to-noise window.
+  double window{1.0};
+  double lta{10.0};     //!< Long-term window (sta_lta only).
+  double on{3.0};       //!< STA/LTA threshold (sta_lta only).
+  double min_snr{0.0};  //!< Smallest signal-to-noise ratio accepted.
+  time_marker marker{time_marker::t0};  //!< Pick header (t0 to t9).
+  //! Pick label (kt0 to kt9; empty for AIC, KURT, or STA/LTA).
+  std::string label{};
+};
+/*! \struct phase_pick
+  \brief Automatic phase pick.
+ */
+struct phase_pick {
+  double time{unset_double};  //!< Pick time (like b; unset if no pick).
+  //! RMS ratio of the window after the pick to the window before it.
+  double snr{0.0};
+};
+// AIC characteristic function (minimum at the onset).
+void aic_function(std::span<const double> data,
+                  std::span<double> output) noexcept;
+// Sliding (trailing window) excess kurtosis characteristic function.
+void kurtosis_function(std::span<const double> data, size_t window,
+                       std::span<double> output) noexcept;
+// Pick a phase near a predicted time (written to the spec marker).
+phase_pick pick_phase(Trace *trace, double predicted, const pick_spec &spec);
+// Pick phases near a predicted marker on many Traces (in parallel).
+std::vector<phase_pick> pick_phases(std::span<Trace> traces,
+                                    time_marker predicted,
+                                    const pick_spec &spec, size_t threads = 0);
+//--------------------------------------------------------------------------
+// Errors
+//--------------------------------------------------------------------------
+/*! \class processing_error
+  \brief Class for signal-processing exceptions.
+
+  These errors occur when a Trace is not suitable for the requested operation
+  (wrong file type, uneven sampling, missing sampling interval, etc.).
+ */
+class processing_error : public std::exception {
+private:
+  const std::string message{};  //!< Error message
+
+public:
+  /*!
+    \brief processing_error Constructor
+
+    @param[in] msg std::string Error message.
+   */
+  explicit processing_error(std::string msg) : message(std::move(msg)) {}
+  /*!
+    \brief Error message delivery.
+
+    @returns what char* Error message.
+    */
+  [[nodiscard]] const char *what() const noexcept override {
+    return message.c_str();
+  }
+};
+}  // namespace sacfmt
+#endif
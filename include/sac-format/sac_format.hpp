@@ -26,6 +26,8 @@
 #include <bitset>
 // std::abs, std::acos, std::sin, std::cos, std::atan2, std::pow
 #include <cmath>
+// std::int32_t, std::int64_t
+#include <cstdint>
 // std::memcopy
 #include <cstring>
 // std::filesystem::path
@@ -33,12 +35,20 @@
 // std::ifstream, std::ifstream::binary, std::ofstream, std::ios::binary,
 // std::ios::out, std::ios::trunc
 #include <fstream>
+// std::setw, std::setfill
+#include <iomanip>
+// std::numeric_limits
+#include <limits>
 // std::numbers::pi_v<double>
 #include <numbers>
+// std::optional
+#include <optional>
 // std::exception
 #include <stdexcept>
-// ostringstream
+// std::istringstream, std::ostringstream
 #include <sstream>
+// std::span
+#include <span>
 // std::string
 #include <string>
 // std::unordered_map
@@ -116,6 +126,22 @@ constexpr double deg_per_rad{1.0 / rad_per_deg};
 constexpr double circle_deg{360.0};
 //! Average radius of Earth (kilometers).
 constexpr double earth_radius{6378.14};
+//! iFType value for time-series data.
+constexpr int itime{1};
+//! iFType value for spectral data (real/imaginary).
+constexpr int irlim{2};
+//! iFType value for spectral data (amplitude/phase).
+constexpr int iamph{3};
+//! iFType value for general x versus y data.
+constexpr int ixy{4};
+//! iDep value for unknown dependent variable.
+constexpr int iunkn{5};
+//! iDep value for displacement.
+constexpr int idisp{6};
+//! iDep value for velocity.
+constexpr int ivel{7};
+//! iDep value for acceleration.
+constexpr int iacc{8};
 //--------------------------------------------------------------------------
 // Conversions
 //--------------------------------------------------------------------------
@@ -223,18 +249,21 @@ void safe_to_read_data(std::ifstream *sac, size_t n_words, bool data2 = false);
 // Have we reached the end of the SAC-file or are there shenanigans?
 void safe_to_finish_reading(std::ifstream *sac);
 // Read one word (32 bits, useful for non-strings) from a binary SAC-file.
-word_one read_word(std::ifstream *sac);
+word_one read_word(std::istream *sac);
 // Read two words (64 bits, useful for strings) from a binary SAC-file.
-word_two read_two_words(std::ifstream *sac);
+word_two read_two_words(std::istream *sac);
 // Read four words (128 bits, kEvNm only) from a binary SAC-file.
-word_four read_four_words(std::ifstream *sac);
+word_four read_four_words(std::istream *sac);
 // Read arbitrary number of words (vectors) from a binary SAC-file.
-std::vector<double> read_data(std::ifstream *sac, const read_spec &spec);
+std::vector<double> read_data(std::ifstream *sac, const read_spec &spec,
+                              std::uint32_t *crc = nullptr);
 //--------------------------------------------------------------------------
 // Writing
 //--------------------------------------------------------------------------
+//! Number of data values converted per chunk during bulk reading/writing.
+constexpr size_t io_chunk{16384};
 // Write arbitrary number of words (vectors) to a binary SAC-file.
-void write_words(std::ofstream *sac_file, const std::vector<char> &input);
+void write_words(std::ostream *sac_file, const std::vector<char> &input);
 // Template function to convert input value into a std::vector<char> for
 // writing.
 template <typename T> std::vector<char> convert_to_word(T input) noexcept;
@@ -251,6 +280,78 @@ bool equal_within_tolerance(const std::vector<double> &vector1,
                             double tolerance = f_eps) noexcept;
 bool equal_within_tolerance(double val1, double val2,
                             double tolerance = f_eps) noexcept;
+/*! \struct tolerance_spec
+  \brief Numerical tolerances used when comparing data vectors.
+
+  Two values are considered equal if their absolute difference is less than
+  `absolute`, or (only when `ulps` is positive) if they are within `ulps`
+  units-in-the-last-place of each other at single-precision (the precision of
+  the data on disk).
+ */
+struct tolerance_spec {
+  double absolute{f_eps};  //!< Absolute tolerance.
+  int ulps{0};             //!< ULP tolerance (0 = disabled).
+};
+//! Number of values compared per block by the vectorized comparison kernel.
+constexpr size_t compare_block{64};
+//! Index returned when no mismatch is found.
+constexpr size_t no_mismatch{static_cast<size_t>(-1)};
+// Distance between two values in units-in-the-last-place (single-precision).
+std::int64_t ulp_distance(float val1, float val2) noexcept;
+// Count values outside tolerance in a block (branch-free).
+size_t count_mismatches(const double *first, const double *second,
+                        size_t size, const tolerance_spec &spec) noexcept;
+// Index of the first element outside tolerance (no_mismatch if none).
+size_t first_mismatch(std::span<const double> vector1,
+                      std::span<const double> vector2,
+                      const tolerance_spec &spec = {}) noexcept;
+/*! \struct data_comparison
+  \brief Summary of the differences between two data vectors.
+ */
+struct data_comparison {
+  size_t first_mismatch{no_mismatch};  //!< First index outside tolerance.
+  size_t mismatches{0};  //!< Number of values outside tolerance.
+  double max_abs_error{0.0};  //!< Maximum absolute difference.
+};
+// Full (non-short-circuiting) comparison of two data vectors.
+data_comparison compare_data(std::span<const double> vector1,
+                             std::span<const double> vector2,
+                             const tolerance_spec &spec = {}) noexcept;
+//--------------------------------------------------------------------------
+// Checksums
+//--------------------------------------------------------------------------
+//! CRC-32C (Castagnoli) polynomial (reversed representation).
+constexpr std::uint32_t crc32c_polynomial{0x82F63B78U};
+// Update a CRC-32C checksum with additional bytes.
+std::uint32_t crc32c(std::span<const char> bytes,
+                     std::uint32_t crc = 0) noexcept;
+// Path of the fingerprint sidecar file for a SAC-file.
+std::filesystem::path fingerprint_path(const std::filesystem::path &path);
+// Write fingerprint sidecar file for a SAC-file.
+void write_fingerprint(const std::filesystem::path &path,
+                       std::uint32_t fingerprint);
+// Read fingerprint sidecar file for a SAC-file.
+std::uint32_t read_fingerprint(const std::filesystem::path &path);
+//--------------------------------------------------------------------------
+// Statistics
+//--------------------------------------------------------------------------
+//! Number of independent accumulators (lanes) used by the statistics kernel.
+constexpr size_t stats_lanes{8};
+/*! \struct data_stats
+  \brief Summary statistics of a data vector.
+
+  Fields are ::unset_double if the data vector is empty.
+ */
+struct data_stats {
+  size_t count{0};             //!< Number of values.
+  double min{unset_double};    //!< Minimum value.
+  double max{unset_double};    //!< Maximum value.
+  double mean{unset_double};   //!< Arithmetic mean.
+  double rms{unset_double};    //!< Root-mean-square.
+  double stddev{unset_double};  //!< Population standard deviation.
+};
+// Single-pass statistics of a data vector.
+data_stats compute_stats(std::span<const double> data) noexcept;
 //--------------------------------------------------------------------------
 // Geometric Methods
 //--------------------------------------------------------------------------
@@ -1066,6 +1167,7 @@ const std::unordered_map<name, const size_t> sac_map = {
     // Data
     {name::data1, 0},
     {name::data2, 1}};
+struct trace_comparison;
 // Trace class
 /*! \class Trace
  \brief The Trace class.
@@ -1083,14 +1185,21 @@ public:
   Trace() noexcept;
   // Parametric constructor (read file)
   explicit Trace(const std::filesystem::path &path);
-  void write(const std::filesystem::path &path, bool legacy = false) const;
-  void legacy_write(const std::filesystem::path &path) const;
+  std::uint32_t write(const std::filesystem::path &path, bool legacy = false,
+                      bool with_stats = false) const;
+  std::uint32_t legacy_write(const std::filesystem::path &path,
+                             bool with_stats = false) const;
   bool operator==(const Trace &other) const noexcept;
+  friend trace_comparison compare(const Trace &trace1, const Trace &trace2,
+                                  const tolerance_spec &spec);
   // Convenience functions
   void calc_geometry() noexcept;
   [[nodiscard]] double frequency() const noexcept;
   [[nodiscard]] std::string date() const noexcept;
   [[nodiscard]] std::string time() const noexcept;
+  [[nodiscard]] double reference_epoch() const noexcept;
+  [[nodiscard]] std::optional<std::uint32_t> fingerprint() const noexcept;
+  data_stats update_stats() noexcept;
   // Getters
   // Floats
   [[nodiscard]] float depmin() const noexcept;
@@ -1214,6 +1323,11 @@ public:
   // Data
   [[nodiscard]] std::vector<double> data1() const noexcept;
   [[nodiscard]] std::vector<double> data2() const noexcept;
+  // Data views (no copy; size is fixed, use the setters to resize)
+  [[nodiscard]] std::span<const double> data1_view() const noexcept;
+  [[nodiscard]] std::span<const double> data2_view() const noexcept;
+  [[nodiscard]] std::span<double> data1_view() noexcept;
+  [[nodiscard]] std::span<double> data2_view() noexcept;
   // Setters
   // Floats
   void depmin(float input) noexcept;
@@ -1337,8 +1451,11 @@ public:
   // Data
   void data1(const std::vector<double> &input) noexcept;
   void data2(const std::vector<double> &input) noexcept;
-  static void write_data(std::ofstream *sac_file,
-                         const std::vector<double> &data_vec);
+  void data1(std::vector<double> &&input) noexcept;
+  void data2(std::vector<double> &&input) noexcept;
+  static void write_data(std::ostream *sac_file,
+                         std::span<const double> data_vec,
+                         std::uint32_t *crc = nullptr);
 
 private:
   // Convenience methods
@@ -1348,41 +1465,43 @@ private:
   void calc_baz() noexcept;
   // Readers
   // Floats
-  void read_float_headers_starter(std::ifstream *sac_file);
-  void read_float_headers_t(std::ifstream *sac_file);
-  void read_float_headers_resp(std::ifstream *sac_file);
-  void read_float_headers_station_event(std::ifstream *sac_file);
-  void read_float_headers_user(std::ifstream *sac_file);
-  void read_float_headers_geometry(std::ifstream *sac_file);
-  void read_float_headers_meta(std::ifstream *sac_file);
-  void read_float_headers(std::ifstream *sac_file);
+  void read_float_headers_starter(std::istream *sac_file);
+  void read_float_headers_t(std::istream *sac_file);
+  void read_float_headers_resp(std::istream *sac_file);
+  void read_float_headers_station_event(std::istream *sac_file);
+  void read_float_headers_user(std::istream *sac_file);
+  void read_float_headers_geometry(std::istream *sac_file);
+  void read_float_headers_meta(std::istream *sac_file);
+  void read_float_headers(std::istream *sac_file);
   // Integers
-  void read_int_headers_datetime(std::ifstream *sac_file);
-  void read_int_headers_meta(std::ifstream *sac_file);
-  void read_int_headers(std::ifstream *sac_file);
+  void read_int_headers_datetime(std::istream *sac_file);
+  void read_int_headers_meta(std::istream *sac_file);
+  void read_int_headers(std::istream *sac_file);
   // Others
-  void read_bool_headers(std::ifstream *sac_file);
-  void read_string_headers(std::ifstream *sac_file);
-  void read_datas(std::ifstream *sac_file);
-  void read_footers(std::ifstream *sac_file);
+  void read_bool_headers(std::istream *sac_file);
+  void read_string_headers(std::istream *sac_file);
+  void read_datas(std::ifstream *sac_file, std::uint32_t *crc = nullptr);
+  void read_footers(std::istream *sac_file);
+  static std::string read_block(std::ifstream *sac_file, size_t n_bytes,
+                                std::uint32_t *crc);
   // Writers
   // Floats
-  void write_float_headers_starter(std::ofstream *sac_file) const;
-  void write_float_headers_t(std::ofstream *sac_file) const;
-  void write_float_headers_resp(std::ofstream *sac_file) const;
-  void write_float_headers_station_event(std::ofstream *sac_file) const;
-  void write_float_headers_user(std::ofstream *sac_file) const;
-  void write_float_headers_geometry(std::ofstream *sac_file) const;
-  void write_float_headers_meta(std::ofstream *sac_file) const;
-  void write_float_headers(std::ofstream *sac_file) const;
+  void write_float_headers_starter(std::ostream *sac_file) const;
+  void write_float_headers_t(std::ostream *sac_file) const;
+  void write_float_headers_resp(std::ostream *sac_file) const;
+  void write_float_headers_station_event(std::ostream *sac_file) const;
+  void write_float_headers_user(std::ostream *sac_file) const;
+  void write_float_headers_geometry(std::ostream *sac_file) const;
+  void write_float_headers_meta(std::ostream *sac_file) const;
+  void write_float_headers(std::ostream *sac_file) const;
   // Integers
-  void write_int_headers_datetime(std::ofstream *sac_file) const;
-  void write_int_headers_meta(std::ofstream *sac_file, int hdr_ver) const;
-  void write_int_headers(std::ofstream *sac_file, int hdr_ver) const;
+  void write_int_headers_datetime(std::ostream *sac_file) const;
+  void write_int_headers_meta(std::ostream *sac_file, int hdr_ver) const;
+  void write_int_headers(std::ostream *sac_file, int hdr_ver) const;
   // Others
-  void write_bool_headers(std::ofstream *sac_file) const;
-  void write_string_headers(std::ofstream *sac_file) const;
-  void write_footers(std::ofstream *sac_file) const;
+  void write_bool_headers(std::ostream *sac_file) const;
+  void write_string_headers(std::ostream *sac_file) const;
+  void write_footers(std::ostream *sac_file) const;
   [[nodiscard]] bool geometry_set() const noexcept;
   //! \brief Return station location as a point.
   [[nodiscard]] point station_location() const noexcept {
@@ -1409,7 +1528,34 @@ private:
   std::array<std::vector<double>, num_data>
       // cppcheck-suppress unusedStructMember
       data{};  //!< std::vector<double> storage array.
+  //! CRC-32C of the SAC-file bytes this Trace was read from (reset by setters).
+  std::optional<std::uint32_t> checksum{};
+};
+
+/*! \struct trace_comparison
+  \brief Report of the differences between two Traces.
+
+  Unlike Trace::operator==, the comparison does not stop at the first
+  difference; it lists every differing header field (including booleans) and
+  summarizes both data vectors.
+ */
+struct trace_comparison {
+  std::vector<name> headers{};  //!< Header fields that differ.
+  data_comparison data1{};      //!< Summary of data1 differences.
+  data_comparison data2{};      //!< Summary of data2 differences.
+  /*!
+    \brief Determine if the compared Traces are equal.
+
+    @returns bool True if no header or data differences were found.
+   */
+  [[nodiscard]] bool equal() const noexcept {
+    return headers.empty() && (data1.mismatches == 0) &&
+           (data2.mismatches == 0);
+  }
 };
+// Compare two Traces, reporting all differences.
+trace_comparison compare(const Trace &trace1, const Trace &trace2,
+                         const tolerance_spec &spec = {});
 
 /*! \class io_error
   \brief Class for generic I/O exceptions.
@@ -1,5 +1,6 @@
 // Copyright 2023-2024 Alexander R. Blanchette
 
+#include "sac-format/processing.hpp"
 #include "sac-format/sac_format.hpp"
 #include "sac-format/util.hpp"
 // Catch2 https://github.com/catchorg/Catch2/tree/v3.4.0
@@ -14,7 +15,10 @@
 //   https://en.cppreference.com/w/cpp/standard_library
 #include <bitset>
 #include <iomanip>
+#include <iterator>
 #include <limits>
+#include <sstream>
+#include <tuple>
 
 // using namespace sacfmt;
 namespace fs = std::filesystem;
@@ -207,6 +211,15 @@ TEST_CASE("Input/Output") {
       };
       fs::remove(tmp_file);
     }
+    SECTION("Fingerprint") {
+      test_sac.write(tmp_file);
+      std::ifstream file(tmp_file, std::ios::binary);
+      const std::string bytes{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+      file.close();
+      BENCHMARK("CRC-32C") { return crc32c(bytes); };
+      fs::remove(tmp_file);
+    }
     SECTION("Comparison Between Out and In Zeros") {
       test_sac.write(tmp_file);
       Trace in_sac{tmp_file};
@@ -237,9 +250,609 @@ TEST_CASE("Input/Output") {
       // what can be handled via a float this is because binary SAC files
       // use floats for the data values, not doubles
       BENCHMARK("Trace Comparison") { (void)(test_sac == in_sac); };
+      BENCHMARK("Trace Comparison Report") {
+        return compare(test_sac, in_sac);
+      };
+      BENCHMARK("Trace Comparison Report (ULP)") {
+        return compare(test_sac, in_sac, {f_eps, 4});
+      };
+      BENCHMARK("Data Statistics (Three Passes)") {
+        const std::vector<double> values{test_sac.data1()};
+        double sum{0.0};
+        std::for_each(values.begin(), values.end(),
+                      [&sum](const double value) { sum += value; });
+        return std::make_tuple(
+            *std::min_element(values.begin(), values.end()),
+            *std::max_element(values.begin(), values.end()),
+            sum / static_cast<double>(values.size()));
+      };
+      BENCHMARK("Data Statistics (Single Pass)") {
+        return test_sac.update_stats();
+      };
       fs::remove(tmp_file);
     }
   }
 }
+
+TEST_CASE("Preprocessing") {
+  Trace test_sac = gen_fake_trace();
+  std::vector<double> data{};
+  data.resize(static_cast<size_t>(test_sac.npts()));
+  random_vector(&data);
+  test_sac.data1(data);
+  BENCHMARK("Rmean, Rtrend, Taper (Copies)") {
+    std::vector<double> values{test_sac.data1()};
+    rmean(values);
+    rtrend(values);
+    taper(values);
+    test_sac.data1(values);
+    return;
+  };
+  BENCHMARK("Rmean, Rtrend, Taper (In Place)") {
+    rmean(&test_sac);
+    rtrend(&test_sac);
+    taper(&test_sac);
+    return;
+  };
+  BENCHMARK("Preprocess (Fused)") {
+    preprocess(&test_sac);
+    return;
+  };
+}
+
+TEST_CASE("Fourier Transform") {
+  for (const size_t size : std::array<size_t, 3>{4096, 6000, 4099}) {
+    std::vector<double> data(size);
+    random_vector(&data);
+    const std::string label{std::to_string(size)};
+    BENCHMARK("Real FFT (Cached Plan) " + label) { return rfft(data); };
+    BENCHMARK("Real FFT (New Plan) " + label) {
+      const rfft_plan plan{size};
+      std::vector<complex> spectrum(plan.bins());
+      plan.forward(data, spectrum);
+      return spectrum;
+    };
+  }
+  Trace test_sac = gen_fake_trace();
+  std::vector<double> data(static_cast<size_t>(test_sac.npts()));
+  random_vector(&data);
+  test_sac.data1(data);
+  BENCHMARK("To Spectral and Back") {
+    Trace trace{test_sac};
+    to_spectral(&trace, iamph);
+    to_time(&trace);
+    return trace;
+  };
+}
+
+TEST_CASE("Filtering") {
+  const filter_spec bandpass{filter_type::bandpass, 4, 0.5, 2.0};
+  Trace test_sac = gen_fake_trace();
+  std::vector<double> data(static_cast<size_t>(test_sac.npts()));
+  random_vector(&data);
+  test_sac.data1(data);
+  const std::vector<Trace> traces(64, test_sac);
+  BENCHMARK("Filter (New Design)") {
+    std::vector<double> result{data};
+    const iir_filter design{bandpass, test_sac.delta()};
+    design.apply(result, true);
+    return result;
+  };
+  BENCHMARK("Filter (Cached Design)") {
+    Trace trace{test_sac};
+    filter(&trace, bandpass, true);
+    return trace;
+  };
+  BENCHMARK("Filter 64 Traces (One by One)") {
+    std::vector<Trace> result{traces};
+    for (Trace &trace : result) {
+      filter(&trace, bandpass, true);
+    }
+    return result;
+  };
+  BENCHMARK("Filter 64 Traces (Batched)") {
+    std::vector<Trace> result{traces};
+    filter(result, bandpass, true);
+    return result;
+  };
+}
+
+TEST_CASE("Resampling") {
+  Trace test_sac = gen_fake_trace();
+  std::vector<double> data(static_cast<size_t>(test_sac.npts()));
+  random_vector(&data);
+  test_sac.data1(data);
+  test_sac.delta(0.005);
+  BENCHMARK("Resampler Design (2/5)") { return resampler{2, 5}; };
+  BENCHMARK("Decimate 200 Hz to 40 Hz") {
+    Trace trace{test_sac};
+    decimate(&trace, 5);
+    return trace;
+  };
+  test_sac.delta(0.01);
+  BENCHMARK("Resample 100 Hz to 40 Hz") {
+    Trace trace{test_sac};
+    resample(&trace, 0.025);
+    return trace;
+  };
+  test_sac.delta(0.025);
+  BENCHMARK("Resample 40 Hz to 100 Hz") {
+    Trace trace{test_sac};
+    resample(&trace, 0.01);
+    return trace;
+  };
+}
+
+TEST_CASE("Even Sampling") {
+  constexpr size_t size{100000};
+  std::vector<double> x(size);
+  std::vector<double> y(size);
+  random_vector(&y);
+  for (size_t i{0}; i < size; ++i) {
+    x[i] = static_cast<double>(i) + (0.25 * std::sin(static_cast<double>(i)));
+  }
+  Trace test_sac{};
+  test_sac.leven(false);
+  test_sac.data1(y);
+  test_sac.data2(x);
+  for (const auto &[method, label] :
+       std::vector<std::pair<interpolation, std::string>>{
+           {interpolation::linear, "Linear"},
+           {interpolation::akima, "Akima"}}) {
+    BENCHMARK("To Even (" + label + ")") {
+      Trace trace{test_sac};
+      to_even(&trace, 0.5, method);
+      return trace;
+    };
+  }
+}
+
+TEST_CASE("Cross-Correlation") {
+  std::vector<double> data(100000);
+  random_vector(&data);
+  std::vector<std::vector<double>> templates(16, std::vector<double>(400));
+  for (std::vector<double> &samples : templates) {
+    random_vector(&samples);
+  }
+  const template_bank bank{templates};
+  BENCHMARK("Direct (1 Template)") {
+    const std::vector<double> &pattern{templates[0]};
+    std::vector<double> result(data.size() - pattern.size() + 1);
+    for (size_t lag{0}; lag < result.size(); ++lag) {
+      result[lag] = dot_product(
+          pattern, std::span<const double>{data}.subspan(lag, pattern.size()));
+    }
+    return result;
+  };
+  BENCHMARK("Template Bank (16 Templates)") { return bank.correlate(data); };
+  const std::vector<std::span<const double>> traces(8, data);
+  BENCHMARK("Template Bank (16 Templates, 8 Traces, 1 Thread)") {
+    return correlate(bank, traces, 1);
+  };
+  BENCHMARK("Template Bank (16 Templates, 8 Traces, All Threads)") {
+    return correlate(bank, traces);
+  };
+}
+
+TEST_CASE("STA/LTA") {
+  // 2000 channels, 10 s of 100 Hz data per chunk (interleaved)
+  constexpr size_t channels{2000};
+  constexpr size_t samples{1000};
+  std::vector<double> chunk(channels * samples);
+  random_vector(&chunk);
+  std::vector<double> ratio(chunk.size());
+  for (const sta_lta_method method :
+       {sta_lta_method::classic, sta_lta_method::recursive}) {
+    const std::string label{method == sta_lta_method::classic ? "Classic"
+                                                              : "Recursive"};
+    std::vector<sta_lta> singles(channels, sta_lta{100, 1000, method});
+    std::vector<double> channel_data(samples);
+    std::vector<double> channel_ratio(samples);
+    BENCHMARK("STA/LTA " + label + " (2000 Channels, One by One)") {
+      for (size_t channel{0}; channel < channels; ++channel) {
+        for (size_t i{0}; i < samples; ++i) {
+          channel_data[i] = chunk[(i * channels) + channel];
+        }
+        singles[channel].process(channel_data, channel_ratio);
+      }
+      return channel_ratio[0];
+    };
+    sta_lta bank{100, 1000, method, channels};
+    BENCHMARK("STA/LTA " + label + " (2000 Channels, Interleaved)") {
+      bank.process(chunk, ratio);
+      return ratio[0];
+    };
+  }
+}
+
+TEST_CASE("Coincidence") {
+  // 50000 triggers from 500 stations in one hour
+  constexpr size_t n_triggers{50000};
+  std::vector<double> onsets(n_triggers);
+  random_vector(&onsets);
+  std::vector<timed_trigger> triggers(n_triggers);
+  for (size_t i{0}; i < n_triggers; ++i) {
+    const std::string station{"XX.S" + std::to_string(i % 500)};
+    const double onset{1800.0 * (1.0 + onsets[i])};
+    triggers[i] = {station, station + ".HHZ", onset, onset + 2.0};
+  }
+  const coincidence_spec spec{20.0, 5.0, {}};
+  BENCHMARK("Coincidence (50000 Triggers)") {
+    return coincidence(triggers, spec);
+  };
+}
+
+TEST_CASE("Envelope") {
+  // 64 traces, 10 minutes of 100 Hz data each
+  constexpr size_t n_traces{64};
+  constexpr size_t samples{60000};
+  std::vector<Trace> traces(n_traces, gen_fake_trace());
+  for (Trace &trace : traces) {
+    std::vector<double> data(samples);
+    random_vector(&data);
+    trace.data1(data);
+  }
+  BENCHMARK("Envelope (64 Traces, One by One)") {
+    std::vector<Trace> copies{traces};
+    for (Trace &trace : copies) {
+      envelope(&trace);
+    }
+    return copies;
+  };
+  BENCHMARK("Envelope (64 Traces, Batched)") {
+    std::vector<Trace> copies{traces};
+    envelope(copies);
+    return copies;
+  };
+}
+
+TEST_CASE("Instrument Response") {
+  // One hour of 100 Hz data (typical broadband response)
+  constexpr size_t samples{360000};
+  const pole_zero pz{{{0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}},
+                     {{-0.037, 0.037},
+                      {-0.037, -0.037},
+                      {-251.3, 0.0},
+                      {-131.0, 467.3},
+                      {-131.0, -467.3}},
+                     3.948580e+17};
+  Trace trace{gen_fake_trace()};
+  std::vector<double> data(samples);
+  random_vector(&data);
+  trace.data1(data);
+  const response_prefilter prefilter{0.005, 0.01, 20.0, 40.0};
+  const size_t n_fft{next_fast_size(samples)};
+  BENCHMARK("Response Evaluation (1 Hour)") {
+    return response_plan{pz,    n_fft, trace.delta(), prefilter,
+                         idisp, default_water_level};
+  };
+  BENCHMARK("Remove Response (1 Hour, Cached)") {
+    Trace copy{trace};
+    remove_response(&copy, pz, prefilter);
+    return copy;
+  };
+}
+
+TEST_CASE("Merge") {
+  // One day of 100 Hz data in 48 half-hour pieces (with 1 s overlaps)
+  constexpr size_t n_pieces{48};
+  constexpr size_t samples{180000};
+  std::vector<Trace> pieces(n_pieces, gen_fake_trace());
+  for (size_t i{0}; i < n_pieces; ++i) {
+    std::vector<double> data(samples + 100);
+    random_vector(&data);
+    pieces[i].delta(0.01);
+    pieces[i].b(static_cast<double>(i) * 1800.0);
+    pieces[i].data1(data);
+  }
+  BENCHMARK("Merge (48 Pieces, 1 Day)") { return merge(pieces); };
+  BENCHMARK("Merge (48 Pieces, 1 Day, Average)") {
+    return merge(pieces, {overlap_policy::average, gap_policy::split});
+  };
+}
+
+TEST_CASE("Rotation") {
+  // One hour of 100 Hz three-component data
+  constexpr size_t samples{360000};
+  std::array<Trace, 3> traces{gen_fake_trace(), gen_fake_trace(),
+                              gen_fake_trace()};
+  const std::array<std::array<float, 2>, 3> orientations{
+      {{0.0F, 0.0F}, {0.0F, 90.0F}, {90.0F, 90.0F}}};
+  for (size_t i{0}; i < traces.size(); ++i) {
+    std::vector<double> data(samples);
+    random_vector(&data);
+    traces[i].data1(data);
+    traces[i].baz(30.0F);
+    traces[i].cmpaz(orientations[i][0]);
+    traces[i].cmpinc(orientations[i][1]);
+  }
+  BENCHMARK("Rotate to RT (1 Hour)") {
+    std::array<Trace, 2> copies{traces[1], traces[2]};
+    rotate_to_rt(&copies[0], &copies[1]);
+    return copies;
+  };
+  BENCHMARK("Rotate to LQT (1 Hour)") {
+    std::array<Trace, 3> copies{traces};
+    rotate_to_lqt(&copies[0], &copies[1], &copies[2], 20.0);
+    return copies;
+  };
+}
+
+TEST_CASE("Integration and Differentiation") {
+  // One hour of 100 Hz data
+  Trace trace{gen_fake_trace()};
+  std::vector<double> data(360000);
+  random_vector(&data);
+  trace.data1(data);
+  BENCHMARK("Integrate (1 Hour, Trapezoid)") {
+    return integrate(data, 0.01, integration_method::trapezoid);
+  };
+  BENCHMARK("Differentiate (1 Hour, Central)") {
+    return differentiate(data, 0.01, difference_method::central);
+  };
+  BENCHMARK("Differentiate (1 Hour, Five-Point)") {
+    return differentiate(data, 0.01, difference_method::five_point);
+  };
+}
+
+TEST_CASE("Spectrogram") {
+  // 64 channels, 10 minutes of 100 Hz data
+  constexpr size_t n_traces{64};
+  constexpr size_t window{256};
+  std::vector<Trace> traces(n_traces, gen_fake_trace());
+  for (Trace &trace : traces) {
+    std::vector<double> data(60000);
+    random_vector(&data);
+    trace.delta(0.01);
+    trace.data1(data);
+  }
+  BENCHMARK("Spectrogram (64 Traces, Frame by Frame)") {
+    std::vector<std::vector<double>> result(n_traces);
+    for (size_t i{0}; i < n_traces; ++i) {
+      const std::span<const double> data{traces[i].data1_view()};
+      for (size_t start{0}; start + window <= data.size(); start += 128) {
+        const auto offset{static_cast<std::ptrdiff_t>(start)};
+        std::vector<double> frame(
+            data.begin() + offset,
+            data.begin() + offset + static_cast<std::ptrdiff_t>(window));
+        taper(frame, 0.5);
+        for (const complex value : rfft(frame)) {
+          result[i].push_back(std::norm(value));
+        }
+      }
+    }
+    return result;
+  };
+  BENCHMARK("Spectrogram (64 Traces, 1 Thread)") {
+    return spectrogram(traces, window, 128, 0, taper_window::hann, 1);
+  };
+  BENCHMARK("Spectrogram (64 Traces, All Threads)") {
+    return spectrogram(traces, window, 128);
+  };
+}
+
+TEST_CASE("Stacking") {
+  // 2000 traces of 2000 samples, aligned on a
+  constexpr size_t n_traces{2000};
+  std::vector<Trace> traces(n_traces, gen_fake_trace());
+  for (size_t i{0}; i < n_traces; ++i) {
+    std::vector<double> data(2000);
+    random_vector(&data);
+    traces[i].data1(data);
+    traces[i].a(traces[i].b() + (0.025 * static_cast<double>(500 + (i % 7))));
+  }
+  for (const stack_method method :
+       {stack_method::linear, stack_method::nth_root,
+        stack_method::phase_weighted}) {
+    const std::string label{
+        method == stack_method::linear
+            ? "Linear"
+            : (method == stack_method::nth_root ? "Nth-Root"
+                                                : "Phase-Weighted")};
+    const stack_spec spec{1200, 0.025, -10.0, method, 2.0};
+    BENCHMARK("Stack " + label + " (2000 Traces, 1 Thread)") {
+      return stack(traces, time_marker::a, spec, 1).result();
+    };
+    BENCHMARK("Stack " + label + " (2000 Traces, All Threads)") {
+      return stack(traces, time_marker::a, spec).result();
+    };
+  }
+}
+
+TEST_CASE("Array Processing") {
+  // 10-station small-aperture array, 4 s windows of 100 Hz data
+  constexpr size_t n_stations{10};
+  std::vector<Trace> traces(n_stations, gen_fake_trace());
+  std::vector<double> offsets(2 * n_stations);
+  random_vector(&offsets);
+  for (size_t j{0}; j < n_stations; ++j) {
+    std::vector<double> data(6000);
+    random_vector(&data);
+    traces[j].delta(0.01);
+    traces[j].stla(40.0 + (0.01 * offsets[2 * j]));
+    traces[j].stlo(-110.0 + (0.01 * offsets[(2 * j) + 1]));
+    traces[j].data1(data);
+  }
+  const array_geometry geometry{array_coordinates(traces)};
+  BENCHMARK("F-K Plan (101x101 Grid)") {
+    return fk_plan{geometry, {0.5, 101}, 400, 0.01, 1.0, 10.0};
+  };
+  const fk_plan plan{geometry, {0.5, 101}, 400, 0.01, 1.0, 10.0};
+  BENCHMARK("F-K Power (101x101 Grid, 4 s Window, 1 Thread)") {
+    return plan.power(traces, 1000, 1);
+  };
+  BENCHMARK("F-K Power (101x101 Grid, 4 s Window, All Threads)") {
+    return plan.power(traces, 1000);
+  };
+  BENCHMARK("Delay and Sum (10 Stations, 1 Minute)") {
+    return delay_and_sum(traces, geometry, 0.2, -0.1);
+  };
+}
+
+TEST_CASE("Amplitude Metrics") {
+  // One day of 100 Hz data, 1 minute windows with 50% overlap
+  std::vector<double> data(8'640'000);
+  random_vector(&data);
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.01);
+  trace.data1(data);
+  BENCHMARK("RMS and Peak (1 Day, 100 Hz, 1 Minute Windows)") {
+    return amplitudes(trace, {6000, 3000});
+  };
+  BENCHMARK("RMS and Peak (1 Day, 100 Hz, 1 s Windows, 0.99 s Overlap)") {
+    return amplitudes(trace, {100, 99});
+  };
+  BENCHMARK("RMS, Peak, and Median (1 Day, 100 Hz, 1 Minute Windows)") {
+    return amplitudes(trace, {6000, 3000, {50.0}});
+  };
+}
+
+TEST_CASE("Level of Detail") {
+  // One day of 100 Hz data (a week is seven times the build)
+  std::vector<double> data(8'640'000);
+  random_vector(&data);
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.01);
+  trace.data1(data);
+  BENCHMARK("Build Pyramid (1 Day, 100 Hz)") { return build_lod(trace); };
+  const lod_pyramid pyramid{build_lod(trace)};
+  BENCHMARK("Envelope (Whole Day, 2000 Pixels)") {
+    return lod_range(pyramid, trace.b(), trace.b() + 86'400.0, 2000);
+  };
+  BENCHMARK("Envelope (1 Hour, 2000 Pixels)") {
+    return lod_range(pyramid, trace.b() + 3600.0, trace.b() + 7200.0, 2000);
+  };
+  BENCHMARK("Write and Read Pyramid (1 Day, 100 Hz)") {
+    std::stringstream stream{};
+    write_lod(pyramid, &stream);
+    return read_lod(&stream);
+  };
+}
+
+TEST_CASE("Time Shifting") {
+  // One hour of 100 Hz data
+  std::vector<double> data(360'000);
+  random_vector(&data);
+  BENCHMARK("Fractional Shift (1 Hour, 100 Hz, Windowed Sinc)") {
+    std::vector<double> shifted{data};
+    fractional_shift(shifted, 0.37, shift_method::sinc);
+    return shifted;
+  };
+  BENCHMARK("Fractional Shift (1 Hour, 100 Hz, FFT)") {
+    std::vector<double> shifted{data};
+    fractional_shift(shifted, 0.37, shift_method::fft);
+    return shifted;
+  };
+  // 100 event windows (1 minute) picked off the sample grid
+  std::vector<Trace> traces(100, gen_fake_trace());
+  for (size_t j{0}; j < traces.size(); ++j) {
+    traces[j].delta(0.01);
+    const auto first{data.begin() + static_cast<std::ptrdiff_t>(j * 3000)};
+    traces[j].data1(std::vector<double>(first, first + 6000));
+    traces[j].a(traces[j].b() + 20.0 + (0.0037 * static_cast<double>(j)));
+  }
+  BENCHMARK("Align on Marker (100 Traces, 1 Minute, 1 Thread)") {
+    std::vector<Trace> copies{traces};
+    align(copies, time_marker::a, shift_method::sinc, 1);
+    return copies;
+  };
+  BENCHMARK("Align on Marker (100 Traces, 1 Minute, All Threads)") {
+    std::vector<Trace> copies{traces};
+    align(copies, time_marker::a);
+    return copies;
+  };
+}
+
+TEST_CASE("Noise Correlation") {
+  // 50 stations (1225 pairs), 30 minute windows of 10 Hz data
+  constexpr size_t n_stations{50};
+  constexpr size_t window{18'000};
+  std::vector<std::vector<double>> data(n_stations,
+                                        std::vector<double>(window));
+  for (std::vector<double> &values : data) {
+    random_vector(&values);
+  }
+  const std::vector<std::span<const double>> windows(data.begin(),
+                                                     data.end());
+  noise_spec spec{};
+  spec.window = window;
+  spec.max_lag = 3000;
+  spec.smoothing = 10;
+  spec.band = {0.02, 0.05, 1.0, 2.0};
+  noise_correlator correlator{n_stations, 0.1, spec};
+  std::vector<complex> spectrum(correlator.bins());
+  BENCHMARK("Noise Spectrum (30 Minutes, 10 Hz, One-Bit, Whitened)") {
+    correlator.spectrum(windows[0], spectrum);
+    return spectrum[0];
+  };
+  BENCHMARK("Noise Window (50 Stations, 1225 Pairs, 1 Thread)") {
+    correlator.add(windows, 1);
+    return correlator.windows();
+  };
+  BENCHMARK("Noise Window (50 Stations, 1225 Pairs, All Threads)") {
+    correlator.add(windows);
+    return correlator.windows();
+  };
+  BENCHMARK("Noise Stack Readout (1225 Pairs)") {
+    double sum{0.0};
+    for (size_t i{0}; i < n_stations; ++i) {
+      for (size_t j{i + 1}; j < n_stations; ++j) {
+        sum += correlator.correlation(i, j)[spec.max_lag];
+      }
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("Welch PSD and PPSD") {
+  // 20 Hz data: 1 hour segments (50% overlap), each the Welch average of 13
+  // 15 minute windows (75% overlap)
+  std::vector<double> data(432'000);
+  random_vector(&data);
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.05);
+  trace.data1(data);
+  Trace hour{trace};
+  hour.data1(std::vector<double>(data.begin(), data.begin() + 72'000));
+  BENCHMARK("Welch PSD (1 Hour, 20 Hz, 13 Windows)") {
+    return psd_welch(hour, 18'000, 13'500);
+  };
+  const spectrogram_plan welch{18'000, 13'500};
+  BENCHMARK("PPSD (6 Hours, 20 Hz, 11 Segments)") {
+    ppsd histogram{};
+    return histogram.add(trace, 72'000, 36'000, welch);
+  };
+  const std::vector<Trace> days(8, trace);
+  BENCHMARK("PPSD (8 Channels, 6 Hours, 20 Hz, All Threads)") {
+    return probabilistic_psd(days, 72'000, 36'000, welch).count();
+  };
+}
+
+TEST_CASE("Phase Picking") {
+  // 2000 event records (2 minutes, 100 Hz), predicted arrival at 60 s
+  std::vector<Trace> traces(2000, gen_fake_trace());
+  std::vector<double> data(12'000);
+  for (Trace &trace : traces) {
+    random_vector(&data);
+    trace.delta(0.01);
+    trace.b(0.0);
+    trace.a(60.0);
+    trace.data1(data);
+  }
+  for (const auto &[label, method] :
+       std::vector<std::pair<std::string, picker_method>>{
+           {"AIC", picker_method::aic},
+           {"Kurtosis", picker_method::kurtosis},
+           {"STA/LTA", picker_method::sta_lta}}) {
+    pick_spec spec{};
+    spec.method = method;
+    BENCHMARK("Pick " + label + " (2000 Traces, 10 s Window, 1 Thread)") {
+      return pick_phases(traces, time_marker::a, spec, 1);
+    };
+    BENCHMARK("Pick " + label + " (2000 Traces, 10 s Window, All Threads)") {
+      return pick_phases(traces, time_marker::a, spec);
+    };
+  }
+}
 }  // namespace sacfmt
 // NOLINTEND(readability-function-cognitive-complexity)
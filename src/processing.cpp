@@ -0,0 +1,6309 @@
+// Copyright 2023-2024 Alexander R. Blanchette
+
+/*!
+  \file processing.cpp
+
+  \brief Implementation of the sac-format signal-processing functions.
+
+  \author Alexander R. Blanchette
+
+  Signal-processing functions operate on data in place (no intermediate
+  copies). Loops are written to be auto-vectorized (independent accumulator
+  lanes, no branches in the bulk of the data). Everything in this file is
+  targeted for testing coverage.
+  */
+
+#include "sac-format/processing.hpp"
+
+// Implementation of the interface in processing.hpp
+namespace sacfmt {
+//-----------------------------------------------------------------------------
+// Kernels
+//-----------------------------------------------------------------------------
+/*!
+  \brief Least-squares line through evenly-spaced data.
+
+  The independent variable is the sample index, centered so that the sums are
+  well-conditioned; \f$\sum (i - c)^2\f$ is known in closed form, so a single
+  pass (::stats_lanes independent lanes) is sufficient.
+
+  @param[in] data std::span<const double> Data vector.
+  @returns linear_fit Least-squares line (zero if data is empty).
+ */
+linear_fit fit_trend(std::span<const double> data) noexcept {
+  linear_fit result{};
+  const size_t size{data.size()};
+  if (size == 0) {
+    return result;
+  }
+  const auto count{static_cast<double>(size)};
+  result.center = (count - 1.0) / 2.0;
+  std::array<double, stats_lanes> sums{};
+  std::array<double, stats_lanes> products{};
+  size_t pos{0};
+  for (; pos + stats_lanes <= size; pos += stats_lanes) [[likely]] {
+    for (size_t lane{0}; lane < stats_lanes; ++lane) {
+      const double value{data[pos + lane]};
+      const double x_value{static_cast<double>(pos + lane) - result.center};
+      sums[lane] += value;
+      products[lane] += x_value * value;
+    }
+  }
+  for (size_t lane{0}; pos < size; ++pos, ++lane) {
+    const double value{data[pos]};
+    sums[lane] += value;
+    products[lane] += (static_cast<double>(pos) - result.center) * value;
+  }
+  double sum{0.0};
+  double product{0.0};
+  for (size_t lane{0}; lane < stats_lanes; ++lane) {
+    sum += sums[lane];
+    product += products[lane];
+  }
+  result.intercept = sum / count;
+  // sum((i - c)^2) = n(n^2 - 1)/12
+  const double x_squares{count * ((count * count) - 1.0) / 12.0};
+  result.slope = (x_squares > 0.0 ? product / x_squares : 0.0);
+  return result;
+}
+
+/*!
+  \brief Least-squares line through data with independent variable x.
+
+  Two passes (means, then centered sums). Only the common length of data and x
+  is used.
+
+  @param[in] data std::span<const double> Data vector (dependent variable).
+  @param[in] x std::span<const double> Independent variable.
+  @returns linear_fit Least-squares line (zero if data is empty).
+ */
+linear_fit fit_trend(std::span<const double> data,
+                     std::span<const double> x) noexcept {
+  linear_fit result{};
+  const size_t size{std::min(data.size(), x.size())};
+  if (size == 0) {
+    return result;
+  }
+  const auto count{static_cast<double>(size)};
+  std::array<double, stats_lanes> x_sums{};
+  std::array<double, stats_lanes> y_sums{};
+  for (size_t i{0}; i < size; ++i) {
+    x_sums[i % stats_lanes] += x[i];
+    y_sums[i % stats_lanes] += data[i];
+  }
+  double x_sum{0.0};
+  double y_sum{0.0};
+  for (size_t lane{0}; lane < stats_lanes; ++lane) {
+    x_sum += x_sums[lane];
+    y_sum += y_sums[lane];
+  }
+  result.center = x_sum / count;
+  result.intercept = y_sum / count;
+  std::array<double, stats_lanes> products{};
+  std::array<double, stats_lanes> squares{};
+  for (size_t i{0}; i < size; ++i) {
+    const double x_value{x[i] - result.center};
+    products[i % stats_lanes] += x_value * data[i];
+    squares[i % stats_lanes] += x_value * x_value;
+  }
+  double product{0.0};
+  double square{0.0};
+  for (size_t lane{0}; lane < stats_lanes; ++lane) {
+    product += products[lane];
+    square += squares[lane];
+  }
+  result.slope = (square > 0.0 ? product / square : 0.0);
+  return result;
+}
+
+/*!
+  \brief Number of samples tapered at each end.
+
+  @param[in] size size_t Number of samples.
+  @param[in] width double Fraction of the data tapered at each end (clamped to
+  [0, ::max_taper_width]).
+  @returns size_t Number of samples tapered at each end.
+ */
+size_t taper_length(const size_t size, const double width) noexcept {
+  const double clamped{std::clamp(width, 0.0, max_taper_width)};
+  return std::min(
+      size / 2,
+      static_cast<size_t>(std::round(clamped * static_cast<double>(size))));
+}
+
+/*!
+  \brief Subtract a line and taper the ends in a single pass.
+
+  Each sample is read and written once (the middle is skipped entirely when
+  there is no line to remove). Taper weights are generated by a rotation
+  recurrence (no trigonometric calls per sample) and applied to the head and
+  tail together; the untapered middle is a branch-free loop.
+
+  @param[in,out] data std::span<double> Data vector (modified in place).
+  @param[in] fit linear_fit Line to subtract (default-constructed = none).
+  @param[in] x std::span<const double> Independent variable (empty = sample
+  index). Must be at least as long as data if not empty.
+  @param[in] n_taper size_t Number of samples to taper at each end (see
+  taper_length).
+  @param[in] window taper_window Taper shape.
+ */
+void remove_fit(std::span<double> data, const linear_fit &fit,
+                std::span<const double> x, const size_t n_taper,
+                const taper_window window) noexcept {
+  const size_t size{data.size()};
+  if (size == 0) {
+    return;
+  }
+  const bool indexed{x.empty()};
+  // Line value at sample i
+  const auto line = [&fit, &x, indexed](const size_t index) {
+    const double x_value{indexed ? static_cast<double>(index) : x[index]};
+    return fit.intercept + (fit.slope * (x_value - fit.center));
+  };
+  const size_t n_ends{std::min(n_taper, size / 2)};
+  // Middle (untapered, skipped if there is no line to remove)
+  const size_t last{size - n_ends};
+  const bool has_line{(fit.intercept != 0.0) || (fit.slope != 0.0)};
+  if (has_line && indexed) {
+    for (size_t i{n_ends}; i < last; ++i) [[likely]] {
+      data[i] -= fit.intercept +
+                 (fit.slope * (static_cast<double>(i) - fit.center));
+    }
+  } else if (has_line) {
+    for (size_t i{n_ends}; i < last; ++i) [[likely]] {
+      data[i] -= fit.intercept + (fit.slope * (x[i] - fit.center));
+    }
+  }
+  if (n_ends == 0) {
+    return;
+  }
+  // Ends
+  const bool sine{window == taper_window::cosine};
+  const double offset{window == taper_window::hamming ? 0.54 : 0.5};
+  const double scale{1.0 - offset};
+  const double angle{std::numbers::pi_v<double> /
+                     (static_cast<double>(n_ends) * (sine ? 2.0 : 1.0))};
+  const double step_cos{std::cos(angle)};
+  const double step_sin{std::sin(angle)};
+  double cos_value{1.0};
+  double sin_value{0.0};
+  for (size_t j{0}; j < n_ends; ++j) {
+    const double weight{sine ? sin_value : offset - (scale * cos_value)};
+    const size_t tail{size - 1 - j};
+    data[j] = (data[j] - line(j)) * weight;
+    data[tail] = (data[tail] - line(tail)) * weight;
+    const double next_cos{(cos_value * step_cos) - (sin_value * step_sin)};
+    sin_value = (sin_value * step_cos) + (cos_value * step_sin);
+    cos_value = next_cos;
+  }
+}
+/*!
+  \brief Dot product (equal sizes).
+
+  Accumulates ::dot_lanes partial sums so consecutive additions are
+  independent (vectorizable without reassociating the floating-point sum).
+
+  @param[in] lhs std::span<const double> First vector.
+  @param[in] rhs std::span<const double> Second vector (same size).
+  @returns double Sum of the element-wise products.
+ */
+double dot_product(std::span<const double> lhs,
+                   std::span<const double> rhs) noexcept {
+  const size_t size{std::min(lhs.size(), rhs.size())};
+  std::array<double, dot_lanes> sums{};
+  const size_t bulk{size - (size % dot_lanes)};
+  for (size_t i{0}; i < bulk; i += dot_lanes) {
+    for (size_t lane{0}; lane < dot_lanes; ++lane) {
+      sums[lane] += lhs[i + lane] * rhs[i + lane];
+    }
+  }
+  double result{0.0};
+  for (size_t i{bulk}; i < size; ++i) {
+    result += lhs[i] * rhs[i];
+  }
+  for (const double sum : sums) {
+    result += sum;
+  }
+  return result;
+}
+
+/*!
+  \brief Require an evenly-sampled time-series Trace with a positive delta.
+
+  @param[in] trace Trace Trace to check.
+  @throw processing_error If the Trace is spectral/x-y, unevenly-sampled, or
+  delta is not positive.
+ */
+void check_time_series(const Trace &trace) {
+  if (((trace.iftype() != itime) && (trace.iftype() != unset_int)) ||
+      !trace.leven()) {
+    throw processing_error("Trace is not an evenly-sampled time-series.");
+  }
+  if (trace.delta() <= 0.0) {
+    throw processing_error("Trace does not have a positive delta.");
+  }
+}
+
+/*!
+  \brief Run task(0) ... task(count - 1) on a pool of threads.
+
+  Workers take the next index from a shared counter until none are left, so
+  uneven tasks balance themselves. If a task throws, no new tasks are started
+  and the first exception is rethrown once the workers are done.
+
+  @param[in] count size_t Number of tasks.
+  @param[in] task std::function<void(size_t)> Task (called once per index,
+  concurrently; must be safe to run in parallel).
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw Any exception thrown by a task.
+ */
+void parallel_for(const size_t count, const std::function<void(size_t)> &task,
+                  const size_t threads) {
+  size_t n_threads{threads == 0 ? std::thread::hardware_concurrency()
+                                : threads};
+  n_threads = std::max(size_t{1}, std::min(n_threads, count));
+  if (n_threads <= 1) {
+    for (size_t i{0}; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error{};
+  std::mutex error_mutex{};
+  const auto worker = [&]() {
+    for (size_t i{next++}; (i < count) && !failed; i = next++) {
+      try {
+        task(i);
+      } catch (...) {
+        const std::scoped_lock lock{error_mutex};
+        if (!failed.exchange(true)) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+  std::vector<std::thread> pool{};
+  pool.reserve(n_threads - 1);
+  for (size_t i{1}; i < n_threads; ++i) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+//-----------------------------------------------------------------------------
+// Preprocessing
+//-----------------------------------------------------------------------------
+/*!
+  \brief Remove the mean (in place).
+
+  @param[in,out] data std::span<double> Data vector.
+ */
+void rmean(std::span<double> data) noexcept {
+  remove_fit(data, {compute_stats(data).mean, 0.0, 0.0});
+}
+
+/*!
+  \brief Remove the mean of data1 (in place).
+
+  depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Trace to modify.
+ */
+void rmean(Trace *trace) noexcept {
+  rmean(trace->data1_view());
+  trace->update_stats();
+}
+
+/*!
+  \brief Remove the least-squares linear trend of evenly-spaced data (in
+  place).
+
+  @param[in,out] data std::span<double> Data vector.
+ */
+void rtrend(std::span<double> data) noexcept {
+  remove_fit(data, fit_trend(data));
+}
+
+/*!
+  \brief Remove the least-squares linear trend (in place).
+
+  @param[in,out] data std::span<double> Data vector.
+  @param[in] x std::span<const double> Independent variable (same length as
+  data).
+ */
+void rtrend(std::span<double> data, std::span<const double> x) noexcept {
+  if (x.size() < data.size()) {
+    return;
+  }
+  remove_fit(data, fit_trend(data, x), x);
+}
+
+/*!
+  \brief Remove the least-squares linear trend of data1 (in place).
+
+  Unevenly-spaced Traces (leven false) use data2 as the independent variable.
+  depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Trace to modify.
+ */
+void rtrend(Trace *trace) noexcept {
+  if (trace->leven()) {
+    rtrend(trace->data1_view());
+  } else {
+    rtrend(trace->data1_view(), trace->data2_view());
+  }
+  trace->update_stats();
+}
+
+/*!
+  \brief Taper both ends (in place).
+
+  @param[in,out] data std::span<double> Data vector.
+  @param[in] width double Fraction of the data tapered at each end.
+  @param[in] window taper_window Taper shape.
+ */
+void taper(std::span<double> data, const double width,
+           const taper_window window) noexcept {
+  // No line to remove, only the ends are touched
+  remove_fit(data, {}, {}, taper_length(data.size(), width), window);
+}
+
+/*!
+  \brief Taper both ends of data1 (in place).
+
+  depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Trace to modify.
+  @param[in] width double Fraction of the data tapered at each end.
+  @param[in] window taper_window Taper shape.
+ */
+void taper(Trace *trace, const double width,
+           const taper_window window) noexcept {
+  taper(trace->data1_view(), width, window);
+  trace->update_stats();
+}
+
+/*!
+  \brief Remove mean and trend, then taper, in one fused operation (in place).
+
+  Equivalent to rmean, rtrend, and taper in sequence (removing the trend also
+  removes the mean), but reads the data twice (fit, then apply) and writes it
+  once.
+
+  @param[in,out] data std::span<double> Data vector.
+  @param[in] width double Fraction of the data tapered at each end.
+  @param[in] window taper_window Taper shape.
+ */
+void preprocess(std::span<double> data, const double width,
+                const taper_window window) noexcept {
+  remove_fit(data, fit_trend(data), {}, taper_length(data.size(), width),
+             window);
+}
+
+/*!
+  \brief Remove mean and trend, then taper, data1 (in place).
+
+  Unevenly-spaced Traces (leven false) use data2 as the independent variable
+  for the trend. depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Trace to modify.
+  @param[in] width double Fraction of the data tapered at each end.
+  @param[in] window taper_window Taper shape.
+ */
+void preprocess(Trace *trace, const double width,
+                const taper_window window) noexcept {
+  const std::span<double> data{trace->data1_view()};
+  const size_t n_taper{taper_length(data.size(), width)};
+  if (trace->leven()) {
+    remove_fit(data, fit_trend(data), {}, n_taper, window);
+  } else {
+    const std::span<const double> x{trace->data2_view()};
+    if (x.size() < data.size()) {
+      taper(data, width, window);
+    } else {
+      remove_fit(data, fit_trend(data, x), x, n_taper, window);
+    }
+  }
+  trace->update_stats();
+}
+//-----------------------------------------------------------------------------
+// Fourier Transform
+//-----------------------------------------------------------------------------
+std::unordered_map<size_t, std::shared_ptr<const fft_plan>> fft_plan::cache{};
+std::deque<size_t> fft_plan::cache_order{};
+std::mutex fft_plan::cache_mutex{};
+std::unordered_map<size_t, std::shared_ptr<const rfft_plan>>
+    rfft_plan::cache{};
+std::deque<size_t> rfft_plan::cache_order{};
+std::mutex rfft_plan::cache_mutex{};
+
+/*!
+  \brief Complex multiplication.
+
+  Unlike std::complex operator*, no special handling of infinities/NaN is
+  done, which keeps the butterflies branch-free.
+
+  @param[in] val1 complex First value.
+  @param[in] val2 complex Second value.
+  @returns complex Product.
+ */
+complex complex_multiply(const complex val1, const complex val2) noexcept {
+  return {(val1.real() * val2.real()) - (val1.imag() * val2.imag()),
+          (val1.real() * val2.imag()) + (val1.imag() * val2.real())};
+}
+
+/*!
+  \brief Smallest size >= input with no prime factors other than 2, 3, and 5.
+
+  Such sizes are transformed with the specialized butterflies only.
+
+  @param[in] size size_t Minimum size.
+  @returns size_t Fast transform size (at least 1).
+ */
+size_t next_fast_size(const size_t size) noexcept {
+  for (size_t candidate{std::max(size, static_cast<size_t>(1))};;
+       ++candidate) {
+    size_t rest{candidate};
+    for (const size_t factor : std::array<size_t, 3>{2, 3, 5}) {
+      while (rest % factor == 0) {
+        rest /= factor;
+      }
+    }
+    if (rest == 1) {
+      return candidate;
+    }
+  }
+}
+
+/*!
+  \brief Build a complex FFT plan.
+
+  @param[in] size size_t Transform size.
+ */
+fft_plan::fft_plan(const size_t size) : n{size} {
+  size_t rest{size};
+  for (const size_t radix : std::array<size_t, 3>{2, 3, 5}) {
+    while ((rest > 1) && (rest % radix == 0)) {
+      rest /= radix;
+    }
+  }
+  size_t largest{1};
+  for (size_t factor{7}; factor * factor <= rest; factor += 2) {
+    while (rest % factor == 0) {
+      largest = factor;
+      rest /= factor;
+    }
+  }
+  largest = std::max(largest, rest);
+  if (largest > max_direct_radix) {
+    // Bluestein: X_k = w_k sum_j (x_j w_j) conj(w_(k-j)), w_k = e^(-i pi k^2/n)
+    const size_t padded{next_fast_size((2 * size) - 1)};
+    convolution = fft_plan::get(padded);
+    chirp.resize(size);
+    for (size_t k{0}; k < size; ++k) {
+      const auto phase{static_cast<double>((k * k) % (2 * size))};
+      chirp[k] = std::polar(1.0, -std::numbers::pi_v<double> * phase /
+                                     static_cast<double>(size));
+    }
+    chirp_spectrum.assign(padded, complex{});
+    chirp_spectrum[0] = std::conj(chirp[0]);
+    for (size_t k{1}; k < size; ++k) {
+      chirp_spectrum[k] = std::conj(chirp[k]);
+      chirp_spectrum[padded - k] = std::conj(chirp[k]);
+    }
+    convolution->forward(chirp_spectrum);
+    return;
+  }
+  size_t length{size};
+  const auto add_stage = [this, &length](const size_t radix) {
+    stage current{radix, length, {}, {}};
+    const size_t butterflies{length / radix};
+    const double angle{-2.0 * std::numbers::pi_v<double> /
+                       static_cast<double>(length)};
+    current.twiddles.resize(butterflies * (radix - 1));
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      for (size_t term{1}; term < radix; ++term) {
+        current.twiddles[(pos * (radix - 1)) + term - 1] = std::polar(
+            1.0, angle * static_cast<double>((pos * term) % length));
+      }
+    }
+    if (radix > 5) {
+      current.roots.resize(radix);
+      for (size_t term{0}; term < radix; ++term) {
+        current.roots[term] =
+            std::polar(1.0, -2.0 * std::numbers::pi_v<double> *
+                                static_cast<double>(term) /
+                                static_cast<double>(radix));
+      }
+    }
+    stages.push_back(std::move(current));
+    length = butterflies;
+  };
+  rest = size;
+  for (const size_t radix : std::array<size_t, 4>{4, 2, 3, 5}) {
+    while ((rest > 1) && (rest % radix == 0)) {
+      add_stage(radix);
+      rest /= radix;
+    }
+  }
+  for (size_t factor{7}; factor * factor <= rest; factor += 2) {
+    while (rest % factor == 0) {
+      add_stage(factor);
+      rest /= factor;
+    }
+  }
+  if (rest > 1) {
+    add_stage(rest);
+  }
+}
+
+/*!
+  \brief Transform size.
+
+  @returns size_t Transform size.
+ */
+size_t fft_plan::size() const noexcept { return n; }
+
+/*!
+  \brief One radix pass of the Stockham autosort transform.
+
+  Input element (q, p + r m) is combined over r (radix butterfly), multiplied
+  by its twiddle, and stored at (q, r + radix p), where q < stride and
+  m = length/radix. The innermost loop runs over q (unit stride).
+
+  @param[in] current stage Radix pass.
+  @param[in] stride size_t Number of interleaved sub-transforms.
+  @param[in] input complex* Input buffer (size n).
+  @param[out] output complex* Output buffer (size n).
+ */
+void fft_plan::pass(const stage &current, const size_t stride,
+                    const complex *input, complex *output) const {
+  const size_t radix{current.radix};
+  const size_t butterflies{current.length / radix};
+  const size_t in_step{stride * butterflies};
+  const complex *twiddles{current.twiddles.data()};
+  // Multiply by -i
+  const auto rotate = [](const complex value) {
+    return complex{value.imag(), -value.real()};
+  };
+  switch (radix) {
+  case 2:
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      const complex tw1{twiddles[pos]};
+      const complex *in{input + (stride * pos)};
+      complex *out{output + (stride * radix * pos)};
+      for (size_t q{0}; q < stride; ++q) {
+        const complex a0{in[q]};
+        const complex a1{in[q + in_step]};
+        out[q] = a0 + a1;
+        out[q + stride] = complex_multiply(a0 - a1, tw1);
+      }
+    }
+    break;
+  case 3: {
+    const double sin60{std::sqrt(3.0) / 2.0};
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      const complex tw1{twiddles[2 * pos]};
+      const complex tw2{twiddles[(2 * pos) + 1]};
+      const complex *in{input + (stride * pos)};
+      complex *out{output + (stride * radix * pos)};
+      for (size_t q{0}; q < stride; ++q) {
+        const complex a0{in[q]};
+        const complex a1{in[q + in_step]};
+        const complex a2{in[q + (2 * in_step)]};
+        const complex sum{a1 + a2};
+        const complex half{a0 - (0.5 * sum)};
+        const complex diff{rotate(sin60 * (a1 - a2))};
+        out[q] = a0 + sum;
+        out[q + stride] = complex_multiply(half + diff, tw1);
+        out[q + (2 * stride)] = complex_multiply(half - diff, tw2);
+      }
+    }
+    break;
+  }
+  case 4:
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      const complex tw1{twiddles[3 * pos]};
+      const complex tw2{twiddles[(3 * pos) + 1]};
+      const complex tw3{twiddles[(3 * pos) + 2]};
+      const complex *in{input + (stride * pos)};
+      complex *out{output + (stride * radix * pos)};
+      for (size_t q{0}; q < stride; ++q) {
+        const complex a0{in[q]};
+        const complex a1{in[q + in_step]};
+        const complex a2{in[q + (2 * in_step)]};
+        const complex a3{in[q + (3 * in_step)]};
+        const complex t0{a0 + a2};
+        const complex t1{a0 - a2};
+        const complex t2{a1 + a3};
+        const complex t3{rotate(a1 - a3)};
+        out[q] = t0 + t2;
+        out[q + stride] = complex_multiply(t1 + t3, tw1);
+        out[q + (2 * stride)] = complex_multiply(t0 - t2, tw2);
+        out[q + (3 * stride)] = complex_multiply(t1 - t3, tw3);
+      }
+    }
+    break;
+  case 5: {
+    const double angle{2.0 * std::numbers::pi_v<double> / 5.0};
+    const double cos1{std::cos(angle)};
+    const double cos2{std::cos(2.0 * angle)};
+    const double sin1{std::sin(angle)};
+    const double sin2{std::sin(2.0 * angle)};
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      const complex *tw{twiddles + (4 * pos)};
+      const complex *in{input + (stride * pos)};
+      complex *out{output + (stride * radix * pos)};
+      for (size_t q{0}; q < stride; ++q) {
+        const complex a0{in[q]};
+        const complex a1{in[q + in_step]};
+        const complex a2{in[q + (2 * in_step)]};
+        const complex a3{in[q + (3 * in_step)]};
+        const complex a4{in[q + (4 * in_step)]};
+        const complex sum14{a1 + a4};
+        const complex diff14{a1 - a4};
+        const complex sum23{a2 + a3};
+        const complex diff23{a2 - a3};
+        const complex real1{a0 + (cos1 * sum14) + (cos2 * sum23)};
+        const complex imag1{rotate((sin1 * diff14) + (sin2 * diff23))};
+        const complex real2{a0 + (cos2 * sum14) + (cos1 * sum23)};
+        const complex imag2{rotate((sin2 * diff14) - (sin1 * diff23))};
+        out[q] = a0 + sum14 + sum23;
+        out[q + stride] = complex_multiply(real1 + imag1, tw[0]);
+        out[q + (2 * stride)] = complex_multiply(real2 + imag2, tw[1]);
+        out[q + (3 * stride)] = complex_multiply(real2 - imag2, tw[2]);
+        out[q + (4 * stride)] = complex_multiply(real1 - imag1, tw[3]);
+      }
+    }
+    break;
+  }
+  default: {
+    // Generic odd prime radix (direct DFT)
+    std::vector<complex> values(radix);
+    for (size_t pos{0}; pos < butterflies; ++pos) {
+      const complex *tw{twiddles + ((radix - 1) * pos)};
+      const complex *in{input + (stride * pos)};
+      complex *out{output + (stride * radix * pos)};
+      for (size_t q{0}; q < stride; ++q) {
+        for (size_t term{0}; term < radix; ++term) {
+          values[term] = in[q + (term * in_step)];
+        }
+        for (size_t term{0}; term < radix; ++term) {
+          complex sum{};
+          for (size_t index{0}; index < radix; ++index) {
+            sum += complex_multiply(values[index],
+                                    current.roots[(index * term) % radix]);
+          }
+          out[q + (term * stride)] =
+              (term == 0 ? sum : complex_multiply(sum, tw[term - 1]));
+        }
+      }
+    }
+    break;
+  }
+  }
+}
+
+/*!
+  \brief Forward transform (in place, unscaled).
+
+  \f$X_k = \sum_j x_j e^{-2\pi i jk/n}\f$
+
+  @param[in,out] data std::span<complex> Data (size must match the plan).
+  @throw processing_error If the data size does not match the plan.
+ */
+void fft_plan::forward(std::span<complex> data) const {
+  if (data.size() != n) {
+    throw processing_error("FFT input size (" + std::to_string(data.size()) +
+                           ") does not match plan size (" + std::to_string(n) +
+                           ").");
+  }
+  if (convolution) {
+    bluestein(data);
+    return;
+  }
+  if (stages.empty()) {
+    return;
+  }
+  // Ping-pong buffer (one per thread, reused)
+  thread_local std::vector<complex> scratch{};
+  if (scratch.size() < n) {
+    scratch.resize(n);
+  }
+  complex *input{data.data()};
+  complex *output{scratch.data()};
+  size_t stride{1};
+  for (const stage &current : stages) {
+    pass(current, stride, input, output);
+    std::swap(input, output);
+    stride *= current.radix;
+  }
+  if (input != data.data()) {
+    std::copy(input, input + n, data.begin());
+  }
+}
+
+/*!
+  \brief Forward transform by Bluestein's algorithm (in place, unscaled).
+
+  @param[in,out] data std::span<complex> Data (size must match the plan).
+ */
+void fft_plan::bluestein(std::span<complex> data) const {
+  const size_t padded{convolution->size()};
+  thread_local std::vector<complex> buffer{};
+  buffer.assign(padded, complex{});
+  for (size_t k{0}; k < n; ++k) {
+    buffer[k] = complex_multiply(data[k], chirp[k]);
+  }
+  const std::span<complex> work{buffer.data(), padded};
+  convolution->forward(work);
+  for (size_t k{0}; k < padded; ++k) {
+    buffer[k] = complex_multiply(buffer[k], chirp_spectrum[k]);
+  }
+  convolution->inverse(work);
+  for (size_t k{0}; k < n; ++k) {
+    data[k] = complex_multiply(buffer[k], chirp[k]);
+  }
+}
+
+/*!
+  \brief Inverse transform (in place, scaled by 1/size).
+
+  @param[in,out] data std::span<complex> Data (size must match the plan).
+  @throw processing_error If the data size does not match the plan.
+ */
+void fft_plan::inverse(std::span<complex> data) const {
+  // ifft(x) = conj(fft(conj(x)))/n
+  std::transform(data.begin(), data.end(), data.begin(),
+                 [](const complex value) { return std::conj(value); });
+  forward(data);
+  const double scale{1.0 / static_cast<double>(std::max(n, size_t{1}))};
+  std::transform(data.begin(), data.end(), data.begin(),
+                 [scale](const complex value) {
+                   return complex{value.real() * scale,
+                                  -value.imag() * scale};
+                 });
+}
+
+/*!
+  \brief Cached plan for size.
+
+  Plans are built once per size and shared (thread-safe). Plans are built
+  outside the lock (a plan may itself need a cached plan). The cache keeps at
+  most ::max_cached_plans plans, evicting the oldest first (plans in use stay
+  valid).
+
+  @param[in] size size_t Transform size.
+  @returns std::shared_ptr<const fft_plan> Plan.
+ */
+std::shared_ptr<const fft_plan> fft_plan::get(const size_t size) {
+  {
+    const std::scoped_lock lock{cache_mutex};
+    const auto found{cache.find(size)};
+    if (found != cache.end()) {
+      return found->second;
+    }
+  }
+  auto plan{std::make_shared<const fft_plan>(size)};
+  const std::scoped_lock lock{cache_mutex};
+  // Keep the first plan if another thread built one meanwhile
+  const auto [found, inserted]{cache.try_emplace(size, std::move(plan))};
+  std::shared_ptr<const fft_plan> result{found->second};
+  if (inserted) {
+    cache_order.push_back(size);
+    while (cache.size() > max_cached_plans) {
+      cache.erase(cache_order.front());
+      cache_order.pop_front();
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Build a real-input FFT plan.
+
+  @param[in] size size_t Transform size.
+ */
+rfft_plan::rfft_plan(const size_t size) : n{size} {
+  if ((n > 0) && (n % 2 == 0)) {
+    const size_t half{n / 2};
+    complex_plan = fft_plan::get(half);
+    twiddles.resize(half + 1);
+    for (size_t k{0}; k <= half; ++k) {
+      twiddles[k] = std::polar(1.0, -2.0 * std::numbers::pi_v<double> *
+                                        static_cast<double>(k) /
+                                        static_cast<double>(n));
+    }
+  } else {
+    complex_plan = fft_plan::get(n);
+  }
+}
+
+/*!
+  \brief Transform size.
+
+  @returns size_t Transform size.
+ */
+size_t rfft_plan::size() const noexcept { return n; }
+
+/*!
+  \brief Number of frequency bins (size/2 + 1).
+
+  @returns size_t Number of bins.
+ */
+size_t rfft_plan::bins() const noexcept { return (n == 0 ? 0 : (n / 2) + 1); }
+
+/*!
+  \brief Forward transform (unscaled).
+
+  Even sizes: samples are packed as \f$z_j = x_{2j} + i x_{2j+1}\f$, transformed
+  at half size, and unpacked in place.
+
+  @param[in] input std::span<const double> Real data (zero-padded/truncated to
+  size).
+  @param[out] output std::span<complex> Spectrum (at least bins() values).
+  @throw processing_error If output is too small.
+ */
+void rfft_plan::forward(std::span<const double> input,
+                        std::span<complex> output) const {
+  if (output.size() < bins()) {
+    throw processing_error("FFT output is too small.");
+  }
+  if (n == 0) {
+    return;
+  }
+  const size_t used{std::min(input.size(), n)};
+  if (n % 2 != 0) {
+    thread_local std::vector<complex> buffer{};
+    buffer.assign(n, complex{});
+    for (size_t i{0}; i < used; ++i) {
+      buffer[i] = complex{input[i], 0.0};
+    }
+    complex_plan->forward(std::span<complex>{buffer.data(), n});
+    std::copy_n(buffer.begin(), bins(), output.begin());
+    return;
+  }
+  const size_t half{n / 2};
+  // Pack
+  for (size_t j{0}; j < half; ++j) {
+    const size_t even{2 * j};
+    output[j] = complex{even < used ? input[even] : 0.0,
+                        even + 1 < used ? input[even + 1] : 0.0};
+  }
+  complex_plan->forward(output.first(half));
+  // Unpack
+  const complex first{output[0]};
+  output[0] = complex{first.real() + first.imag(), 0.0};
+  output[half] = complex{first.real() - first.imag(), 0.0};
+  for (size_t k{1}; k <= half / 2; ++k) {
+    const size_t j{half - k};
+    const complex z_k{output[k]};
+    const complex z_j{output[j]};
+    const complex even{0.5 * (z_k + std::conj(z_j))};
+    const complex diff{0.5 * (z_k - std::conj(z_j))};
+    const complex odd{diff.imag(), -diff.real()};
+    output[k] = even + complex_multiply(twiddles[k], odd);
+    output[j] =
+        std::conj(even) + complex_multiply(twiddles[j], std::conj(odd));
+  }
+}
+
+/*!
+  \brief Inverse transform (scaled by 1/size).
+
+  The spectrum is assumed Hermitian (only the non-negative frequencies are
+  used).
+
+  @param[in] input std::span<const complex> Spectrum (at least bins() values).
+  @param[out] output std::span<double> Real data (at least size values).
+  @throw processing_error If input or output is too small.
+ */
+void rfft_plan::inverse(std::span<const complex> input,
+                        std::span<double> output) const {
+  if ((input.size() < bins()) || (output.size() < n)) {
+    throw processing_error("Inverse FFT input or output is too small.");
+  }
+  if (n == 0) {
+    return;
+  }
+  thread_local std::vector<complex> buffer{};
+  if (n % 2 != 0) {
+    buffer.resize(n);
+    buffer[0] = input[0];
+    for (size_t k{1}; k < bins(); ++k) {
+      buffer[k] = input[k];
+      buffer[n - k] = std::conj(input[k]);
+    }
+    complex_plan->inverse(std::span<complex>{buffer.data(), n});
+    for (size_t i{0}; i < n; ++i) {
+      output[i] = buffer[i].real();
+    }
+    return;
+  }
+  const size_t half{n / 2};
+  buffer.resize(half);
+  for (size_t k{0}; k < half; ++k) {
+    const complex x_k{input[k]};
+    const complex x_j{std::conj(input[half - k])};
+    const complex even{0.5 * (x_k + x_j)};
+    const complex odd{
+        complex_multiply(std::conj(twiddles[k]), 0.5 * (x_k - x_j))};
+    // even + i odd
+    buffer[k] = complex{even.real() - odd.imag(), even.imag() + odd.real()};
+  }
+  complex_plan->inverse(std::span<complex>{buffer.data(), half});
+  for (size_t j{0}; j < half; ++j) {
+    output[2 * j] = buffer[j].real();
+    output[(2 * j) + 1] = buffer[j].imag();
+  }
+}
+
+/*!
+  \brief Cached plan for size.
+
+  The cache keeps at most ::max_cached_plans plans, evicting the oldest first.
+
+  @param[in] size size_t Transform size.
+  @returns std::shared_ptr<const rfft_plan> Plan.
+ */
+std::shared_ptr<const rfft_plan> rfft_plan::get(const size_t size) {
+  {
+    const std::scoped_lock lock{cache_mutex};
+    const auto found{cache.find(size)};
+    if (found != cache.end()) {
+      return found->second;
+    }
+  }
+  auto plan{std::make_shared<const rfft_plan>(size)};
+  const std::scoped_lock lock{cache_mutex};
+  const auto [found, inserted]{cache.try_emplace(size, std::move(plan))};
+  std::shared_ptr<const rfft_plan> result{found->second};
+  if (inserted) {
+    cache_order.push_back(size);
+    while (cache.size() > max_cached_plans) {
+      cache.erase(cache_order.front());
+      cache_order.pop_front();
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Real-to-complex FFT.
+
+  @param[in] data std::span<const double> Real data.
+  @param[in] n_fft size_t Transform size (0 = data size; data is zero-padded
+  or truncated).
+  @returns std::vector<complex> Spectrum (non-negative frequencies, n_fft/2 + 1
+  values, unscaled).
+ */
+std::vector<complex> rfft(std::span<const double> data, const size_t n_fft) {
+  const size_t size{n_fft == 0 ? data.size() : n_fft};
+  const std::shared_ptr<const rfft_plan> plan{rfft_plan::get(size)};
+  std::vector<complex> result(plan->bins());
+  plan->forward(data, result);
+  return result;
+}
+
+/*!
+  \brief Complex-to-real inverse FFT.
+
+  @param[in] spectrum std::span<const complex> Non-negative frequencies (at
+  least n_fft/2 + 1 values).
+  @param[in] n_fft size_t Transform size.
+  @returns std::vector<double> Real data (n_fft values).
+  @throw processing_error If the spectrum is too short.
+ */
+std::vector<double> irfft(std::span<const complex> spectrum,
+                          const size_t n_fft) {
+  const std::shared_ptr<const rfft_plan> plan{rfft_plan::get(n_fft)};
+  std::vector<double> result(n_fft);
+  plan->inverse(spectrum, result);
+  return result;
+}
+
+/*!
+  \brief Convert a time-series Trace to a spectral Trace.
+
+  The data are zero-padded to next_fast_size(npts) and transformed. As in SAC,
+  the full spectrum (npts = transform size, negative frequencies included) is
+  stored: data1/data2 hold real/imaginary (irlim) or amplitude/phase (iamph).
+  The time-domain b, delta, and npts are saved in sb, sdelta, and nsnpts; delta
+  becomes the frequency spacing, b = 0, and e is the last frequency.
+
+  @param[in,out] trace Trace* Time-series Trace to convert.
+  @param[in] type int Spectral file type (irlim or iamph).
+  @throw processing_error If the type is not spectral, or the Trace is not an
+  evenly-sampled time-series with data and a positive delta.
+ */
+void to_spectral(Trace *trace, const int type) {
+  if ((type != irlim) && (type != iamph)) {
+    throw processing_error("Spectral type must be irlim or iamph.");
+  }
+  check_time_series(*trace);
+  const size_t size{trace->data1_view().size()};
+  if (size == 0) {
+    throw processing_error("Trace has no data.");
+  }
+  const size_t n_fft{next_fast_size(size)};
+  const std::vector<complex> spectrum{rfft(trace->data1_view(), n_fft)};
+  std::vector<double> first(n_fft);
+  std::vector<double> second(n_fft);
+  for (size_t k{0}; k < n_fft; ++k) {
+    const complex value{k < spectrum.size() ? spectrum[k]
+                                            : std::conj(spectrum[n_fft - k])};
+    if (type == irlim) {
+      first[k] = value.real();
+      second[k] = value.imag();
+    } else {
+      first[k] = std::abs(value);
+      second[k] = std::arg(value);
+    }
+  }
+  const double time_delta{trace->delta()};
+  trace->sb(trace->b());
+  trace->sdelta(time_delta);
+  trace->nsnpts(static_cast<int>(size));
+  trace->iftype(type);
+  trace->data1(std::move(first));
+  trace->data2(std::move(second));
+  const double freq_delta{1.0 / (static_cast<double>(n_fft) * time_delta)};
+  trace->delta(freq_delta);
+  trace->b(0.0);
+  trace->e(static_cast<double>(n_fft - 1) * freq_delta);
+}
+
+/*!
+  \brief Convert a spectral Trace to a time-series Trace.
+
+  Inverse of to_spectral: the time-series is truncated to nsnpts and b/delta
+  are restored from sb/sdelta (if set).
+
+  @param[in,out] trace Trace* Spectral Trace (irlim or iamph) to convert.
+  @throw processing_error If the Trace is not spectral or has no data.
+ */
+void to_time(Trace *trace) {
+  const int type{trace->iftype()};
+  if ((type != irlim) && (type != iamph)) {
+    throw processing_error("Trace is not spectral (irlim or iamph).");
+  }
+  const std::span<const double> first{trace->data1_view()};
+  const std::span<const double> second{trace->data2_view()};
+  const size_t n_fft{first.size()};
+  if ((n_fft == 0) || (second.size() != n_fft)) {
+    throw processing_error("Trace has no spectral data.");
+  }
+  std::vector<complex> spectrum((n_fft / 2) + 1);
+  for (size_t k{0}; k < spectrum.size(); ++k) {
+    spectrum[k] = (type == irlim ? complex{first[k], second[k]}
+                                 : complex{first[k] * std::cos(second[k]),
+                                           first[k] * std::sin(second[k])});
+  }
+  std::vector<double> result{irfft(spectrum, n_fft)};
+  const int original{trace->nsnpts()};
+  if ((original > 0) && (static_cast<size_t>(original) <= n_fft)) {
+    result.resize(static_cast<size_t>(original));
+  }
+  const double time_delta{
+      trace->sdelta() > 0.0
+          ? trace->sdelta()
+          : 1.0 / (static_cast<double>(n_fft) * trace->delta())};
+  const double begin{trace->sb() != unset_double ? trace->sb() : 0.0};
+  const size_t size{result.size()};
+  trace->iftype(itime);
+  trace->data1(std::move(result));
+  trace->delta(time_delta);
+  trace->b(begin);
+  trace->e(begin + (static_cast<double>(size - 1) * time_delta));
+}
+
+/*!
+  \brief Analytic signal (data + i * Hilbert transform of data).
+
+  The data is zero-padded to next_fast_size, transformed, the negative
+  frequencies are zeroed (positive ones doubled), and the result is inverse
+  transformed. The real part reproduces the data.
+
+  @param[in] data std::span<const double> Real data.
+  @param[out] output std::span<complex> Analytic signal (data.size() values).
+ */
+void analytic_signal(std::span<const double> data,
+                     std::span<complex> output) {
+  const size_t size{std::min(data.size(), output.size())};
+  if (size == 0) {
+    return;
+  }
+  const size_t n_fft{next_fast_size(size)};
+  thread_local std::vector<complex> buffer{};
+  buffer.assign(n_fft, complex{0.0, 0.0});
+  const std::shared_ptr<const rfft_plan> plan{rfft_plan::get(n_fft)};
+  plan->forward(data.first(size), buffer);
+  // Positive frequencies doubled; DC and Nyquist kept; negative ones zero
+  const size_t nyquist{(n_fft % 2 == 0) ? n_fft / 2 : n_fft};
+  for (size_t k{1}; k < plan->bins(); ++k) {
+    buffer[k] *= (k == nyquist) ? 1.0 : 2.0;
+  }
+  fft_plan::get(n_fft)->inverse(buffer);
+  std::copy_n(buffer.begin(), size, output.begin());
+}
+
+/*!
+  \brief Instantaneous attribute of data.
+
+  The frequency is the phase change between neighbouring samples (central
+  difference of the unwrapped phase; one-sided at the ends).
+
+  @param[in] data std::span<const double> Real data.
+  @param[out] output std::span<double> Attribute (data.size() values; may be
+  the same memory as data).
+  @param[in] attribute signal_attribute Attribute.
+  @param[in] delta double Sampling interval (for the frequency).
+ */
+void instantaneous(std::span<const double> data, std::span<double> output,
+                   const signal_attribute attribute, const double delta) {
+  const size_t size{std::min(data.size(), output.size())};
+  thread_local std::vector<complex> analytic{};
+  analytic.resize(size);
+  analytic_signal(data.first(size), analytic);
+  switch (attribute) {
+  case signal_attribute::envelope:
+    for (size_t i{0}; i < size; ++i) {
+      output[i] = std::abs(analytic[i]);
+    }
+    break;
+  case signal_attribute::phase:
+    for (size_t i{0}; i < size; ++i) {
+      output[i] = std::arg(analytic[i]);
+    }
+    break;
+  case signal_attribute::frequency: {
+    const double scale{1.0 / (2.0 * std::numbers::pi_v<double> * delta)};
+    for (size_t i{0}; i < size; ++i) {
+      const size_t before{i > 0 ? i - 1 : i};
+      const size_t after{i + 1 < size ? i + 1 : i};
+      const double steps{static_cast<double>(after - before)};
+      output[i] = steps > 0.0 ? std::arg(analytic[after] *
+                                         std::conj(analytic[before])) *
+                                    scale / steps
+                              : 0.0;
+    }
+    break;
+  }
+  }
+}
+
+/*!
+  \brief Replace a Trace's data with an instantaneous attribute.
+
+  Works on data1 in place (no copy of the data); depmin, depmax, and depmen
+  are updated.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] attribute signal_attribute Attribute.
+  @throw processing_error If the Trace is not an evenly-sampled time-series.
+ */
+void instantaneous(Trace *trace, const signal_attribute attribute) {
+  check_time_series(*trace);
+  const std::span<double> data{trace->data1_view()};
+  instantaneous(data, data, attribute, trace->delta());
+  trace->update_stats();
+}
+
+/*!
+  \brief Replace many Traces' data with an instantaneous attribute.
+
+  Traces are processed in parallel (parallel_for); Traces of equal length
+  share the cached transform plans.
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces.
+  @param[in] attribute signal_attribute Attribute.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing).
+ */
+void instantaneous(std::span<Trace> traces, const signal_attribute attribute,
+                   const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  parallel_for(
+      traces.size(),
+      [&traces, attribute](const size_t i) {
+        instantaneous(&traces[i], attribute);
+      },
+      threads);
+}
+
+/*!
+  \brief Replace a Trace's data with its envelope.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @throw processing_error If the Trace is not an evenly-sampled time-series.
+ */
+void envelope(Trace *trace) {
+  instantaneous(trace, signal_attribute::envelope);
+}
+
+/*!
+  \brief Replace many Traces' data with their envelopes (in parallel).
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw processing_error If any Trace is unsuitable.
+ */
+void envelope(std::span<Trace> traces, const size_t threads) {
+  instantaneous(traces, signal_attribute::envelope, threads);
+}
+//-----------------------------------------------------------------------------
+// Filtering
+//-----------------------------------------------------------------------------
+std::map<iir_filter::cache_key, std::shared_ptr<const iir_filter>>
+    iir_filter::cache{};
+std::deque<iir_filter::cache_key> iir_filter::cache_order{};
+std::mutex iir_filter::cache_mutex{};
+
+/*!
+  \brief Frequency response of a second-order-section cascade.
+
+  @param[in] sections std::span<const biquad> Second-order sections.
+  @param[in] omega double Digital frequency (radians/sample, pi = Nyquist).
+  @returns complex Response \f$H(e^{i\omega})\f$.
+ */
+complex sos_response(std::span<const biquad> sections,
+                     const double omega) noexcept {
+  const complex z1{std::polar(1.0, -omega)};
+  const complex z2{std::polar(1.0, -2.0 * omega)};
+  complex result{1.0, 0.0};
+  for (const biquad &section : sections) {
+    result *= (section.b0 + (section.b1 * z1) + (section.b2 * z2)) /
+              (1.0 + (section.a1 * z1) + (section.a2 * z2));
+  }
+  return result;
+}
+
+/*!
+  \brief Butterworth design (bilinear transform to second-order sections).
+
+  Analog prototype poles are frequency-transformed (lowpass, highpass,
+  bandpass, or bandstop) at prewarped corners, grouped into conjugate pairs,
+  and each section is mapped by the bilinear transform. The cascade is
+  normalized to unit gain in the passband (DC, Nyquist, band center, or DC
+  respectively). Band filters have 2*order poles.
+
+  @param[in] spec filter_spec Filter specification.
+  @param[in] delta double Sampling interval (seconds).
+  @returns std::vector<biquad> Second-order sections.
+  @throw processing_error If the order or corners are invalid.
+ */
+std::vector<biquad> butterworth(const filter_spec &spec, const double delta) {
+  const bool band{(spec.type == filter_type::bandpass) ||
+                  (spec.type == filter_type::bandstop)};
+  if ((spec.order < 1) || (spec.order > max_filter_order)) {
+    throw processing_error("Filter order must be between 1 and " +
+                           std::to_string(max_filter_order) + ".");
+  }
+  if (!(delta > 0.0)) {
+    throw processing_error("Filter delta must be positive.");
+  }
+  const double nyquist{0.5 / delta};
+  const auto valid = [nyquist](const double corner) {
+    return (corner > 0.0) && (corner < nyquist);
+  };
+  if (!valid(spec.corner1) ||
+      (band && (!valid(spec.corner2) || (spec.corner2 <= spec.corner1)))) {
+    throw processing_error(
+        "Filter corners must be increasing and between 0 and Nyquist.");
+  }
+  // Prewarped corners (bilinear transform with s = (1 - z^-1)/(1 + z^-1))
+  const double warp1{std::tan(std::numbers::pi_v<double> * spec.corner1 *
+                              delta)};
+  const double warp2{
+      band ? std::tan(std::numbers::pi_v<double> * spec.corner2 * delta)
+           : 0.0};
+  const double center_sq{warp1 * warp2};
+  const double bandwidth{warp2 - warp1};
+  // Analog poles
+  std::vector<complex> poles{};
+  const auto order{static_cast<size_t>(spec.order)};
+  for (size_t k{0}; k < order; ++k) {
+    const double angle{std::numbers::pi_v<double> *
+                       static_cast<double>((2 * k) + order + 1) /
+                       static_cast<double>(2 * order)};
+    const complex prototype{std::polar(1.0, angle)};
+    switch (spec.type) {
+    case filter_type::lowpass:
+      poles.push_back(warp1 * prototype);
+      break;
+    case filter_type::highpass:
+      poles.push_back(warp1 / prototype);
+      break;
+    case filter_type::bandpass:
+    case filter_type::bandstop: {
+      // Roots of s^2 - q s + w0^2
+      const complex q{spec.type == filter_type::bandpass
+                          ? prototype * bandwidth
+                          : bandwidth / prototype};
+      const complex root{std::sqrt((q * q) - (4.0 * center_sq))};
+      poles.push_back(0.5 * (q + root));
+      poles.push_back(0.5 * (q - root));
+      break;
+    }
+    }
+  }
+  // Group poles: conjugate pairs, then pairs of real poles
+  constexpr double real_tolerance{1e-12};
+  std::vector<std::array<double, 2>> quadratics{};  // s^2 + c1 s + c0
+  std::vector<double> reals{};
+  for (const complex &pole : poles) {
+    if (std::abs(pole.imag()) <= real_tolerance * std::abs(pole)) {
+      reals.push_back(pole.real());
+    } else if (pole.imag() > 0.0) {
+      quadratics.push_back({-2.0 * pole.real(), std::norm(pole)});
+    }
+  }
+  std::sort(reals.begin(), reals.end());
+  for (size_t i{0}; i + 1 < reals.size(); i += 2) {
+    quadratics.push_back(
+        {-(reals[i] + reals[i + 1]), reals[i] * reals[i + 1]});
+  }
+  std::vector<biquad> result{};
+  // Second-order: analog (n2 s^2 + n1 s + n0)/(s^2 + c1 s + c0)
+  for (const auto &[c1, c0] : quadratics) {
+    double n2{0.0};
+    double n1{0.0};
+    double n0{0.0};
+    switch (spec.type) {
+    case filter_type::lowpass:
+      n0 = 1.0;
+      break;
+    case filter_type::highpass:
+      n2 = 1.0;
+      break;
+    case filter_type::bandpass:
+      n1 = 1.0;
+      break;
+    case filter_type::bandstop:
+      n2 = 1.0;
+      n0 = center_sq;
+      break;
+    }
+    const double a0{1.0 + c1 + c0};
+    result.push_back({(n2 + n1 + n0) / a0, 2.0 * (n0 - n2) / a0,
+                      (n2 - n1 + n0) / a0, 2.0 * (c0 - 1.0) / a0,
+                      (1.0 - c1 + c0) / a0});
+  }
+  // First-order (odd lowpass/highpass): analog (n1 s + n0)/(s + c0)
+  if (reals.size() % 2 != 0) {
+    const double c0{-reals.back()};
+    const double n1{spec.type == filter_type::highpass ? 1.0 : 0.0};
+    const double n0{spec.type == filter_type::highpass ? 0.0 : 1.0};
+    const double a0{1.0 + c0};
+    result.push_back({(n1 + n0) / a0, (n0 - n1) / a0, 0.0, (c0 - 1.0) / a0,
+                      0.0});
+  }
+  // Unit passband gain
+  double omega{0.0};
+  if (spec.type == filter_type::highpass) {
+    omega = std::numbers::pi_v<double>;
+  } else if (spec.type == filter_type::bandpass) {
+    omega = 2.0 * std::atan(std::sqrt(center_sq));
+  }
+  const double gain{std::abs(sos_response(result, omega))};
+  if (gain > 0.0) {
+    result.front().b0 /= gain;
+    result.front().b1 /= gain;
+    result.front().b2 /= gain;
+  }
+  return result;
+}
+
+/*!
+  \brief Design a Butterworth filter.
+
+  @param[in] spec filter_spec Filter specification.
+  @param[in] delta double Sampling interval (seconds).
+  @throw processing_error If the order or corners are invalid.
+ */
+iir_filter::iir_filter(const filter_spec &spec, const double delta)
+    : sos{butterworth(spec, delta)} {}
+
+/*!
+  \brief Second-order sections.
+
+  @returns std::vector<biquad> Second-order sections.
+ */
+const std::vector<biquad> &iir_filter::sections() const noexcept {
+  return sos;
+}
+
+/*!
+  \brief Run the cascade over one data vector (one direction).
+
+  Transposed direct-form II, block by block; the section states carry across
+  blocks.
+
+  @param[in,out] data std::span<double> Data vector.
+  @param[in] reverse bool Run from the last sample to the first.
+ */
+void iir_filter::run(std::span<double> data,
+                     const bool reverse) const noexcept {
+  const size_t size{data.size()};
+  std::vector<std::array<double, 2>> states(sos.size(), {0.0, 0.0});
+  for (size_t start{0}; start < size; start += filter_block) {
+    const size_t count{std::min(filter_block, size - start)};
+    for (size_t section{0}; section < sos.size(); ++section) {
+      // Copied, so the compiler knows the output stores cannot change it
+      const biquad coef{sos[section]};
+      double state1{states[section][0]};
+      double state2{states[section][1]};
+      for (size_t i{0}; i < count; ++i) {
+        const size_t index{reverse ? size - 1 - (start + i) : start + i};
+        const double input{data[index]};
+        const double output{(coef.b0 * input) + state1};
+        state1 = (coef.b1 * input) - (coef.a1 * output) + state2;
+        state2 = (coef.b2 * input) - (coef.a2 * output);
+        data[index] = output;
+      }
+      states[section] = {state1, state2};
+    }
+  }
+}
+
+/*!
+  \brief Run the cascade over up to ::filter_lanes equal-length data vectors
+  (one direction).
+
+  Each block is interleaved (sample-major, one lane per vector) so the
+  recursion updates all lanes with the same vector operations, then
+  de-interleaved.
+
+  @param[in,out] channels std::span<const std::span<double>> Data vectors
+  (same size, at most ::filter_lanes).
+  @param[in] reverse bool Run from the last sample to the first.
+ */
+void iir_filter::run_lanes(std::span<const std::span<double>> channels,
+                           const bool reverse) const noexcept {
+  using lanes = std::array<double, filter_lanes>;
+  const size_t n_lanes{std::min(channels.size(), filter_lanes)};
+  const size_t size{channels.empty() ? 0 : channels[0].size()};
+  std::vector<std::array<lanes, 2>> states(sos.size());
+  std::vector<lanes> buffer(std::min(size, filter_block));
+  for (size_t start{0}; start < size; start += filter_block) {
+    const size_t count{std::min(filter_block, size - start)};
+    // Interleave (unused lanes are zero)
+    for (size_t i{0}; i < count; ++i) {
+      const size_t index{reverse ? size - 1 - (start + i) : start + i};
+      buffer[i].fill(0.0);
+      for (size_t lane{0}; lane < n_lanes; ++lane) {
+        buffer[i][lane] = channels[lane][index];
+      }
+    }
+    for (size_t section{0}; section < sos.size(); ++section) {
+      // Copied, so the compiler knows the output stores cannot change it
+      const biquad coef{sos[section]};
+      lanes state1{states[section][0]};
+      lanes state2{states[section][1]};
+      for (size_t i{0}; i < count; ++i) {
+        lanes &values{buffer[i]};
+        for (size_t lane{0}; lane < filter_lanes; ++lane) {
+          const double input{values[lane]};
+          const double output{(coef.b0 * input) + state1[lane]};
+          state1[lane] = (coef.b1 * input) - (coef.a1 * output) + state2[lane];
+          state2[lane] = (coef.b2 * input) - (coef.a2 * output);
+          values[lane] = output;
+        }
+      }
+      states[section] = {state1, state2};
+    }
+    // De-interleave
+    for (size_t i{0}; i < count; ++i) {
+      const size_t index{reverse ? size - 1 - (start + i) : start + i};
+      for (size_t lane{0}; lane < n_lanes; ++lane) {
+        channels[lane][index] = buffer[i][lane];
+      }
+    }
+  }
+}
+
+/*!
+  \brief Filter one data vector in place.
+
+  @param[in,out] data std::span<double> Data vector.
+  @param[in] zero_phase bool Filter forward then backward (zero-phase, squared
+  amplitude response) if true, else forward only (causal).
+ */
+void iir_filter::apply(std::span<double> data,
+                       const bool zero_phase) const noexcept {
+  run(data, false);
+  if (zero_phase) {
+    run(data, true);
+  }
+}
+
+/*!
+  \brief Filter several data vectors in place.
+
+  Consecutive vectors of equal size are filtered together, ::filter_lanes at a
+  time (sort by size beforehand for the best grouping).
+
+  @param[in,out] channels std::span<const std::span<double>> Data vectors.
+  @param[in] zero_phase bool Filter forward then backward if true.
+ */
+void iir_filter::apply(std::span<const std::span<double>> channels,
+                       const bool zero_phase) const noexcept {
+  size_t first{0};
+  while (first < channels.size()) {
+    size_t last{first + 1};
+    while ((last < channels.size()) && (last - first < filter_lanes) &&
+           (channels[last].size() == channels[first].size())) {
+      ++last;
+    }
+    const std::span<const std::span<double>> group{
+        channels.subspan(first, last - first)};
+    if (group.size() == 1) {
+      apply(group[0], zero_phase);
+    } else {
+      run_lanes(group, false);
+      if (zero_phase) {
+        run_lanes(group, true);
+      }
+    }
+    first = last;
+  }
+}
+
+/*!
+  \brief Cached filter.
+
+  The cache keeps at most ::max_cached_filters designs, evicting the oldest
+  first.
+
+  @param[in] spec filter_spec Filter specification.
+  @param[in] delta double Sampling interval (seconds).
+  @returns std::shared_ptr<const iir_filter> Filter.
+  @throw processing_error If the order or corners are invalid.
+ */
+std::shared_ptr<const iir_filter> iir_filter::get(const filter_spec &spec,
+                                                  const double delta) {
+  const bool band{(spec.type == filter_type::bandpass) ||
+                  (spec.type == filter_type::bandstop)};
+  const cache_key key{static_cast<int>(spec.type), spec.order, spec.corner1,
+                      band ? spec.corner2 : 0.0, delta};
+  {
+    const std::scoped_lock lock{cache_mutex};
+    const auto found{cache.find(key)};
+    if (found != cache.end()) {
+      return found->second;
+    }
+  }
+  auto filter{std::make_shared<const iir_filter>(spec, delta)};
+  const std::scoped_lock lock{cache_mutex};
+  const auto [found, inserted]{cache.try_emplace(key, std::move(filter))};
+  std::shared_ptr<const iir_filter> result{found->second};
+  if (inserted) {
+    cache_order.push_back(key);
+    while (cache.size() > max_cached_filters) {
+      cache.erase(cache_order.front());
+      cache_order.pop_front();
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Filter a Trace (data1, in place).
+
+  depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] spec filter_spec Filter specification.
+  @param[in] zero_phase bool Filter forward then backward if true.
+  @throw processing_error If the Trace is not an evenly-sampled time-series,
+  or the filter specification is invalid for its delta.
+ */
+void filter(Trace *trace, const filter_spec &spec, const bool zero_phase) {
+  check_time_series(*trace);
+  iir_filter::get(spec, trace->delta())->apply(trace->data1_view(), zero_phase);
+  trace->update_stats();
+}
+
+/*!
+  \brief Filter many Traces (data1, in place).
+
+  Traces are grouped by delta (one cached design per delta) and npts, and each
+  group is filtered ::filter_lanes Traces at a time (interleaved). depmin,
+  depmax, and depmen of each Trace are updated.
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces.
+  @param[in] spec filter_spec Filter specification.
+  @param[in] zero_phase bool Filter forward then backward if true.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  filtering), or the filter specification is invalid for a delta.
+ */
+void filter(std::span<Trace> traces, const filter_spec &spec,
+            const bool zero_phase) {
+  std::vector<size_t> order(traces.size());
+  for (size_t i{0}; i < traces.size(); ++i) {
+    check_time_series(traces[i]);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&traces](size_t lhs, size_t rhs) {
+    return std::make_pair(traces[lhs].delta(), traces[lhs].npts()) <
+           std::make_pair(traces[rhs].delta(), traces[rhs].npts());
+  });
+  size_t first{0};
+  while (first < order.size()) {
+    const double delta{traces[order[first]].delta()};
+    std::vector<std::span<double>> channels{};
+    size_t last{first};
+    while ((last < order.size()) && (traces[order[last]].delta() == delta)) {
+      channels.push_back(traces[order[last]].data1_view());
+      ++last;
+    }
+    iir_filter::get(spec, delta)->apply(channels, zero_phase);
+    first = last;
+  }
+  for (Trace &trace : traces) {
+    trace.update_stats();
+  }
+}
+//-----------------------------------------------------------------------------
+// Resampling
+//-----------------------------------------------------------------------------
+std::map<resampler::cache_key, std::shared_ptr<const resampler>>
+    resampler::cache{};
+std::deque<resampler::cache_key> resampler::cache_order{};
+std::mutex resampler::cache_mutex{};
+
+/*!
+  \brief Modified Bessel function of the first kind, order zero.
+
+  Power series \f$\sum_k ((x/2)^k/k!)^2\f$ (converges quickly for the Kaiser
+  window shape parameters in use).
+
+  @param[in] x double Argument.
+  @returns double \f$I_0(x)\f$.
+ */
+double bessel_i0(const double x) noexcept {
+  const double quarter_sq{0.25 * x * x};
+  double term{1.0};
+  double result{1.0};
+  for (int k{1}; term > result * std::numeric_limits<double>::epsilon();
+       ++k) {
+    term *= quarter_sq / static_cast<double>(k * k);
+    result += term;
+  }
+  return result;
+}
+
+/*!
+  \brief Kaiser-windowed sinc lowpass (2 * half_length + 1 taps).
+
+  @param[in] half_length size_t Taps on each side of the center.
+  @param[in] cutoff double Cutoff frequency (cycles/sample, 0 to 0.5).
+  @param[in] beta double Kaiser window shape parameter.
+  @returns std::vector<double> Taps (normalized to unit DC gain).
+ */
+std::vector<double> kaiser_lowpass(const size_t half_length,
+                                   const double cutoff, const double beta) {
+  std::vector<double> result(2 * half_length + 1);
+  const double window_scale{1.0 / bessel_i0(beta)};
+  double sum{0.0};
+  for (size_t i{0}; i < result.size(); ++i) {
+    const double offset{static_cast<double>(i) -
+                        static_cast<double>(half_length)};
+    const double argument{std::numbers::pi_v<double> * 2.0 * cutoff * offset};
+    const double sinc{offset == 0.0 ? 1.0 : std::sin(argument) / argument};
+    const double ratio{half_length == 0
+                           ? 0.0
+                           : offset / static_cast<double>(half_length)};
+    const double window{
+        bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - (ratio * ratio)))) *
+        window_scale};
+    result[i] = 2.0 * cutoff * sinc * window;
+    sum += result[i];
+  }
+  for (double &tap : result) {
+    tap /= sum;
+  }
+  return result;
+}
+
+/*!
+  \brief Rational factors (up, down) with delta * down / up == new_delta.
+
+  Uses the first continued-fraction convergent of delta / new_delta that
+  matches to within a relative 1e-9.
+
+  @param[in] delta double Current sampling interval.
+  @param[in] new_delta double New sampling interval.
+  @returns std::pair<size_t, size_t> Reduced factors (up, down).
+  @throw processing_error If either interval is not positive, or the ratio
+  needs a factor larger than ::max_resample_factor.
+ */
+std::pair<size_t, size_t> resample_factors(const double delta,
+                                           const double new_delta) {
+  if (!(delta > 0.0) || !(new_delta > 0.0)) {
+    throw processing_error("Sampling intervals must be positive.");
+  }
+  constexpr double tolerance{1e-9};
+  const double ratio{delta / new_delta};
+  const auto limit{static_cast<double>(max_resample_factor)};
+  double remainder{ratio};
+  // Convergents numerator/denominator
+  double numerator_prev{1.0};
+  double numerator{std::floor(remainder)};
+  double denominator_prev{0.0};
+  double denominator{1.0};
+  while ((numerator <= limit) && (denominator <= limit)) {
+    if ((numerator >= 1.0) &&
+        (std::abs((numerator / denominator) - ratio) <= tolerance * ratio)) {
+      return {static_cast<size_t>(numerator),
+              static_cast<size_t>(denominator)};
+    }
+    const double fraction{remainder - std::floor(remainder)};
+    if (fraction <= 0.0) {
+      break;
+    }
+    remainder = 1.0 / fraction;
+    const double term{std::floor(remainder)};
+    numerator_prev = std::exchange(numerator,
+                                   (term * numerator) + numerator_prev);
+    denominator_prev = std::exchange(denominator,
+                                     (term * denominator) + denominator_prev);
+  }
+  throw processing_error(
+      "Resampling ratio is not a ratio of integers up to " +
+      std::to_string(max_resample_factor) + ".");
+}
+
+/*!
+  \brief Design a polyphase resampler.
+
+  @param[in] up size_t Interpolation factor.
+  @param[in] down size_t Decimation factor.
+  @throw processing_error If a reduced factor is zero or larger than
+  ::max_resample_factor.
+ */
+resampler::resampler(const size_t up, const size_t down) {
+  if ((up == 0) || (down == 0)) {
+    throw processing_error("Resampling factors must be positive.");
+  }
+  const size_t common{std::gcd(up, down)};
+  n_up = up / common;
+  n_down = down / common;
+  if ((n_up > max_resample_factor) || (n_down > max_resample_factor)) {
+    throw processing_error("Resampling factors must be at most " +
+                           std::to_string(max_resample_factor) + ".");
+  }
+  const size_t factor{std::max(n_up, n_down)};
+  delay = resample_half_width * factor;
+  const std::vector<double> prototype{kaiser_lowpass(
+      delay, 0.5 / static_cast<double>(factor), resample_kaiser_beta)};
+  phase_taps = (prototype.size() + n_up - 1) / n_up;
+  taps.assign(n_up * phase_taps, 0.0);
+  // Zero insertion divides the DC gain by up
+  const auto gain{static_cast<double>(n_up)};
+  for (size_t i{0}; i < prototype.size(); ++i) {
+    const size_t phase{i % n_up};
+    const size_t offset{i / n_up};
+    taps[(phase * phase_taps) + (phase_taps - 1 - offset)] =
+        prototype[i] * gain;
+  }
+}
+
+/*!
+  \brief Interpolation factor (reduced).
+
+  @returns size_t Interpolation factor.
+ */
+size_t resampler::up() const noexcept { return n_up; }
+
+/*!
+  \brief Decimation factor (reduced).
+
+  @returns size_t Decimation factor.
+ */
+size_t resampler::down() const noexcept { return n_down; }
+
+/*!
+  \brief Number of output samples for an input size.
+
+  @param[in] input_size size_t Number of input samples.
+  @returns size_t \f$\lceil n \cdot up / down \rceil\f$.
+ */
+size_t resampler::output_size(const size_t input_size) const noexcept {
+  return ((input_size * n_up) + n_down - 1) / n_down;
+}
+
+/*!
+  \brief One output sample (samples outside the input are zero).
+
+  @param[in] input std::span<const double> Input data.
+  @param[in] index size_t Output sample index.
+  @returns double Output sample.
+ */
+double resampler::output_sample(std::span<const double> input,
+                                const size_t index) const noexcept {
+  const size_t position{(index * n_down) + delay};
+  const std::span<const double> coefficients{
+      std::span<const double>{taps}.subspan((position % n_up) * phase_taps,
+                                            phase_taps)};
+  // Taps line up with input[end - phase_taps, end)
+  const size_t end{(position / n_up) + 1};
+  if ((end >= phase_taps) && (end <= input.size())) {
+    return dot_product(coefficients, input.subspan(end - phase_taps,
+                                                   phase_taps));
+  }
+  double result{0.0};
+  for (size_t i{0}; i < phase_taps; ++i) {
+    if (end + i < phase_taps) {
+      continue;
+    }
+    const size_t sample{end + i - phase_taps};
+    if (sample >= input.size()) {
+      break;
+    }
+    result += coefficients[i] * input[sample];
+  }
+  return result;
+}
+
+/*!
+  \brief Resample into an output vector.
+
+  @param[in] input std::span<const double> Input data.
+  @param[out] output std::span<double> Output data
+  (resampler::output_size(input.size()) samples; extra samples are untouched).
+ */
+void resampler::apply(std::span<const double> input,
+                      std::span<double> output) const noexcept {
+  const size_t size{std::min(output.size(), output_size(input.size()))};
+  for (size_t index{0}; index < size; ++index) {
+    output[index] = output_sample(input, index);
+  }
+}
+
+/*!
+  \brief Resample in place (down >= up).
+
+  Each output sample is held back until no later output needs the input
+  sample it overwrites, so only about one filter length of extra memory is
+  used.
+
+  @param[in,out] data std::span<double> Data; the first
+  resampler::output_size(data.size()) samples are replaced by the output.
+  @returns size_t Number of output samples.
+  @throw processing_error If up > down (the output would not fit).
+ */
+size_t resampler::apply(std::span<double> data) const {
+  if (n_up > n_down) {
+    throw processing_error("In-place resampling cannot increase the size.");
+  }
+  const size_t size{output_size(data.size())};
+  std::deque<double> pending{};
+  size_t written{0};
+  for (size_t index{0}; index < size; ++index) {
+    pending.push_back(output_sample(data, index));
+    // First input sample needed by the next output
+    const size_t end{((((index + 1) * n_down) + delay) / n_up) + 1};
+    const size_t needed{end > phase_taps ? end - phase_taps : 0};
+    while (!pending.empty() && (written < needed)) {
+      data[written++] = pending.front();
+      pending.pop_front();
+    }
+  }
+  for (const double sample : pending) {
+    data[written++] = sample;
+  }
+  return size;
+}
+
+/*!
+  \brief Cached resampler.
+
+  The cache keeps at most ::max_cached_resamplers resamplers, evicting the
+  oldest first.
+
+  @param[in] up size_t Interpolation factor.
+  @param[in] down size_t Decimation factor.
+  @returns std::shared_ptr<const resampler> Resampler (reduced factors).
+  @throw processing_error If a reduced factor is zero or larger than
+  ::max_resample_factor.
+ */
+std::shared_ptr<const resampler> resampler::get(const size_t up,
+                                                const size_t down) {
+  if ((up == 0) || (down == 0)) {
+    throw processing_error("Resampling factors must be positive.");
+  }
+  const size_t common{std::gcd(up, down)};
+  const cache_key key{up / common, down / common};
+  {
+    const std::scoped_lock lock{cache_mutex};
+    const auto found{cache.find(key)};
+    if (found != cache.end()) {
+      return found->second;
+    }
+  }
+  auto filter{std::make_shared<const resampler>(key.first, key.second)};
+  const std::scoped_lock lock{cache_mutex};
+  const auto [found, inserted]{cache.try_emplace(key, std::move(filter))};
+  std::shared_ptr<const resampler> result{found->second};
+  if (inserted) {
+    cache_order.push_back(key);
+    while (cache.size() > max_cached_resamplers) {
+      cache.erase(cache_order.front());
+      cache_order.pop_front();
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Resample a Trace by a rational factor (data1 and headers).
+
+  The new sampling interval is delta * down / up; npts, e, depmin, depmax, and
+  depmen are updated (b is unchanged). Shrinking resamples in place.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] up size_t Interpolation factor.
+  @param[in] down size_t Decimation factor.
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  has no data, or the factors are invalid.
+ */
+void resample(Trace *trace, const size_t up, const size_t down) {
+  check_time_series(*trace);
+  if (trace->data1_view().empty()) {
+    throw processing_error("Trace has no data.");
+  }
+  const std::shared_ptr<const resampler> filter{resampler::get(up, down)};
+  if (filter->up() == filter->down()) {
+    return;
+  }
+  if (filter->down() > filter->up()) {
+    trace->npts(static_cast<int>(filter->apply(trace->data1_view())));
+  } else {
+    const std::span<const double> input{trace->data1_view()};
+    std::vector<double> output(filter->output_size(input.size()));
+    filter->apply(input, output);
+    trace->data1(std::move(output));
+  }
+  trace->delta(trace->delta() * static_cast<double>(filter->down()) /
+               static_cast<double>(filter->up()));
+  if (trace->b() != unset_double) {
+    trace->e(trace->b() +
+             (static_cast<double>(trace->npts() - 1) * trace->delta()));
+  }
+  trace->update_stats();
+}
+
+/*!
+  \brief Resample a Trace to a new sampling interval.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] new_delta double New sampling interval (the ratio to delta must
+  be a ratio of integers up to ::max_resample_factor).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  has no data, or the ratio is not supported.
+ */
+void resample(Trace *trace, const double new_delta) {
+  check_time_series(*trace);
+  const auto [up, down] = resample_factors(trace->delta(), new_delta);
+  resample(trace, up, down);
+}
+
+/*!
+  \brief Decimate a Trace by an integer factor (anti-aliased, in place).
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] factor size_t Decimation factor.
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  has no data, or the factor is invalid.
+ */
+void decimate(Trace *trace, const size_t factor) {
+  resample(trace, 1, factor);
+}
+
+/*!
+  \brief Interpolate (x, y) samples onto an even grid.
+
+  The grid (start + j * step) and the sorted x values are walked together in
+  a single pass. Akima node slopes are computed when an interval is entered
+  (from the neighbouring secant slopes, extended past the ends as in Akima's
+  method), so no extra arrays are needed. Grid points outside [x.front(),
+  x.back()] take the end values.
+
+  @param[in] x std::span<const double> Strictly increasing sample positions.
+  @param[in] y std::span<const double> Sample values (same size as x).
+  @param[in] start double First grid position.
+  @param[in] step double Grid spacing.
+  @param[out] output std::span<double> Interpolated values (one per grid
+  point).
+  @param[in] method interpolation Interpolation method (Akima needs at least
+  three samples, else linear is used).
+ */
+void interpolate(std::span<const double> x, std::span<const double> y,
+                 const double start, const double step,
+                 std::span<double> output,
+                 const interpolation method) noexcept {
+  const size_t size{std::min(x.size(), y.size())};
+  if (size == 0) {
+    return;
+  }
+  if (size == 1) {
+    std::fill(output.begin(), output.end(), y[0]);
+    return;
+  }
+  const bool akima{(method == interpolation::akima) && (size >= 3)};
+  const auto secant = [&x, &y](const size_t i) {
+    return (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+  };
+  // Secant slope of interval k (k in [-2, size]), extended past the ends
+  const auto slope = [&secant, size](const std::ptrdiff_t k) {
+    const auto last{static_cast<std::ptrdiff_t>(size) - 2};
+    if (k < 0) {
+      const double first{secant(0)};
+      return first + (static_cast<double>(-k) * (first - secant(1)));
+    }
+    if (k > last) {
+      const double end{secant(static_cast<size_t>(last))};
+      return end + (static_cast<double>(k - last) *
+                    (end - secant(static_cast<size_t>(last - 1))));
+    }
+    return secant(static_cast<size_t>(k));
+  };
+  const auto node_slope = [&slope](const std::ptrdiff_t i) {
+    const double m_2{slope(i - 2)};
+    const double m_1{slope(i - 1)};
+    const double m0{slope(i)};
+    const double m1{slope(i + 1)};
+    const double weight_left{std::abs(m1 - m0)};
+    const double weight_right{std::abs(m_1 - m_2)};
+    if (weight_left + weight_right == 0.0) {
+      return 0.5 * (m_1 + m0);
+    }
+    return ((weight_left * m_1) + (weight_right * m0)) /
+           (weight_left + weight_right);
+  };
+  size_t interval{0};
+  size_t cached{size};
+  double slope_left{0.0};
+  double slope_right{0.0};
+  for (size_t j{0}; j < output.size(); ++j) {
+    const double position{start + (static_cast<double>(j) * step)};
+    if (position <= x[0]) {
+      output[j] = y[0];
+      continue;
+    }
+    if (position >= x[size - 1]) {
+      output[j] = y[size - 1];
+      continue;
+    }
+    while ((interval + 2 < size) && (x[interval + 1] <= position)) {
+      ++interval;
+    }
+    const double width{x[interval + 1] - x[interval]};
+    const double fraction{(position - x[interval]) / width};
+    if (!akima) {
+      output[j] = y[interval] + (fraction * (y[interval + 1] - y[interval]));
+      continue;
+    }
+    if (cached != interval) {
+      slope_left = node_slope(static_cast<std::ptrdiff_t>(interval));
+      slope_right = node_slope(static_cast<std::ptrdiff_t>(interval + 1));
+      cached = interval;
+    }
+    // Cubic Hermite
+    const double fraction_sq{fraction * fraction};
+    const double fraction_cu{fraction_sq * fraction};
+    output[j] =
+        (((2.0 * fraction_cu) - (3.0 * fraction_sq) + 1.0) * y[interval]) +
+        ((fraction_cu - (2.0 * fraction_sq) + fraction) * width *
+         slope_left) +
+        (((-2.0 * fraction_cu) + (3.0 * fraction_sq)) * y[interval + 1]) +
+        ((fraction_cu - fraction_sq) * width * slope_right);
+  }
+}
+
+/*!
+  \brief Interpolate an unevenly-sampled Trace onto an even grid.
+
+  The independent variable (data2) runs from its first to its last value; the
+  grid starts at the first value (the new b) with spacing delta. Afterwards
+  the Trace is evenly-sampled (leven is true and data2 is dropped), and npts,
+  e, depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Unevenly-sampled time-series Trace.
+  @param[in] delta double New sampling interval.
+  @param[in] method interpolation Interpolation method.
+  @throw processing_error If the Trace is not an unevenly-sampled
+  time-series, has fewer than two samples, the independent variable is not
+  strictly increasing, or delta is not positive.
+ */
+void to_even(Trace *trace, const double delta, const interpolation method) {
+  if (((trace->iftype() != itime) && (trace->iftype() != unset_int)) ||
+      trace->leven()) {
+    throw processing_error("Trace is not an unevenly-sampled time-series.");
+  }
+  if (!(delta > 0.0)) {
+    throw processing_error("Sampling interval must be positive.");
+  }
+  const std::span<const double> y{trace->data1_view()};
+  const std::span<const double> x{trace->data2_view()};
+  if ((x.size() != y.size()) || (x.size() < 2)) {
+    throw processing_error("Trace does not have two or more (x, y) samples.");
+  }
+  if (std::adjacent_find(x.begin(), x.end(), std::greater_equal<>{}) !=
+      x.end()) {
+    throw processing_error("Independent variable is not strictly increasing.");
+  }
+  const double begin{x.front()};
+  // Guard against the last grid point being lost to rounding
+  constexpr double slack{1e-9};
+  const auto size{
+      static_cast<size_t>(std::floor(((x.back() - begin) / delta) + slack)) +
+      1};
+  std::vector<double> output(size);
+  interpolate(x, y, begin, delta, output, method);
+  trace->leven(true);
+  trace->data1(std::move(output));
+  trace->delta(delta);
+  trace->b(begin);
+  trace->e(begin + (static_cast<double>(size - 1) * delta));
+  trace->update_stats();
+}
+//-----------------------------------------------------------------------------
+// Cross-Correlation
+//-----------------------------------------------------------------------------
+/*!
+  \brief Prepare templates for normalized cross-correlation.
+
+  The transform size is the next fast size of at least four times the longest
+  template (and at least ::xcorr_min_fft), so most of each block is output.
+
+  @param[in] templates std::vector<std::vector<double>> Templates.
+  @throw processing_error If there are no templates, or a template has fewer
+  than two samples or is constant.
+ */
+template_bank::template_bank(
+    const std::vector<std::vector<double>> &templates) {
+  if (templates.empty()) {
+    throw processing_error("Template bank is empty.");
+  }
+  size_t longest{0};
+  for (const std::vector<double> &samples : templates) {
+    longest = std::max(longest, samples.size());
+  }
+  n_fft = next_fast_size(std::max(xcorr_min_fft, 4 * longest));
+  block_step = n_fft - longest + 1;
+  plan = rfft_plan::get(n_fft);
+  for (const std::vector<double> &samples : templates) {
+    if (samples.size() < 2) {
+      throw processing_error("Template has fewer than two samples.");
+    }
+    std::vector<double> normalized{samples};
+    rmean(normalized);
+    const double norm{std::sqrt(dot_product(normalized, normalized))};
+    if (!(norm > 0.0)) {
+      throw processing_error("Template is constant.");
+    }
+    for (double &value : normalized) {
+      value /= norm;
+    }
+    std::vector<complex> spectrum(plan->bins());
+    plan->forward(normalized, spectrum);
+    for (complex &value : spectrum) {
+      value = std::conj(value);
+    }
+    spectra.push_back(std::move(spectrum));
+    const auto found{std::find(distinct_sizes.begin(), distinct_sizes.end(),
+                               samples.size())};
+    size_index.push_back(
+        static_cast<size_t>(std::distance(distinct_sizes.begin(), found)));
+    if (found == distinct_sizes.end()) {
+      distinct_sizes.push_back(samples.size());
+    }
+    sizes.push_back(samples.size());
+  }
+}
+
+/*!
+  \brief Number of templates.
+
+  @returns size_t Number of templates.
+ */
+size_t template_bank::size() const noexcept { return sizes.size(); }
+
+/*!
+  \brief Template size.
+
+  @param[in] index size_t Template index.
+  @returns size_t Number of samples in the template.
+ */
+size_t template_bank::template_size(const size_t index) const noexcept {
+  return sizes[index];
+}
+
+/*!
+  \brief Overlap-save transform size.
+
+  @returns size_t Transform size.
+ */
+size_t template_bank::fft_size() const noexcept { return n_fft; }
+
+/*!
+  \brief Lags computed per overlap-save block.
+
+  @returns size_t Lags per block.
+ */
+size_t template_bank::step() const noexcept { return block_step; }
+
+/*!
+  \brief Number of lags for a template and data size.
+
+  @param[in] data_size size_t Number of data samples.
+  @param[in] index size_t Template index.
+  @returns size_t data_size - template size + 1 (0 if the data is shorter).
+ */
+size_t template_bank::lags(const size_t data_size,
+                           const size_t index) const noexcept {
+  return data_size >= sizes[index] ? data_size - sizes[index] + 1 : 0;
+}
+
+/*!
+  \brief Normalized cross-correlation for a range of lags.
+
+  Template i fills outputs[i] with lags first, first + 1, ... (outputs[i] may
+  be shorter or empty; it is never written past the last lag). Windows with no
+  variance give 0.
+
+  @param[in] data std::span<const double> Data.
+  @param[out] outputs std::span<const std::span<double>> One output per
+  template.
+  @param[in] first size_t First lag.
+  @throw processing_error If the number of outputs does not match the number
+  of templates.
+ */
+void template_bank::correlate(std::span<const double> data,
+                              std::span<const std::span<double>> outputs,
+                              const size_t first) const {
+  if (outputs.size() != size()) {
+    throw processing_error("Need one cross-correlation output per template.");
+  }
+  std::vector<size_t> counts(size());
+  size_t last{first};
+  for (size_t i{0}; i < size(); ++i) {
+    const size_t available{lags(data.size(), i)};
+    counts[i] = first < available
+                    ? std::min(outputs[i].size(), available - first)
+                    : 0;
+    last = std::max(last, first + counts[i]);
+  }
+  std::vector<complex> spectrum(plan->bins());
+  std::vector<complex> product(plan->bins());
+  std::vector<double> result(n_fft);
+  std::vector<std::vector<double>> scales(distinct_sizes.size(),
+                                          std::vector<double>(block_step));
+  for (size_t start{first}; start < last; start += block_step) {
+    plan->forward(data.subspan(start, std::min(n_fft, data.size() - start)),
+                  spectrum);
+    // Reciprocal norms of the demeaned data windows (running sums)
+    for (size_t j{0}; j < distinct_sizes.size(); ++j) {
+      const size_t width{distinct_sizes[j]};
+      const size_t count{std::min(block_step,
+                                  data.size() >= start + width
+                                      ? data.size() - start - width + 1
+                                      : 0)};
+      double sum{0.0};
+      double sum_sq{0.0};
+      for (size_t k{start}; (k < start + width) && (count > 0); ++k) {
+        sum += data[k];
+        sum_sq += data[k] * data[k];
+      }
+      constexpr double relative_floor{1e-12};
+      const double inverse_width{1.0 / static_cast<double>(width)};
+      for (size_t k{0}; k < count; ++k) {
+        if (k > 0) {
+          const double leaving{data[start + k - 1]};
+          const double entering{data[start + k + width - 1]};
+          sum += entering - leaving;
+          sum_sq += (entering * entering) - (leaving * leaving);
+        }
+        const double energy{sum_sq - (sum * sum * inverse_width)};
+        scales[j][k] = energy > relative_floor * sum_sq
+                           ? 1.0 / std::sqrt(energy)
+                           : 0.0;
+      }
+    }
+    for (size_t i{0}; i < size(); ++i) {
+      if (start >= first + counts[i]) {
+        continue;
+      }
+      const std::vector<complex> &kernel{spectra[i]};
+      for (size_t k{0}; k < product.size(); ++k) {
+        product[k] = complex_multiply(spectrum[k], kernel[k]);
+      }
+      plan->inverse(product, result);
+      const std::vector<double> &scale{scales[size_index[i]]};
+      const size_t offset{start - first};
+      const size_t count{std::min(block_step, counts[i] - offset)};
+      for (size_t k{0}; k < count; ++k) {
+        outputs[i][offset + k] = result[k] * scale[k];
+      }
+    }
+  }
+}
+
+/*!
+  \brief Normalized cross-correlation of every template (all lags).
+
+  @param[in] data std::span<const double> Data.
+  @returns std::vector<std::vector<double>> One correlation per template
+  (template_bank::lags values each).
+ */
+std::vector<std::vector<double>>
+template_bank::correlate(std::span<const double> data) const {
+  std::vector<std::vector<double>> result(size());
+  std::vector<std::span<double>> outputs{};
+  for (size_t i{0}; i < size(); ++i) {
+    result[i].resize(lags(data.size(), i));
+    outputs.emplace_back(result[i]);
+  }
+  correlate(data, outputs);
+  return result;
+}
+
+/*!
+  \brief Normalized cross-correlation of a template bank with many data
+  vectors.
+
+  Each data vector is split into ranges of ::xcorr_chunk_blocks overlap-save
+  blocks, and the ranges are correlated in parallel (parallel_for).
+
+  @param[in] bank template_bank Templates.
+  @param[in] traces std::span<const std::span<const double>> Data vectors.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<std::vector<std::vector<double>>> Correlations, indexed
+  [trace][template][lag].
+ */
+std::vector<std::vector<std::vector<double>>>
+correlate(const template_bank &bank,
+          std::span<const std::span<const double>> traces,
+          const size_t threads) {
+  std::vector<std::vector<std::vector<double>>> result(traces.size());
+  // Work items (trace, first lag)
+  std::vector<std::pair<size_t, size_t>> items{};
+  const size_t chunk{bank.step() * xcorr_chunk_blocks};
+  for (size_t trace{0}; trace < traces.size(); ++trace) {
+    size_t most{0};
+    for (size_t i{0}; i < bank.size(); ++i) {
+      result[trace].emplace_back(bank.lags(traces[trace].size(), i));
+      most = std::max(most, result[trace].back().size());
+    }
+    for (size_t first{0}; first < most; first += chunk) {
+      items.emplace_back(trace, first);
+    }
+  }
+  parallel_for(
+      items.size(),
+      [&](const size_t item) {
+        const auto [trace, first] = items[item];
+        std::vector<std::span<double>> outputs{};
+        for (std::vector<double> &output : result[trace]) {
+          const size_t begin{std::min(first, output.size())};
+          outputs.emplace_back(std::span<double>{output}.subspan(
+              begin, std::min(chunk, output.size() - begin)));
+        }
+        bank.correlate(traces[trace], outputs, first);
+      },
+      threads);
+  return result;
+}
+
+/*!
+  \brief Normalized cross-correlation of a template bank with many Traces.
+
+  @param[in] bank template_bank Templates.
+  @param[in] traces std::span<const Trace> Traces (data1 is correlated).
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<std::vector<std::vector<double>>> Correlations, indexed
+  [trace][template][lag].
+ */
+std::vector<std::vector<std::vector<double>>>
+correlate(const template_bank &bank, std::span<const Trace> traces,
+          const size_t threads) {
+  std::vector<std::span<const double>> data{};
+  data.reserve(traces.size());
+  for (const Trace &trace : traces) {
+    data.push_back(trace.data1_view());
+  }
+  return correlate(bank, data, threads);
+}
+//-----------------------------------------------------------------------------
+// Triggering
+//-----------------------------------------------------------------------------
+/*!
+  \brief Prepare a streaming STA/LTA.
+
+  @param[in] n_sta size_t Short-term window (samples).
+  @param[in] n_lta size_t Long-term window (samples, larger than n_sta).
+  @param[in] method sta_lta_method Averaging method.
+  @param[in] channels size_t Number of channels (interleaved in each chunk).
+  @throw processing_error If a window or the number of channels is zero, or
+  n_sta is not less than n_lta.
+ */
+sta_lta::sta_lta(const size_t n_sta, const size_t n_lta,
+                 const sta_lta_method method, const size_t channels)
+    : n_channels{channels}, short_window{n_sta}, long_window{n_lta},
+      type{method} {
+  if ((n_sta == 0) || (n_lta <= n_sta)) {
+    throw processing_error(
+        "STA/LTA windows must satisfy 0 < short window < long window.");
+  }
+  if (channels == 0) {
+    throw processing_error("STA/LTA needs at least one channel.");
+  }
+  short_term.resize(n_channels, 0.0);
+  long_term.resize(n_channels, 0.0);
+  if (type == sta_lta_method::classic) {
+    energies.resize(long_window * n_channels, 0.0);
+  }
+}
+
+/*!
+  \brief Number of channels.
+
+  @returns size_t Number of channels.
+ */
+size_t sta_lta::channels() const noexcept { return n_channels; }
+
+/*!
+  \brief Samples processed (per channel) since construction or reset.
+
+  @returns size_t Samples processed.
+ */
+size_t sta_lta::samples() const noexcept { return count; }
+
+/*!
+  \brief Characteristic function of the next chunk.
+
+  The classic method keeps running sums of the energy over the windows (one
+  addition and subtraction per sample); the sums are recomputed from the ring
+  once per long window so rounding does not accumulate.
+
+  @param[in] input std::span<const double> Chunk (sample-major, channels
+  values per sample; a partial last sample is ignored).
+  @param[out] ratio std::span<double> STA/LTA (same layout as input).
+ */
+void sta_lta::process(std::span<const double> input,
+                      std::span<double> ratio) noexcept {
+  const size_t n_samples{std::min(input.size(), ratio.size()) / n_channels};
+  const double short_scale{1.0 / static_cast<double>(short_window)};
+  const double long_scale{1.0 / static_cast<double>(long_window)};
+  const double scale{static_cast<double>(long_window) /
+                     static_cast<double>(short_window)};
+  for (size_t i{0}; i < n_samples; ++i, ++count) {
+    const std::span<const double> values{
+        input.subspan(i * n_channels, n_channels)};
+    const std::span<double> output{ratio.subspan(i * n_channels, n_channels)};
+    if (type == sta_lta_method::classic) {
+      const size_t slot{count % long_window};
+      if ((slot == 0) && (count > 0)) {
+        // Exact sums (the ring holds the last long_window energies)
+        std::fill(short_term.begin(), short_term.end(), 0.0);
+        std::fill(long_term.begin(), long_term.end(), 0.0);
+        for (size_t j{0}; j < long_window; ++j) {
+          const std::span<const double> energy{
+              std::span<const double>{energies}.subspan(j * n_channels,
+                                                        n_channels)};
+          const bool in_short{j >= long_window - short_window};
+          for (size_t channel{0}; channel < n_channels; ++channel) {
+            long_term[channel] += energy[channel];
+            short_term[channel] += in_short ? energy[channel] : 0.0;
+          }
+        }
+      }
+      // Slots not yet written are 0
+      const std::span<double> newest{
+          std::span<double>{energies}.subspan(slot * n_channels, n_channels)};
+      const std::span<const double> leaving{
+          std::span<const double>{energies}.subspan(
+              ((count + long_window - short_window) % long_window) *
+                  n_channels,
+              n_channels)};
+      for (size_t channel{0}; channel < n_channels; ++channel) {
+        const double energy{values[channel] * values[channel]};
+        short_term[channel] += energy - leaving[channel];
+        long_term[channel] += energy - newest[channel];
+        newest[channel] = energy;
+        output[channel] = long_term[channel] > 0.0
+                              ? scale * short_term[channel] / long_term[channel]
+                              : 0.0;
+      }
+    } else {
+      for (size_t channel{0}; channel < n_channels; ++channel) {
+        const double energy{values[channel] * values[channel]};
+        short_term[channel] += short_scale * (energy - short_term[channel]);
+        long_term[channel] += long_scale * (energy - long_term[channel]);
+        output[channel] = long_term[channel] > 0.0
+                              ? short_term[channel] / long_term[channel]
+                              : 0.0;
+      }
+    }
+    if (count + 1 < long_window) {
+      std::fill(output.begin(), output.end(), 0.0);
+    }
+  }
+}
+
+/*!
+  \brief Forget all previous data.
+ */
+void sta_lta::reset() noexcept {
+  count = 0;
+  std::fill(short_term.begin(), short_term.end(), 0.0);
+  std::fill(long_term.begin(), long_term.end(), 0.0);
+  std::fill(energies.begin(), energies.end(), 0.0);
+}
+
+/*!
+  \brief Prepare a streaming trigger.
+
+  @param[in] on double Trigger-on threshold.
+  @param[in] off double Trigger-off threshold (at most on).
+  @throw processing_error If off is greater than on.
+ */
+trigger::trigger(const double on, const double off)
+    : on_threshold{on}, off_threshold{off} {
+  if (!(off <= on)) {
+    throw processing_error("Trigger-off threshold must not exceed trigger-on.");
+  }
+}
+
+/*!
+  \brief Trigger window open.
+
+  @returns bool True if a window is open.
+ */
+bool trigger::active() const noexcept { return is_on; }
+
+/*!
+  \brief Scan the next chunk of a characteristic function.
+
+  @param[in] ratio std::span<const double> Characteristic function.
+  @param[in,out] windows std::vector<trigger_window>* Completed windows are
+  appended.
+ */
+void trigger::scan(std::span<const double> ratio,
+                   std::vector<trigger_window> *windows) {
+  for (const double value : ratio) {
+    if (!is_on && (value >= on_threshold)) {
+      is_on = true;
+      onset = position;
+    } else if (is_on && (value < off_threshold)) {
+      windows->push_back({onset, position});
+      is_on = false;
+    }
+    ++position;
+  }
+}
+
+/*!
+  \brief Close an open window at the end of the data.
+
+  @param[in,out] windows std::vector<trigger_window>* The open window (if
+  any) is appended, ending after the last scanned sample.
+ */
+void trigger::finish(std::vector<trigger_window> *windows) {
+  if (is_on) {
+    windows->push_back({onset, position});
+    is_on = false;
+  }
+}
+
+/*!
+  \brief STA/LTA characteristic function of a Trace.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] spec sta_lta_spec Specification (windows rounded to samples).
+  @returns std::vector<double> STA/LTA (one value per sample).
+  @throw processing_error If the Trace is not an evenly-sampled time-series,
+  or the windows are invalid.
+ */
+std::vector<double> sta_lta_ratio(const Trace &trace,
+                                  const sta_lta_spec &spec) {
+  check_time_series(trace);
+  const auto samples = [&trace](const double seconds) {
+    if (!(seconds > 0.0)) {
+      throw processing_error("STA/LTA windows must be positive.");
+    }
+    return static_cast<size_t>(
+        std::max(1.0, std::round(seconds / trace.delta())));
+  };
+  sta_lta detector{samples(spec.sta), samples(spec.lta), spec.method};
+  const std::span<const double> data{trace.data1_view()};
+  std::vector<double> result(data.size());
+  detector.process(data, result);
+  return result;
+}
+
+/*!
+  \brief STA/LTA trigger windows of a Trace.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] spec sta_lta_spec Specification.
+  @returns std::vector<trigger_window> Trigger windows (sample indices; a
+  window still open at the end closes at npts).
+  @throw processing_error If the Trace is not an evenly-sampled time-series,
+  or the specification is invalid.
+ */
+std::vector<trigger_window> detect_triggers(const Trace &trace,
+                                            const sta_lta_spec &spec) {
+  trigger detector{spec.on, spec.off};
+  const std::vector<double> ratio{sta_lta_ratio(trace, spec)};
+  std::vector<trigger_window> result{};
+  detector.scan(ratio, &result);
+  detector.finish(&result);
+  return result;
+}
+
+/*!
+  \brief Write a pick to the pick headers.
+
+  @param[in,out] trace Trace* Trace.
+  @param[in] marker time_marker Pick header (t0 to t9; the matching kt0 to
+  kt9 holds the label).
+  @param[in] time double Pick time (like b).
+  @param[in] label std::string Pick label (at most 8 characters are kept when
+  written).
+  @throw processing_error If the marker is not t0 to t9.
+ */
+void write_pick(Trace *trace, const time_marker marker, const double time,
+                const std::string &label) {
+  // Wraps around for b, o, and a
+  const size_t index{static_cast<size_t>(marker) -
+                     static_cast<size_t>(time_marker::t0)};
+  if (index >= max_picks) {
+    throw processing_error("Picks are written to t0 to t9.");
+  }
+  using time_setter = void (Trace::*)(double) noexcept;
+  using label_setter = void (Trace::*)(const std::string &) noexcept;
+  constexpr std::array<time_setter, max_picks> times{
+      &Trace::t0, &Trace::t1, &Trace::t2, &Trace::t3, &Trace::t4,
+      &Trace::t5, &Trace::t6, &Trace::t7, &Trace::t8, &Trace::t9};
+  constexpr std::array<label_setter, max_picks> labels{
+      &Trace::kt0, &Trace::kt1, &Trace::kt2, &Trace::kt3, &Trace::kt4,
+      &Trace::kt5, &Trace::kt6, &Trace::kt7, &Trace::kt8, &Trace::kt9};
+  (trace->*times[index])(time);
+  (trace->*labels[index])(label);
+}
+
+/*!
+  \brief Write trigger onsets to the pick headers.
+
+  Onset i (at most ::max_picks) is written to ti as b + on * delta (b = 0 if
+  unset) with kti = label.
+
+  @param[in,out] trace Trace* Trace.
+  @param[in] windows std::span<const trigger_window> Trigger windows.
+  @param[in] label std::string Pick label (at most 8 characters are kept when
+  written).
+  @returns size_t Number of onsets written.
+ */
+size_t write_onsets(Trace *trace, std::span<const trigger_window> windows,
+                    const std::string &label) {
+  const double begin{trace->b() != unset_double ? trace->b() : 0.0};
+  const size_t count{std::min(windows.size(), max_picks)};
+  for (size_t i{0}; i < count; ++i) {
+    write_pick(trace,
+               static_cast<time_marker>(
+                   static_cast<size_t>(time_marker::t0) + i),
+               begin + (static_cast<double>(windows[i].on) * trace->delta()),
+               label);
+  }
+  return count;
+}
+
+/*!
+  \brief Station key (knetwk.kstnm).
+
+  @param[in] trace Trace Trace.
+  @returns std::string Station key (network and station).
+ */
+std::string station_key(const Trace &trace) {
+  return trace.knetwk() + '.' + trace.kstnm();
+}
+
+/*!
+  \brief Trigger windows of a Trace in absolute time.
+
+  Sample i is at reference_epoch() + b + (i * delta).
+
+  @param[in] trace Trace Evenly-sampled time-series Trace.
+  @param[in] windows std::span<const trigger_window> Trigger windows (sample
+  indices).
+  @returns std::vector<timed_trigger> Triggers (station and channel keys from
+  knetwk, kstnm, and kcmpnm).
+  @throw processing_error If the Trace is not an evenly-sampled time-series,
+  or its reference time is not set.
+ */
+std::vector<timed_trigger> timed_triggers(
+    const Trace &trace, std::span<const trigger_window> windows) {
+  check_time_series(trace);
+  const double reference{trace.reference_epoch()};
+  if (reference == unset_double) {
+    throw processing_error("Trace reference time is not set.");
+  }
+  const double begin{reference +
+                     (trace.b() != unset_double ? trace.b() : 0.0)};
+  const std::string station{station_key(trace)};
+  const std::string channel{station + '.' + trace.kcmpnm()};
+  std::vector<timed_trigger> result{};
+  result.reserve(windows.size());
+  for (const trigger_window &window : windows) {
+    result.push_back(
+        {station, channel,
+         begin + (static_cast<double>(window.on) * trace.delta()),
+         begin + (static_cast<double>(window.off) * trace.delta())});
+  }
+  return result;
+}
+
+/*!
+  \brief Network coincidence events.
+
+  Each trigger covers [on, max(off, on + window)). The start and end times of
+  all triggers are sorted once and swept in order while keeping, per station,
+  the number of covering triggers; the weighted count of covered stations
+  (each station counts once, whatever its number of channels) changes only
+  when a station becomes covered or uncovered. An event lasts while the count
+  is at least the threshold. The cost is O(n log n) for n triggers.
+
+  @param[in] triggers std::span<const timed_trigger> Triggers (any order).
+  @param[in] spec coincidence_spec Specification.
+  @returns std::vector<coincidence_event> Events in time order.
+  @throw processing_error If the threshold is not positive or the window is
+  negative.
+ */
+std::vector<coincidence_event>
+coincidence(std::span<const timed_trigger> triggers,
+            const coincidence_spec &spec) {
+  if (!(spec.threshold > 0.0) || !(spec.window >= 0.0)) {
+    throw processing_error(
+        "Coincidence threshold must be positive and window non-negative.");
+  }
+  // Stations
+  std::unordered_map<std::string, size_t> station_index{};
+  std::vector<std::string> stations{};
+  std::vector<double> weights{};
+  // Sweep points (time, station, start), ends before starts at equal times
+  struct sweep_point {
+    double time{};
+    size_t station{};
+    bool start{};
+  };
+  std::vector<sweep_point> points{};
+  points.reserve(2 * triggers.size());
+  for (const timed_trigger &item : triggers) {
+    const auto [found, added] =
+        station_index.try_emplace(item.station, stations.size());
+    if (added) {
+      stations.push_back(item.station);
+      const auto weight{spec.weights.find(item.station)};
+      weights.push_back(weight != spec.weights.end() ? weight->second : 1.0);
+    }
+    points.push_back({item.on, found->second, true});
+    points.push_back(
+        {std::max(item.off, item.on + spec.window), found->second, false});
+  }
+  std::sort(points.begin(), points.end(),
+            [](const sweep_point &lhs, const sweep_point &rhs) {
+              return (lhs.time < rhs.time) ||
+                     ((lhs.time == rhs.time) && !lhs.start && rhs.start);
+            });
+  // Rounding guard for the running weighted count
+  constexpr double tolerance{1e-9};
+  std::vector<size_t> covering(stations.size(), 0);
+  std::vector<double> covered_since(stations.size(), 0.0);
+  std::vector<bool> in_event(stations.size(), false);
+  std::vector<coincidence_event> result{};
+  double count{0.0};
+  bool active{false};
+  for (const sweep_point &point : points) {
+    const size_t station{point.station};
+    if (point.start) {
+      if (covering[station]++ == 0) {
+        count += weights[station];
+        covered_since[station] = point.time;
+        if (active && !in_event[station]) {
+          in_event[station] = true;
+          result.back().stations.push_back(stations[station]);
+        }
+      }
+    } else if (--covering[station] == 0) {
+      count -= weights[station];
+    }
+    if (!active && (count >= spec.threshold - tolerance)) {
+      active = true;
+      coincidence_event event{point.time, point.time, count, {}};
+      for (size_t i{0}; i < stations.size(); ++i) {
+        if (covering[i] > 0) {
+          event.on = std::min(event.on, covered_since[i]);
+          event.stations.push_back(stations[i]);
+          in_event[i] = true;
+        }
+      }
+      result.push_back(std::move(event));
+    } else if (active && (count < spec.threshold - tolerance)) {
+      active = false;
+      result.back().off = point.time;
+      std::fill(in_event.begin(), in_event.end(), false);
+    } else if (active) {
+      result.back().peak = std::max(result.back().peak, count);
+    }
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Instrument Response
+//-----------------------------------------------------------------------------
+std::map<std::vector<double>, std::shared_ptr<const response_plan>>
+    response_plan::cache{};
+std::deque<std::vector<double>> response_plan::cache_order{};
+std::mutex response_plan::cache_mutex{};
+
+/*!
+  \brief Read a SAC pole-zero file.
+
+  The file has ZEROS n, POLES n, and CONSTANT c lines (any order, keywords
+  are case-insensitive); each ZEROS/POLES line is followed by up to n lines of
+  real and imaginary parts, and the values not listed are zero (at the
+  origin). Text after '*' is a comment. A missing CONSTANT is 1.
+
+  @param[in,out] input std::istream* Input stream.
+  @returns pole_zero Poles, zeros, and constant.
+  @throw io_error If the stream is not a valid pole-zero file.
+ */
+pole_zero read_pole_zero(std::istream *input) {
+  pole_zero result{};
+  std::vector<complex> *current{nullptr};
+  size_t n_zeros{0};
+  size_t n_poles{0};
+  size_t *limit{nullptr};
+  bool found{false};
+  std::string line{};
+  while (std::getline(*input, line)) {
+    line.erase(std::min(line.find('*'), line.size()));
+    std::istringstream tokens{line};
+    std::string word{};
+    if (!(tokens >> word)) {
+      continue;
+    }
+    std::transform(word.begin(), word.end(), word.begin(),
+                   [](const unsigned char letter) {
+                     return static_cast<char>(std::toupper(letter));
+                   });
+    if ((word == "ZEROS") || (word == "POLES")) {
+      const bool zeros{word == "ZEROS"};
+      current = zeros ? &result.zeros : &result.poles;
+      limit = zeros ? &n_zeros : &n_poles;
+      int count{-1};
+      if (!(tokens >> count) || (count < 0) || !current->empty() ||
+          (*limit != 0)) {
+        throw io_error("Invalid or repeated " + word +
+                       " line in pole-zero file.");
+      }
+      *limit = static_cast<size_t>(count);
+      found = true;
+    } else if (word == "CONSTANT") {
+      if (!(tokens >> result.constant)) {
+        throw io_error("Invalid CONSTANT line in pole-zero file.");
+      }
+      current = nullptr;
+    } else {
+      std::istringstream pair{line};
+      double real{0.0};
+      double imag{0.0};
+      if ((current == nullptr) || !(pair >> real >> imag) ||
+          (current->size() >= *limit)) {
+        throw io_error("Unexpected line in pole-zero file: " + line);
+      }
+      current->emplace_back(real, imag);
+    }
+  }
+  if (!found) {
+    throw io_error("Pole-zero file has no ZEROS or POLES.");
+  }
+  result.zeros.resize(n_zeros, complex{0.0, 0.0});
+  result.poles.resize(n_poles, complex{0.0, 0.0});
+  return result;
+}
+
+/*!
+  \brief Read a SAC pole-zero file.
+
+  @param[in] path std::filesystem::path Path to the file.
+  @returns pole_zero Poles, zeros, and constant.
+  @throw io_error If the file cannot be opened or is not a valid pole-zero
+  file.
+ */
+pole_zero read_pole_zero(const std::filesystem::path &path) {
+  std::ifstream file{path};
+  if (!file.is_open()) {
+    throw io_error(path.string() + " cannot be opened to read.");
+  }
+  return read_pole_zero(&file);
+}
+
+/*!
+  \brief Instrument response at a frequency.
+
+  @param[in] pz pole_zero Instrument response.
+  @param[in] frequency double Frequency (Hz).
+  @returns complex \f$H(2\pi if)\f$ (not finite at a pole).
+ */
+complex evaluate_response(const pole_zero &pz,
+                          const double frequency) noexcept {
+  const complex s_value{0.0, 2.0 * std::numbers::pi_v<double> * frequency};
+  complex numerator{pz.constant, 0.0};
+  for (const complex zero : pz.zeros) {
+    numerator = complex_multiply(numerator, s_value - zero);
+  }
+  complex denominator{1.0, 0.0};
+  for (const complex pole : pz.poles) {
+    denominator = complex_multiply(denominator, s_value - pole);
+  }
+  return numerator / denominator;
+}
+
+/*!
+  \brief Prefilter value at a frequency.
+
+  @param[in] prefilter response_prefilter Corners (f4 <= 0 disables it).
+  @param[in] frequency double Frequency (Hz).
+  @returns double Weight (0 to 1).
+ */
+double prefilter_weight(const response_prefilter &prefilter,
+                        const double frequency) noexcept {
+  constexpr double pi{std::numbers::pi_v<double>};
+  if (prefilter.f4 <= 0.0) {
+    return 1.0;
+  }
+  if ((frequency <= prefilter.f1) || (frequency >= prefilter.f4)) {
+    return 0.0;
+  }
+  if (frequency < prefilter.f2) {
+    return 0.5 * (1.0 - std::cos(pi * (frequency - prefilter.f1) /
+                                 (prefilter.f2 - prefilter.f1)));
+  }
+  if (frequency > prefilter.f3) {
+    return 0.5 * (1.0 + std::cos(pi * (frequency - prefilter.f3) /
+                                 (prefilter.f4 - prefilter.f3)));
+  }
+  return 1.0;
+}
+
+/*!
+  \brief Evaluate an inverse instrument response.
+
+  The response is evaluated at the rfft frequencies \f$k/(n\Delta)\f$. Values
+  below the water level (water_level dB below the largest value) are raised to
+  it (keeping their phase), then inverted, multiplied by \f$s\f$ once per
+  derivative (velocity or acceleration), and by the prefilter. Zero response
+  or prefilter values give zero.
+
+  @param[in] pz pole_zero Instrument response.
+  @param[in] n_fft size_t Transform size.
+  @param[in] delta double Sampling interval (seconds).
+  @param[in] prefilter response_prefilter Prefilter corners (Hz).
+  @param[in] output int idisp, ivel, or iacc.
+  @param[in] water_level double Water level (dB; <= 0 disables it).
+  @throw processing_error If the output, size, sampling interval, or
+  prefilter corners are invalid.
+ */
+response_plan::response_plan(const pole_zero &pz, const size_t n_fft,
+                             const double delta,
+                             const response_prefilter &prefilter,
+                             const int output, const double water_level)
+    : n{n_fft} {
+  if ((output != idisp) && (output != ivel) && (output != iacc)) {
+    throw processing_error("Response output must be idisp, ivel, or iacc.");
+  }
+  if ((n_fft == 0) || !(delta > 0.0)) {
+    throw processing_error(
+        "Response size and sampling interval must be positive.");
+  }
+  if ((prefilter.f4 > 0.0) &&
+      !((prefilter.f1 >= 0.0) && (prefilter.f1 < prefilter.f2) &&
+        (prefilter.f2 <= prefilter.f3) && (prefilter.f3 < prefilter.f4))) {
+    throw processing_error(
+        "Prefilter corners must satisfy 0 <= f1 < f2 <= f3 < f4.");
+  }
+  const double frequency_step{1.0 / (static_cast<double>(n_fft) * delta)};
+  inverse.resize((n_fft / 2) + 1);
+  double peak{0.0};
+  for (size_t k{0}; k < inverse.size(); ++k) {
+    inverse[k] =
+        evaluate_response(pz, static_cast<double>(k) * frequency_step);
+    if (std::isfinite(std::abs(inverse[k]))) {
+      peak = std::max(peak, std::abs(inverse[k]));
+    }
+  }
+  const double level{water_level > 0.0
+                         ? peak * std::pow(10.0, -water_level / 20.0)
+                         : 0.0};
+  const int derivatives{output - idisp};
+  for (size_t k{0}; k < inverse.size(); ++k) {
+    const double frequency{static_cast<double>(k) * frequency_step};
+    const double weight{prefilter_weight(prefilter, frequency)};
+    const double magnitude{std::abs(inverse[k])};
+    complex response{inverse[k]};
+    if (magnitude < level) {
+      response = magnitude > 0.0 ? response * (level / magnitude)
+                                 : complex{level, 0.0};
+    }
+    if ((weight == 0.0) || (std::abs(response) == 0.0) ||
+        !std::isfinite(magnitude)) {
+      inverse[k] = complex{0.0, 0.0};
+      continue;
+    }
+    complex value{weight / response};
+    for (int i{0}; i < derivatives; ++i) {
+      value = complex_multiply(
+          value, complex{0.0, 2.0 * std::numbers::pi_v<double> * frequency});
+    }
+    inverse[k] = value;
+  }
+}
+
+/*!
+  \brief Transform size.
+
+  @returns size_t Transform size.
+ */
+size_t response_plan::size() const noexcept { return n; }
+
+/*!
+  \brief Inverse response per bin.
+
+  @returns std::span<const complex> size/2 + 1 values.
+ */
+std::span<const complex> response_plan::values() const noexcept {
+  return inverse;
+}
+
+/*!
+  \brief Multiply a spectrum by the inverse response.
+
+  @param[in,out] spectrum std::span<complex> Spectrum (size/2 + 1 bins; extra
+  values are left unchanged).
+ */
+void response_plan::apply(std::span<complex> spectrum) const noexcept {
+  const size_t bins{std::min(spectrum.size(), inverse.size())};
+  for (size_t k{0}; k < bins; ++k) {
+    spectrum[k] = complex_multiply(spectrum[k], inverse[k]);
+  }
+}
+
+/*!
+  \brief Cached inverse instrument response.
+
+  Plans are keyed by every parameter (so a day of records from one instrument
+  evaluates its response once). The cache keeps at most ::max_cached_responses
+  plans, evicting the oldest first.
+
+  @param[in] pz pole_zero Instrument response.
+  @param[in] n_fft size_t Transform size.
+  @param[in] delta double Sampling interval (seconds).
+  @param[in] prefilter response_prefilter Prefilter corners (Hz).
+  @param[in] output int idisp, ivel, or iacc.
+  @param[in] water_level double Water level (dB; <= 0 disables it).
+  @returns std::shared_ptr<const response_plan> Shared plan.
+  @throw processing_error If the parameters are invalid.
+ */
+std::shared_ptr<const response_plan>
+response_plan::get(const pole_zero &pz, const size_t n_fft, const double delta,
+                   const response_prefilter &prefilter, const int output,
+                   const double water_level) {
+  std::vector<double> key{static_cast<double>(n_fft),
+                          delta,
+                          prefilter.f1,
+                          prefilter.f2,
+                          prefilter.f3,
+                          prefilter.f4,
+                          static_cast<double>(output),
+                          water_level,
+                          pz.constant,
+                          static_cast<double>(pz.zeros.size())};
+  for (const complex zero : pz.zeros) {
+    key.push_back(zero.real());
+    key.push_back(zero.imag());
+  }
+  for (const complex pole : pz.poles) {
+    key.push_back(pole.real());
+    key.push_back(pole.imag());
+  }
+  {
+    const std::scoped_lock lock{cache_mutex};
+    const auto found{cache.find(key)};
+    if (found != cache.end()) {
+      return found->second;
+    }
+  }
+  auto plan{std::make_shared<const response_plan>(pz, n_fft, delta, prefilter,
+                                                  output, water_level)};
+  const std::scoped_lock lock{cache_mutex};
+  const auto [found, inserted]{cache.try_emplace(key, std::move(plan))};
+  std::shared_ptr<const response_plan> result{found->second};
+  if (inserted) {
+    cache_order.push_back(std::move(key));
+    while (cache.size() > max_cached_responses) {
+      cache.erase(cache_order.front());
+      cache_order.pop_front();
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Remove the instrument response from a Trace.
+
+  The data is zero-padded to next_fast_size(npts), transformed, multiplied by
+  the cached inverse response (response_plan::get), and transformed back, in
+  place. Remove the mean/trend and taper first (see preprocess). idep is set
+  to the output and depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] pz pole_zero Instrument response.
+  @param[in] prefilter response_prefilter Prefilter corners (Hz; default
+  none).
+  @param[in] output int idisp (default), ivel, or iacc.
+  @param[in] water_level double Water level (dB below the peak of the
+  response; <= 0 disables it).
+  @throw processing_error If the Trace is not an evenly-sampled time-series
+  or the parameters are invalid.
+ */
+void remove_response(Trace *trace, const pole_zero &pz,
+                     const response_prefilter &prefilter, const int output,
+                     const double water_level) {
+  check_time_series(*trace);
+  const std::span<double> data{trace->data1_view()};
+  const size_t n_fft{next_fast_size(data.size())};
+  const std::shared_ptr<const response_plan> response{response_plan::get(
+      pz, n_fft, trace->delta(), prefilter, output, water_level)};
+  const std::shared_ptr<const rfft_plan> plan{rfft_plan::get(n_fft)};
+  thread_local std::vector<complex> spectrum{};
+  spectrum.resize(plan->bins());
+  plan->forward(data, spectrum);
+  response->apply(spectrum);
+  if (n_fft == data.size()) {
+    plan->inverse(spectrum, data);
+  } else {
+    thread_local std::vector<double> padded{};
+    padded.resize(n_fft);
+    plan->inverse(spectrum, padded);
+    std::copy_n(padded.begin(), data.size(), data.begin());
+  }
+  trace->idep(output);
+  trace->update_stats();
+}
+//-----------------------------------------------------------------------------
+// Merging
+//-----------------------------------------------------------------------------
+/*!
+  \brief Merge pieces of each channel into contiguous Traces.
+
+  Pieces are grouped by channel (knetwk.kstnm.kcmpnm) and sorted by absolute
+  start time (reference time plus b). Sample positions are rounded to the
+  nearest sample of the earliest piece. A first pass finds each output's size
+  and gaps, so its data is allocated once and every sample is written once
+  (twice when averaging), whatever the number of pieces. Because the pieces
+  are sorted, the samples already written from a piece's start onward form a
+  single run, so keeping the first piece only skips the start of the next.
+
+  Empty pieces are ignored. Each output Trace has the headers of its earliest
+  piece with e, npts, and depmin, depmax, and depmen updated. With
+  gap_policy::split, every gap starts a new Trace.
+
+  @param[in] pieces std::span<const Trace> Evenly-sampled time-series Traces
+  (any order, any channels).
+  @param[in] policy merge_policy Overlap and gap handling.
+  @returns std::vector<Trace> Merged Traces (by channel, then time).
+  @throw processing_error If a piece is not an evenly-sampled time-series, its
+  reference time is not set, or pieces of a channel have different sampling
+  intervals.
+ */
+std::vector<Trace> merge(std::span<const Trace> pieces,
+                         const merge_policy &policy) {
+  std::map<std::string, std::vector<size_t>> channels{};
+  std::vector<double> starts(pieces.size());
+  for (size_t i{0}; i < pieces.size(); ++i) {
+    check_time_series(pieces[i]);
+    const double epoch{pieces[i].reference_epoch()};
+    if (epoch == unset_double) {
+      throw processing_error("Trace reference time is not set.");
+    }
+    starts[i] = epoch + pieces[i].b();
+    if (!pieces[i].data1_view().empty()) {
+      channels[station_key(pieces[i]) + '.' + pieces[i].kcmpnm()].push_back(
+          i);
+    }
+  }
+  std::vector<Trace> result{};
+  for (auto &[channel, indices] : channels) {
+    std::stable_sort(indices.begin(), indices.end(),
+                     [&starts](const size_t lhs, const size_t rhs) {
+                       return starts[lhs] < starts[rhs];
+                     });
+    size_t first{0};
+    while (first < indices.size()) {
+      const Trace &head{pieces[indices[first]]};
+      const double delta{head.delta()};
+      // First pass: offsets, size, and gaps
+      std::vector<size_t> offsets{};
+      std::vector<std::pair<size_t, size_t>> gaps{};
+      size_t size{0};
+      size_t last{first};
+      for (; last < indices.size(); ++last) {
+        const Trace &piece{pieces[indices[last]]};
+        if (std::abs(piece.delta() - delta) > merge_delta_tolerance * delta) {
+          throw processing_error("Pieces of " + channel +
+                                 " have different sampling intervals.");
+        }
+        const auto offset{static_cast<size_t>(
+            std::llround((starts[indices[last]] - starts[indices[first]]) /
+                         delta))};
+        if (offset > size) {
+          if (policy.gap == gap_policy::split) {
+            break;
+          }
+          gaps.emplace_back(size, offset);
+        }
+        offsets.push_back(offset);
+        size = std::max(size, offset + piece.data1_view().size());
+      }
+      // Second pass: samples
+      std::vector<double> data(size, 0.0);
+      std::vector<size_t> counts{};
+      if (policy.overlap == overlap_policy::average) {
+        counts.assign(size, 0);
+      }
+      size_t covered{0};
+      for (size_t j{first}; j < last; ++j) {
+        const std::span<const double> values{
+            pieces[indices[j]].data1_view()};
+        const size_t offset{offsets[j - first]};
+        switch (policy.overlap) {
+        case overlap_policy::keep_first: {
+          const size_t skip{
+              std::min(covered > offset ? covered - offset : 0,
+                       values.size())};
+          std::copy(values.begin() + static_cast<std::ptrdiff_t>(skip),
+                    values.end(),
+                    data.begin() + static_cast<std::ptrdiff_t>(offset + skip));
+          break;
+        }
+        case overlap_policy::keep_last:
+          std::copy(values.begin(), values.end(),
+                    data.begin() + static_cast<std::ptrdiff_t>(offset));
+          break;
+        case overlap_policy::average:
+          for (size_t k{0}; k < values.size(); ++k) {
+            data[offset + k] += values[k];
+            ++counts[offset + k];
+          }
+          break;
+        }
+        covered = std::max(covered, offset + values.size());
+      }
+      for (size_t k{0}; k < counts.size(); ++k) {
+        if (counts[k] > 1) {
+          data[k] /= static_cast<double>(counts[k]);
+        }
+      }
+      for (const auto &[begin, end] : gaps) {
+        for (size_t k{begin}; k < end; ++k) {
+          if (policy.gap == gap_policy::nan) {
+            data[k] = std::numeric_limits<double>::quiet_NaN();
+          } else if ((policy.gap == gap_policy::interpolate) && (begin > 0)) {
+            const double fraction{static_cast<double>(k - begin + 1) /
+                                  static_cast<double>(end - begin + 1)};
+            data[k] = data[begin - 1] +
+                      (fraction * (data[end] - data[begin - 1]));
+          }
+        }
+      }
+      Trace merged{head};
+      merged.data1(std::move(data));
+      merged.e(merged.b() + (static_cast<double>(size - 1) * delta));
+      merged.update_stats();
+      result.push_back(std::move(merged));
+      first = last;
+    }
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Rotation
+//-----------------------------------------------------------------------------
+/*!
+  \brief Apply a 2x2 matrix to two components in place.
+
+  \f$(x, y) \leftarrow (m_0x + m_1y, m_2x + m_3y)\f$ in a single pass.
+
+  @param[in,out] first std::span<double> First component.
+  @param[in,out] second std::span<double> Second component (same size).
+  @param[in] matrix std::array<double, 4> Matrix (row-major).
+ */
+void rotate_components(std::span<double> first, std::span<double> second,
+                       const std::array<double, 4> &matrix) noexcept {
+  // Copied, so the compiler knows the output stores cannot change it
+  const std::array<double, 4> coef{matrix};
+  const size_t size{std::min(first.size(), second.size())};
+  double *const x_data{first.data()};
+  double *const y_data{second.data()};
+  for (size_t i{0}; i < size; ++i) {
+    const double x_val{x_data[i]};
+    const double y_val{y_data[i]};
+    x_data[i] = (coef[0] * x_val) + (coef[1] * y_val);
+    y_data[i] = (coef[2] * x_val) + (coef[3] * y_val);
+  }
+}
+
+/*!
+  \brief Apply a 3x3 matrix to three components in place.
+
+  Single pass over the three components.
+
+  @param[in,out] first std::span<double> First component.
+  @param[in,out] second std::span<double> Second component (same size).
+  @param[in,out] third std::span<double> Third component (same size).
+  @param[in] matrix std::array<double, 9> Matrix (row-major).
+ */
+void rotate_components(std::span<double> first, std::span<double> second,
+                       std::span<double> third,
+                       const std::array<double, 9> &matrix) noexcept {
+  const std::array<double, 9> coef{matrix};
+  const size_t size{std::min({first.size(), second.size(), third.size()})};
+  double *const x_data{first.data()};
+  double *const y_data{second.data()};
+  double *const z_data{third.data()};
+  for (size_t i{0}; i < size; ++i) {
+    const double x_val{x_data[i]};
+    const double y_val{y_data[i]};
+    const double z_val{z_data[i]};
+    x_data[i] = (coef[0] * x_val) + (coef[1] * y_val) + (coef[2] * z_val);
+    y_data[i] = (coef[3] * x_val) + (coef[4] * y_val) + (coef[5] * z_val);
+    z_data[i] = (coef[6] * x_val) + (coef[7] * y_val) + (coef[8] * z_val);
+  }
+}
+
+/*!
+  \brief Require aligned components.
+
+  Components are aligned if they are evenly-sampled time-series with the same
+  npts and delta, and start at the same time (reference time plus b, or b if
+  no reference time is set) within ::alignment_tolerance samples.
+
+  @param[in] traces std::span<const Trace *const> Components.
+  @throw processing_error If the components are not aligned.
+ */
+void check_aligned(std::span<const Trace *const> traces) {
+  if (traces.empty()) {
+    return;
+  }
+  const Trace &head{*traces[0]};
+  const double delta{head.delta()};
+  const bool referenced{head.reference_epoch() != unset_double};
+  for (const Trace *const trace : traces) {
+    check_time_series(*trace);
+    if (trace->data1_view().size() != head.data1_view().size()) {
+      throw processing_error("Components have different npts.");
+    }
+    if (std::abs(trace->delta() - delta) > merge_delta_tolerance * delta) {
+      throw processing_error("Components have different sampling intervals.");
+    }
+    const double epoch{trace->reference_epoch()};
+    if ((epoch != unset_double) != referenced) {
+      throw processing_error("Components have mixed reference times.");
+    }
+    const double offset{
+        referenced ? (epoch + trace->b()) - (head.reference_epoch() + head.b())
+                   : trace->b() - head.b()};
+    if (std::abs(offset) > alignment_tolerance * delta) {
+      throw processing_error("Components do not start at the same time.");
+    }
+  }
+}
+
+/*!
+  \brief Set a component's orientation.
+
+  The last character of kcmpnm is replaced by component (kcmpnm is the
+  component alone if unset); cmpaz, cmpinc, and depmin, depmax, and depmen
+  are updated.
+
+  @param[in,out] trace Trace* Component.
+  @param[in] component char Component code.
+  @param[in] azimuth double Azimuth (degrees clockwise from north).
+  @param[in] inclination double Inclination (degrees from vertical up).
+ */
+void orient(Trace *trace, const char component, const double azimuth,
+            const double inclination) noexcept {
+  std::string name{trace->kcmpnm()};
+  if ((name == unset_word) || name.empty()) {
+    name = component;
+  } else {
+    name.back() = component;
+  }
+  trace->kcmpnm(name);
+  trace->cmpaz(static_cast<float>(limit_360(azimuth)));
+  trace->cmpinc(static_cast<float>(inclination));
+  trace->update_stats();
+}
+
+/*!
+  \brief Rotate two horizontal components to radial and transverse.
+
+  The components may have any (non-parallel) azimuths. A single matrix maps
+  them to north/east and on to radial (azimuth baz + 180, away from the
+  source) and transverse (baz + 270), and is applied in a single pass.
+
+  @param[in,out] first Trace* Horizontal component (becomes radial).
+  @param[in,out] second Trace* Horizontal component (becomes transverse).
+  @throw processing_error If the components are not aligned (check_aligned),
+  baz, cmpaz, or cmpinc are not set, or the components are not horizontal or
+  are parallel.
+ */
+void rotate_to_rt(Trace *first, Trace *second) {
+  const std::array<const Trace *, 2> traces{first, second};
+  check_aligned(traces);
+  if (first->baz() == unset_float) {
+    throw processing_error("Back azimuth (baz) is not set.");
+  }
+  std::array<double, 2> azimuths{};
+  for (size_t i{0}; i < traces.size(); ++i) {
+    if ((traces[i]->cmpaz() == unset_float) ||
+        (traces[i]->cmpinc() == unset_float)) {
+      throw processing_error("Component orientation (cmpaz, cmpinc) is not "
+                             "set.");
+    }
+    if (std::abs(traces[i]->cmpinc() - 90.0) > horizontal_tolerance) {
+      throw processing_error("Components are not horizontal.");
+    }
+    azimuths[i] = traces[i]->cmpaz() * rad_per_deg;
+  }
+  const double determinant{std::sin(azimuths[1] - azimuths[0])};
+  if (std::abs(determinant) < 1e-6) {
+    throw processing_error("Components are parallel.");
+  }
+  // Inverse of the component directions (north, east)
+  const std::array<double, 4> inverse{std::sin(azimuths[1]) / determinant,
+                                      -std::sin(azimuths[0]) / determinant,
+                                      -std::cos(azimuths[1]) / determinant,
+                                      std::cos(azimuths[0]) / determinant};
+  const double baz{first->baz()};
+  const double radial{(baz + 180.0) * rad_per_deg};
+  const double transverse{(baz + 270.0) * rad_per_deg};
+  const std::array<double, 4> output{std::cos(radial), std::sin(radial),
+                                     std::cos(transverse),
+                                     std::sin(transverse)};
+  std::array<double, 4> matrix{};
+  for (size_t row{0}; row < 2; ++row) {
+    for (size_t col{0}; col < 2; ++col) {
+      matrix[(row * 2) + col] = (output[row * 2] * inverse[col]) +
+                                (output[(row * 2) + 1] * inverse[2 + col]);
+    }
+  }
+  rotate_components(first->data1_view(), second->data1_view(), matrix);
+  orient(first, 'R', baz + 180.0, 90.0);
+  orient(second, 'T', baz + 270.0, 90.0);
+}
+
+/*!
+  \brief Rotate three components to L, Q, and T.
+
+  The components may have any (independent) orientations. With incidence
+  \f$i\f$ and back azimuth \f$\beta\f$, L points along the ray (up and away
+  from the source), Q is perpendicular to it in the ray plane, and T is the
+  transverse component of rotate_to_rt:
+
+  \f{eqnarray*}{
+  L &=& Z\cos i - (N\cos\beta + E\sin\beta)\sin i\\
+  Q &=& Z\sin i + (N\cos\beta + E\sin\beta)\cos i\\
+  T &=& N\sin\beta - E\cos\beta
+  \f}
+
+  A single matrix (component directions inverted, then projected) is applied
+  in a single pass.
+
+  @param[in,out] first Trace* Component (becomes L).
+  @param[in,out] second Trace* Component (becomes Q).
+  @param[in,out] third Trace* Component (becomes T).
+  @param[in] incidence double Incidence angle (degrees from vertical).
+  @throw processing_error If the components are not aligned (check_aligned),
+  baz, cmpaz, or cmpinc are not set, or the components are not independent.
+ */
+void rotate_to_lqt(Trace *first, Trace *second, Trace *third,
+                   const double incidence) {
+  const std::array<const Trace *, 3> traces{first, second, third};
+  check_aligned(traces);
+  if (first->baz() == unset_float) {
+    throw processing_error("Back azimuth (baz) is not set.");
+  }
+  // Component directions (rows: Z, N, E)
+  std::array<double, 9> directions{};
+  for (size_t i{0}; i < traces.size(); ++i) {
+    if ((traces[i]->cmpaz() == unset_float) ||
+        (traces[i]->cmpinc() == unset_float)) {
+      throw processing_error("Component orientation (cmpaz, cmpinc) is not "
+                             "set.");
+    }
+    const double azimuth{traces[i]->cmpaz() * rad_per_deg};
+    const double inclination{traces[i]->cmpinc() * rad_per_deg};
+    directions[i * 3] = std::cos(inclination);
+    directions[(i * 3) + 1] = std::sin(inclination) * std::cos(azimuth);
+    directions[(i * 3) + 2] = std::sin(inclination) * std::sin(azimuth);
+  }
+  const std::array<double, 9> &dir{directions};
+  // Adjugate (transposed cofactors)
+  const std::array<double, 9> adjugate{
+      (dir[4] * dir[8]) - (dir[5] * dir[7]),
+      (dir[2] * dir[7]) - (dir[1] * dir[8]),
+      (dir[1] * dir[5]) - (dir[2] * dir[4]),
+      (dir[5] * dir[6]) - (dir[3] * dir[8]),
+      (dir[0] * dir[8]) - (dir[2] * dir[6]),
+      (dir[2] * dir[3]) - (dir[0] * dir[5]),
+      (dir[3] * dir[7]) - (dir[4] * dir[6]),
+      (dir[1] * dir[6]) - (dir[0] * dir[7]),
+      (dir[0] * dir[4]) - (dir[1] * dir[3])};
+  const double determinant{(dir[0] * adjugate[0]) + (dir[1] * adjugate[3]) +
+                           (dir[2] * adjugate[6])};
+  if (std::abs(determinant) < 1e-6) {
+    throw processing_error("Components are not independent.");
+  }
+  const double baz{first->baz()};
+  const double beta{baz * rad_per_deg};
+  const double ray{incidence * rad_per_deg};
+  const std::array<double, 9> output{
+      std::cos(ray),
+      -std::sin(ray) * std::cos(beta),
+      -std::sin(ray) * std::sin(beta),
+      std::sin(ray),
+      std::cos(ray) * std::cos(beta),
+      std::cos(ray) * std::sin(beta),
+      0.0,
+      std::sin(beta),
+      -std::cos(beta)};
+  std::array<double, 9> matrix{};
+  for (size_t row{0}; row < 3; ++row) {
+    for (size_t col{0}; col < 3; ++col) {
+      double sum{0.0};
+      for (size_t k{0}; k < 3; ++k) {
+        sum += output[(row * 3) + k] * adjugate[(k * 3) + col];
+      }
+      matrix[(row * 3) + col] = sum / determinant;
+    }
+  }
+  rotate_components(first->data1_view(), second->data1_view(),
+                    third->data1_view(), matrix);
+  orient(first, 'L', baz + 180.0, incidence);
+  orient(second, 'Q', baz, 90.0 - incidence);
+  orient(third, 'T', baz + 270.0, 90.0);
+}
+//-----------------------------------------------------------------------------
+// Integration and Differentiation
+//-----------------------------------------------------------------------------
+/*!
+  \brief Integrate in place.
+
+  Trapezoid: \f$y_i = y_{i-1} + \Delta(x_i + x_{i+1})/2\f$ (npts - 1 values,
+  at the midpoints of the samples). Rectangle: \f$y_i = y_{i-1} + \Delta
+  x_i\f$ (npts values). Every value is read before it is overwritten, so a
+  single pass needs no copy.
+
+  @param[in,out] data std::span<double> Data (the first values are replaced
+  by the integral).
+  @param[in] delta double Sampling interval.
+  @param[in] method integration_method Method.
+  @returns size_t Number of values of the integral.
+ */
+size_t integrate(std::span<double> data, const double delta,
+                 const integration_method method) noexcept {
+  const size_t size{data.size()};
+  double sum{0.0};
+  if (method == integration_method::rectangle) {
+    for (size_t i{0}; i < size; ++i) {
+      sum += delta * data[i];
+      data[i] = sum;
+    }
+    return size;
+  }
+  if (size < 2) {
+    return 0;
+  }
+  const double half{0.5 * delta};
+  double previous{data[0]};
+  for (size_t i{0}; i + 1 < size; ++i) {
+    const double next{data[i + 1]};
+    sum += half * (previous + next);
+    data[i] = sum;
+    previous = next;
+  }
+  return size - 1;
+}
+
+/*!
+  \brief Differentiate in place.
+
+  Central: \f$y_i = (x_{i+2} - x_i)/(2\Delta)\f$ (npts - 2 values, centered on
+  the second to next-to-last samples). Five-point: \f$y_i = (x_i - 8x_{i+1} +
+  8x_{i+3} - x_{i+4})/(12\Delta)\f$ (npts - 4 values). Each output only reads
+  values at or after its own position, so a single forward pass needs no copy
+  (and vectorizes).
+
+  @param[in,out] data std::span<double> Data (the first values are replaced
+  by the derivative).
+  @param[in] delta double Sampling interval.
+  @param[in] method difference_method Method.
+  @returns size_t Number of values of the derivative (0 if there are too few
+  samples).
+ */
+size_t differentiate(std::span<double> data, const double delta,
+                     const difference_method method) noexcept {
+  const size_t width{method == difference_method::central ? 2UL : 4UL};
+  if (data.size() <= width) {
+    return 0;
+  }
+  const size_t size{data.size() - width};
+  double *const values{data.data()};
+  if (method == difference_method::central) {
+    const double scale{1.0 / (2.0 * delta)};
+    for (size_t i{0}; i < size; ++i) {
+      values[i] = (values[i + 2] - values[i]) * scale;
+    }
+    return size;
+  }
+  const double scale{1.0 / (12.0 * delta)};
+  for (size_t i{0}; i < size; ++i) {
+    values[i] = ((values[i] - values[i + 4]) +
+                 (8.0 * (values[i + 3] - values[i + 1]))) *
+                scale;
+  }
+  return size;
+}
+
+/*!
+  \brief Integrate a Trace.
+
+  data1 is integrated in place; b (trapezoid: by half a sample), e, npts,
+  depmin, depmax, and depmen are updated. idep goes from acceleration to
+  velocity, from velocity to displacement, and otherwise (if set) to unknown.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] method integration_method Method (default trapezoid).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  has too few samples.
+ */
+void integrate(Trace *trace, const integration_method method) {
+  check_time_series(*trace);
+  const double delta{trace->delta()};
+  const size_t size{integrate(trace->data1_view(), delta, method)};
+  if (size == 0) {
+    throw processing_error("Trace has too few samples to integrate.");
+  }
+  trace->npts(static_cast<int>(size));
+  if (method == integration_method::trapezoid) {
+    trace->b(trace->b() + (0.5 * delta));
+  }
+  trace->e(trace->b() + (static_cast<double>(size - 1) * delta));
+  const int idep{trace->idep()};
+  if (idep == iacc) {
+    trace->idep(ivel);
+  } else if (idep == ivel) {
+    trace->idep(idisp);
+  } else if (idep != unset_int) {
+    trace->idep(iunkn);
+  }
+  trace->update_stats();
+}
+
+/*!
+  \brief Differentiate a Trace.
+
+  data1 is differentiated in place; b (by one or two samples), e, npts,
+  depmin, depmax, and depmen are updated. idep goes from displacement to
+  velocity, from velocity to acceleration, and otherwise (if set) to unknown.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace.
+  @param[in] method difference_method Method (default central).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  has too few samples.
+ */
+void differentiate(Trace *trace, const difference_method method) {
+  check_time_series(*trace);
+  const double delta{trace->delta()};
+  const size_t size{differentiate(trace->data1_view(), delta, method)};
+  if (size == 0) {
+    throw processing_error("Trace has too few samples to differentiate.");
+  }
+  trace->npts(static_cast<int>(size));
+  const double shift{method == difference_method::central ? 1.0 : 2.0};
+  trace->b(trace->b() + (shift * delta));
+  trace->e(trace->b() + (static_cast<double>(size - 1) * delta));
+  const int idep{trace->idep()};
+  if (idep == idisp) {
+    trace->idep(ivel);
+  } else if (idep == ivel) {
+    trace->idep(iacc);
+  } else if (idep != unset_int) {
+    trace->idep(iunkn);
+  }
+  trace->update_stats();
+}
+//-----------------------------------------------------------------------------
+// Spectral Analysis
+//-----------------------------------------------------------------------------
+/*!
+  \brief Prepare short-time Fourier transform framing.
+
+  @param[in] window size_t Frame length (samples).
+  @param[in] overlap size_t Overlap between frames (samples, less than
+  window).
+  @param[in] n_fft size_t Transform size (0 = window; at least window).
+  @param[in] taper taper_window Window shape (over the whole frame).
+  @throw processing_error If window is zero, overlap is not less than window,
+  or n_fft is less than window.
+ */
+spectrogram_plan::spectrogram_plan(const size_t window, const size_t overlap,
+                                   const size_t n_fft,
+                                   const taper_window taper)
+    : length{window}, hop{window - overlap} {
+  const size_t transform{n_fft == 0 ? window : n_fft};
+  if ((window == 0) || (overlap >= window) || (transform < window)) {
+    throw processing_error("Spectrogram must satisfy 0 <= overlap < window "
+                           "<= n_fft.");
+  }
+  constexpr double pi{std::numbers::pi_v<double>};
+  weights.resize(window);
+  double power{0.0};
+  for (size_t j{0}; j < window; ++j) {
+    const double phase{pi * static_cast<double>(j) /
+                       static_cast<double>(window)};
+    switch (taper) {
+    case taper_window::hann:
+      weights[j] = 0.5 - (0.5 * std::cos(2.0 * phase));
+      break;
+    case taper_window::hamming:
+      weights[j] = 0.54 - (0.46 * std::cos(2.0 * phase));
+      break;
+    case taper_window::cosine:
+      weights[j] = std::sin(phase);
+      break;
+    }
+    power += weights[j] * weights[j];
+  }
+  plan = rfft_plan::get(transform);
+  // One-sided: all but DC and Nyquist doubled
+  scales.assign(plan->bins(), 2.0 / power);
+  scales.front() = 1.0 / power;
+  if (transform % 2 == 0) {
+    scales.back() = 1.0 / power;
+  }
+}
+
+/*!
+  \brief Frame length.
+
+  @returns size_t Window length (samples).
+ */
+size_t spectrogram_plan::window() const noexcept { return length; }
+
+/*!
+  \brief Step between frames.
+
+  @returns size_t window - overlap (samples).
+ */
+size_t spectrogram_plan::step() const noexcept { return hop; }
+
+/*!
+  \brief Transform size.
+
+  @returns size_t Transform size.
+ */
+size_t spectrogram_plan::size() const noexcept { return plan->size(); }
+
+/*!
+  \brief Number of frequencies.
+
+  @returns size_t size/2 + 1.
+ */
+size_t spectrogram_plan::bins() const noexcept { return plan->bins(); }
+
+/*!
+  \brief Number of (complete) frames.
+
+  @param[in] samples size_t Number of samples.
+  @returns size_t Number of frames (0 if samples < window).
+ */
+size_t spectrogram_plan::frames(const size_t samples) const noexcept {
+  return samples < length ? 0 : 1 + ((samples - length) / hop);
+}
+
+/*!
+  \brief Power spectral density of one frame.
+
+  @param[in] segment std::span<const double> Frame (window samples).
+  @param[in] scale double Extra scale (delta, divided by the frames averaged).
+  @param[in,out] row std::span<double> PSD (bins values).
+  @param[in] accumulate bool Add to row instead of overwriting it.
+ */
+void spectrogram_plan::frame_power(std::span<const double> segment,
+                                   const double scale, std::span<double> row,
+                                   const bool accumulate) const {
+  thread_local std::vector<double> frame{};
+  thread_local std::vector<complex> spectrum{};
+  frame.resize(plan->size());
+  spectrum.resize(plan->bins());
+  double sum{0.0};
+  for (const double value : segment) {
+    sum += value;
+  }
+  const double mean{sum / static_cast<double>(length)};
+  for (size_t j{0}; j < length; ++j) {
+    frame[j] = (segment[j] - mean) * weights[j];
+  }
+  // Zero-padding (the workspace is shared by plans of different sizes)
+  std::fill(frame.begin() + static_cast<std::ptrdiff_t>(length), frame.end(),
+            0.0);
+  plan->forward(frame, spectrum);
+  for (size_t k{0}; k < row.size(); ++k) {
+    const double value{std::norm(spectrum[k]) * scales[k] * scale};
+    row[k] = accumulate ? row[k] + value : value;
+  }
+}
+
+/*!
+  \brief Power spectral density of every frame.
+
+  One-sided density: \f$2\Delta|X_k|^2/\sum w_j^2\f$ (DC and Nyquist not
+  doubled), so the sum over the bins times the frequency step is the mean
+  square of the tapered frame relative to the taper.
+
+  @param[in] data std::span<const double> Data.
+  @param[in] delta double Sampling interval.
+  @param[out] output std::span<double> PSD (frames(data.size()) x bins(),
+  row-major).
+  @throw processing_error If output is too small.
+ */
+void spectrogram_plan::apply(std::span<const double> data, const double delta,
+                             std::span<double> output) const {
+  const size_t n_frames{frames(data.size())};
+  const size_t n_bins{bins()};
+  if (output.size() < n_frames * n_bins) {
+    throw processing_error("Spectrogram output is too small.");
+  }
+  for (size_t index{0}; index < n_frames; ++index) {
+    frame_power(data.subspan(index * hop, length), delta,
+                output.subspan(index * n_bins, n_bins), false);
+  }
+}
+
+/*!
+  \brief Mean power spectral density of the frames (Welch's method).
+
+  Frames are accumulated into output one at a time, so no per-frame storage
+  is needed.
+
+  @param[in] data std::span<const double> Data.
+  @param[in] delta double Sampling interval.
+  @param[out] output std::span<double> Mean PSD (bins() values; zero if there
+  are no frames).
+  @returns size_t Number of frames averaged.
+  @throw processing_error If output is too small.
+ */
+size_t spectrogram_plan::average(std::span<const double> data,
+                                 const double delta,
+                                 std::span<double> output) const {
+  const size_t n_frames{frames(data.size())};
+  const size_t n_bins{bins()};
+  if (output.size() < n_bins) {
+    throw processing_error("Spectrogram output is too small.");
+  }
+  const std::span<double> row{output.first(n_bins)};
+  std::ranges::fill(row, 0.0);
+  const double scale{n_frames == 0 ? 0.0
+                                   : delta / static_cast<double>(n_frames)};
+  for (size_t index{0}; index < n_frames; ++index) {
+    frame_power(data.subspan(index * hop, length), scale, row, true);
+  }
+  return n_frames;
+}
+
+/*!
+  \brief PSD of one frame.
+
+  @param[in] index size_t Frame index (less than frames).
+  @returns std::span<const double> bins values.
+ */
+std::span<const double>
+spectrogram_matrix::frame(const size_t index) const noexcept {
+  return std::span<const double>{values}.subspan(index * bins, bins);
+}
+
+/*!
+  \brief Spectrogram of a Trace.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] window size_t Frame length (samples).
+  @param[in] overlap size_t Overlap between frames (samples).
+  @param[in] n_fft size_t Transform size (0 = window).
+  @param[in] taper taper_window Window shape.
+  @returns spectrogram_matrix Time-frequency PSD (allocated once).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  the framing is invalid (see spectrogram_plan).
+ */
+spectrogram_matrix spectrogram(const Trace &trace, const size_t window,
+                               const size_t overlap, const size_t n_fft,
+                               const taper_window taper) {
+  return std::move(spectrogram(std::span<const Trace>{&trace, 1}, window,
+                               overlap, n_fft, taper, 1)
+                       .front());
+}
+
+/*!
+  \brief Spectrograms of many Traces.
+
+  One plan (window weights and transform) is shared by all Traces, which are
+  processed in parallel (parallel_for), each thread with its own workspace.
+
+  @param[in] traces std::span<const Trace> Evenly-sampled time-series Traces.
+  @param[in] window size_t Frame length (samples).
+  @param[in] overlap size_t Overlap between frames (samples).
+  @param[in] n_fft size_t Transform size (0 = window).
+  @param[in] taper taper_window Window shape.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<spectrogram_matrix> One matrix per Trace.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing) or the framing is invalid.
+ */
+std::vector<spectrogram_matrix>
+spectrogram(std::span<const Trace> traces, const size_t window,
+            const size_t overlap, const size_t n_fft,
+            const taper_window taper, const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  const spectrogram_plan plan{window, overlap, n_fft, taper};
+  std::vector<spectrogram_matrix> result(traces.size());
+  parallel_for(
+      traces.size(),
+      [&traces, &plan, &result](const size_t i) {
+        const std::span<const double> data{traces[i].data1_view()};
+        const double delta{traces[i].delta()};
+        spectrogram_matrix &matrix{result[i]};
+        matrix.frames = plan.frames(data.size());
+        matrix.bins = plan.bins();
+        matrix.start = traces[i].b() +
+                       (0.5 * static_cast<double>(plan.window() - 1) * delta);
+        matrix.time_step = static_cast<double>(plan.step()) * delta;
+        matrix.frequency_step =
+            1.0 / (static_cast<double>(plan.size()) * delta);
+        matrix.values.resize(matrix.frames * matrix.bins);
+        plan.apply(data, delta, matrix.values);
+      },
+      threads);
+  return result;
+}
+
+/*!
+  \brief Welch power spectral density of a Trace.
+
+  The mean of the PSDs of overlapping, demeaned, tapered segments (see
+  spectrogram_plan::average); no per-segment allocations.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] segment size_t Segment length (samples).
+  @param[in] overlap size_t Overlap between segments (samples).
+  @param[in] n_fft size_t Transform size (0 = segment).
+  @param[in] taper taper_window Window shape.
+  @returns power_spectrum One-sided PSD (zero with no segments if the Trace
+  is shorter than a segment).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  the segments are invalid.
+ */
+power_spectrum psd_welch(const Trace &trace, const size_t segment,
+                         const size_t overlap, const size_t n_fft,
+                         const taper_window taper) {
+  return std::move(psd_welch(std::span<const Trace>{&trace, 1}, segment,
+                             overlap, n_fft, taper, 1)
+                       .front());
+}
+
+/*!
+  \brief Welch power spectral densities of many Traces.
+
+  One spectrogram_plan (window weights and transform) is shared by every
+  Trace.
+
+  @param[in] traces std::span<const Trace> Evenly-sampled time-series Traces.
+  @param[in] segment size_t Segment length (samples).
+  @param[in] overlap size_t Overlap between segments (samples).
+  @param[in] n_fft size_t Transform size (0 = segment).
+  @param[in] taper taper_window Window shape.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<power_spectrum> One-sided PSD per Trace.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing) or the segments are invalid.
+ */
+std::vector<power_spectrum>
+psd_welch(std::span<const Trace> traces, const size_t segment,
+          const size_t overlap, const size_t n_fft, const taper_window taper,
+          const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  const spectrogram_plan plan{segment, overlap, n_fft, taper};
+  std::vector<power_spectrum> result(traces.size());
+  parallel_for(
+      traces.size(),
+      [&traces, &plan, &result](const size_t i) {
+        const double delta{traces[i].delta()};
+        power_spectrum &psd{result[i]};
+        psd.frequency_step = 1.0 / (static_cast<double>(plan.size()) * delta);
+        psd.values.resize(plan.bins());
+        psd.segments = plan.average(traces[i].data1_view(), delta, psd.values);
+      },
+      threads);
+  return result;
+}
+
+/*!
+  \brief Empty probabilistic power spectral density.
+
+  @param[in] spec ppsd_spec Period and power binning.
+  @throw processing_error If the period range, bins per octave, smoothing,
+  or power range are invalid.
+ */
+ppsd::ppsd(const ppsd_spec &spec) : settings{spec} {
+  if (!(spec.period_min > 0.0) || !(spec.period_max >= spec.period_min) ||
+      (spec.bins_per_octave == 0) || !(spec.smoothing > 0.0) ||
+      !(spec.db_step > 0.0) || !(spec.db_max > spec.db_min)) {
+    throw processing_error(
+        "PPSD requires 0 < period_min <= period_max, bins per octave, "
+        "positive smoothing, and db_min < db_max with a positive step.");
+  }
+  n_periods = 1 + static_cast<size_t>(
+                      std::floor((std::log2(spec.period_max / spec.period_min) *
+                                  static_cast<double>(spec.bins_per_octave)) +
+                                 1e-9));
+  n_powers = static_cast<size_t>(
+      std::ceil(((spec.db_max - spec.db_min) / spec.db_step) - 1e-9));
+  counts.assign(n_periods * n_powers, 0);
+}
+
+/*!
+  \brief Binning specification.
+
+  @returns ppsd_spec Period and power binning.
+ */
+const ppsd_spec &ppsd::spec() const noexcept { return settings; }
+
+/*!
+  \brief Number of period bins.
+
+  @returns size_t Number of period bins.
+ */
+size_t ppsd::periods() const noexcept { return n_periods; }
+
+/*!
+  \brief Number of power bins.
+
+  @returns size_t Number of power bins.
+ */
+size_t ppsd::powers() const noexcept { return n_powers; }
+
+/*!
+  \brief Number of PSDs accumulated.
+
+  @returns size_t Number of PSDs.
+ */
+size_t ppsd::count() const noexcept { return psds; }
+
+/*!
+  \brief Center of a period bin.
+
+  @param[in] index size_t Period bin.
+  @returns double period_min * 2^(index / bins_per_octave) (seconds).
+ */
+double ppsd::period(const size_t index) const noexcept {
+  return settings.period_min *
+         std::exp2(static_cast<double>(index) /
+                   static_cast<double>(settings.bins_per_octave));
+}
+
+/*!
+  \brief Center of a power bin.
+
+  @param[in] index size_t Power bin.
+  @returns double Power (dB).
+ */
+double ppsd::power(const size_t index) const noexcept {
+  return settings.db_min + ((static_cast<double>(index) + 0.5) *
+                            settings.db_step);
+}
+
+/*!
+  \brief Histogram counts.
+
+  @returns std::span<const size_t> Counts (periods() x powers(), row-major).
+ */
+std::span<const size_t> ppsd::histogram() const noexcept { return counts; }
+
+/*!
+  \brief Accumulate a one-sided PSD.
+
+  The PSD is averaged over smoothing octaves centered on every period bin (in
+  O(1) per bin from a running sum), converted to dB, and counted.
+
+  @param[in] psd std::span<const double> One-sided PSD (from 0 Hz).
+  @param[in] frequency_step double Frequency between bins (Hz).
+  @throw processing_error If frequency_step is not positive.
+ */
+void ppsd::add(std::span<const double> psd, const double frequency_step) {
+  if (!(frequency_step > 0.0)) {
+    throw processing_error("PSD frequency step must be positive.");
+  }
+  thread_local std::vector<double> cumulative{};
+  cumulative.resize(psd.size() + 1);
+  cumulative[0] = 0.0;
+  for (size_t k{0}; k < psd.size(); ++k) {
+    cumulative[k + 1] = cumulative[k] + psd[k];
+  }
+  const double half_width{std::exp2(0.5 * settings.smoothing)};
+  for (size_t index{0}; index < n_periods; ++index) {
+    const double frequency{1.0 / period(index)};
+    // Bins [first, last] in the band, excluding 0 Hz
+    const double first{
+        std::max(std::ceil(frequency / half_width / frequency_step), 1.0)};
+    const double last{std::floor(frequency * half_width / frequency_step)};
+    if ((last < first) || (last >= static_cast<double>(psd.size()))) {
+      continue;
+    }
+    const auto low{static_cast<size_t>(first)};
+    const auto high{static_cast<size_t>(last)};
+    const double mean{(cumulative[high + 1] - cumulative[low]) /
+                      static_cast<double>(high - low + 1)};
+    if (!(mean > 0.0)) {
+      continue;
+    }
+    const double bin{
+        std::floor(((10.0 * std::log10(mean)) - settings.db_min) /
+                   settings.db_step)};
+    const auto column{static_cast<size_t>(
+        std::clamp(bin, 0.0, static_cast<double>(n_powers - 1)))};
+    ++counts[(index * n_powers) + column];
+  }
+  ++psds;
+}
+
+/*!
+  \brief Accumulate an averaged PSD.
+
+  @param[in] psd power_spectrum Averaged PSD (ignored if no segments).
+  @throw processing_error If the frequency step is not positive.
+ */
+void ppsd::add(const power_spectrum &psd) {
+  if (psd.segments > 0) {
+    add(psd.values, psd.frequency_step);
+  }
+}
+
+/*!
+  \brief Accumulate the Welch PSD of every segment of a Trace.
+
+  Segments (for example, one hour overlapping by half) are each averaged
+  with the welch plan (for example, 13 sub-segments overlapping by 75%) and
+  counted; the workspace is reused, so there are no per-segment allocations.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] segment size_t Segment length (samples, at least the Welch
+  window).
+  @param[in] overlap size_t Overlap between segments (samples).
+  @param[in] welch spectrogram_plan Welch framing of each segment.
+  @returns size_t Number of segments accumulated.
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  the segments are invalid.
+ */
+size_t ppsd::add(const Trace &trace, const size_t segment,
+                 const size_t overlap, const spectrogram_plan &welch) {
+  check_time_series(trace);
+  if ((segment < welch.window()) || (overlap >= segment)) {
+    throw processing_error(
+        "PPSD segments must satisfy overlap < segment and hold a Welch "
+        "window.");
+  }
+  const std::span<const double> data{trace.data1_view()};
+  const double delta{trace.delta()};
+  const double frequency_step{1.0 /
+                              (static_cast<double>(welch.size()) * delta)};
+  thread_local std::vector<double> psd{};
+  psd.resize(welch.bins());
+  size_t result{0};
+  for (size_t start{0}; start + segment <= data.size();
+       start += segment - overlap) {
+    welch.average(data.subspan(start, segment), delta, psd);
+    add(psd, frequency_step);
+    ++result;
+  }
+  return result;
+}
+
+/*!
+  \brief Combine a partial histogram.
+
+  @param[in] other ppsd Partial histogram (same specification).
+  @throw processing_error If the specifications differ.
+ */
+void ppsd::merge(const ppsd &other) {
+  const ppsd_spec &spec{other.settings};
+  if ((spec.period_min != settings.period_min) ||
+      (spec.period_max != settings.period_max) ||
+      (spec.bins_per_octave != settings.bins_per_octave) ||
+      (spec.smoothing != settings.smoothing) ||
+      (spec.db_min != settings.db_min) || (spec.db_max != settings.db_max) ||
+      (spec.db_step != settings.db_step)) {
+    throw processing_error("PPSDs have different specifications.");
+  }
+  psds += other.psds;
+  for (size_t i{0}; i < counts.size(); ++i) {
+    counts[i] += other.counts[i];
+  }
+}
+
+/*!
+  \brief Power percentile per period.
+
+  @param[in] percent double Percentile (0 to 100).
+  @returns std::vector<double> Center of the power bin reaching the
+  percentile of each period's counts (dB; NaN for empty periods).
+  @throw processing_error If percent is not between 0 and 100.
+ */
+std::vector<double> ppsd::percentile(const double percent) const {
+  if (!((percent >= 0.0) && (percent <= 100.0))) {
+    throw processing_error("Percentiles must be between 0 and 100.");
+  }
+  std::vector<double> result(n_periods, std::nan(""));
+  for (size_t index{0}; index < n_periods; ++index) {
+    const std::span<const size_t> row{
+        std::span{counts}.subspan(index * n_powers, n_powers)};
+    const size_t total{std::accumulate(row.begin(), row.end(), size_t{0})};
+    if (total == 0) {
+      continue;
+    }
+    const double target{percent / 100.0 * static_cast<double>(total)};
+    size_t running{0};
+    for (size_t column{0}; column < n_powers; ++column) {
+      running += row[column];
+      if ((running > 0) && (static_cast<double>(running) >= target)) {
+        result[index] = power(column);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Most common power per period.
+
+  @returns std::vector<double> Center of the fullest power bin of each period
+  (dB; NaN for empty periods).
+ */
+std::vector<double> ppsd::mode() const {
+  std::vector<double> result(n_periods, std::nan(""));
+  for (size_t index{0}; index < n_periods; ++index) {
+    const std::span<const size_t> row{
+        std::span{counts}.subspan(index * n_powers, n_powers)};
+    const auto fullest{std::ranges::max_element(row)};
+    if (*fullest > 0) {
+      result[index] = power(static_cast<size_t>(fullest - row.begin()));
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Probabilistic PSD of many Traces.
+
+  The Traces (for example, one per channel-day) are split into contiguous
+  chunks, one partial histogram per thread, merged in order.
+
+  @param[in] traces std::span<const Trace> Evenly-sampled time-series Traces.
+  @param[in] segment size_t Segment length (samples).
+  @param[in] overlap size_t Overlap between segments (samples).
+  @param[in] welch spectrogram_plan Welch framing of each segment.
+  @param[in] spec ppsd_spec Period and power binning.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns ppsd Histogram of every segment of every Trace.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing) or the segments or binning are invalid.
+ */
+ppsd probabilistic_psd(std::span<const Trace> traces, const size_t segment,
+                       const size_t overlap, const spectrogram_plan &welch,
+                       const ppsd_spec &spec, const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  size_t n_chunks{threads == 0 ? std::thread::hardware_concurrency()
+                               : threads};
+  n_chunks = std::max(size_t{1}, std::min(n_chunks, traces.size()));
+  std::vector<ppsd> partials(n_chunks, ppsd{spec});
+  parallel_for(
+      n_chunks,
+      [&traces, &partials, n_chunks, segment, overlap,
+       &welch](const size_t chunk) {
+        const size_t first{(traces.size() * chunk) / n_chunks};
+        const size_t last{(traces.size() * (chunk + 1)) / n_chunks};
+        for (size_t i{first}; i < last; ++i) {
+          partials[chunk].add(traces[i], segment, overlap, welch);
+        }
+      },
+      n_chunks);
+  for (size_t chunk{1}; chunk < n_chunks; ++chunk) {
+    partials.front().merge(partials[chunk]);
+  }
+  return std::move(partials.front());
+}
+//-----------------------------------------------------------------------------
+// Stacking
+//-----------------------------------------------------------------------------
+/*!
+  \brief Time of a marker.
+
+  @param[in] trace Trace Trace.
+  @param[in] marker time_marker Marker.
+  @returns double Time relative to the reference time (unset_double if
+  unset).
+ */
+double marker_time(const Trace &trace, const time_marker marker) noexcept {
+  using time_getter = double (Trace::*)() const noexcept;
+  constexpr std::array<time_getter, 13> getters{
+      &Trace::b,  &Trace::o,  &Trace::a,  &Trace::t0, &Trace::t1,
+      &Trace::t2, &Trace::t3, &Trace::t4, &Trace::t5, &Trace::t6,
+      &Trace::t7, &Trace::t8, &Trace::t9};
+  return (trace.*getters[static_cast<size_t>(marker)])();
+}
+
+/*!
+  \brief Prepare an empty stack.
+
+  @param[in] spec stack_spec Specification.
+  @throw processing_error If the length, sampling interval, or order is not
+  positive.
+ */
+stacker::stacker(const stack_spec &spec) : settings{spec} {
+  if ((spec.length == 0) || !(spec.delta > 0.0) || !(spec.order > 0.0)) {
+    throw processing_error(
+        "Stack length, sampling interval, and order must be positive.");
+  }
+  sums.assign(spec.length, 0.0);
+  counts.assign(spec.length, 0);
+  if (spec.method == stack_method::phase_weighted) {
+    phases.assign(spec.length, complex{0.0, 0.0});
+  }
+}
+
+/*!
+  \brief Specification.
+
+  @returns stack_spec Specification.
+ */
+const stack_spec &stacker::spec() const noexcept { return settings; }
+
+/*!
+  \brief Number of inputs added (including merged stacks).
+
+  @returns size_t Number of inputs.
+ */
+size_t stacker::count() const noexcept { return inputs; }
+
+/*!
+  \brief Accumulate data.
+
+  Only the samples that fall inside the stack are used. The phase-weighted
+  stack uses the instantaneous phase of the whole input (analytic_signal).
+
+  @param[in] data std::span<const double> Data.
+  @param[in] offset std::ptrdiff_t Stack sample of data[0] (may be negative).
+ */
+void stacker::add(std::span<const double> data, const std::ptrdiff_t offset) {
+  ++inputs;
+  const auto length{static_cast<std::ptrdiff_t>(settings.length)};
+  const std::ptrdiff_t first{std::max(std::ptrdiff_t{0}, -offset)};
+  const std::ptrdiff_t last{
+      std::min(static_cast<std::ptrdiff_t>(data.size()), length - offset)};
+  if (first >= last) {
+    return;
+  }
+  const auto begin{static_cast<size_t>(first)};
+  const std::span<const double> input{
+      data.subspan(begin, static_cast<size_t>(last - first))};
+  const auto start{static_cast<size_t>(first + offset)};
+  double *const sum{sums.data() + start};
+  size_t *const count{counts.data() + start};
+  for (size_t k{0}; k < input.size(); ++k) {
+    ++count[k];
+  }
+  switch (settings.method) {
+  case stack_method::linear:
+    for (size_t k{0}; k < input.size(); ++k) {
+      sum[k] += input[k];
+    }
+    break;
+  case stack_method::nth_root: {
+    // Square roots (the usual order) are much cheaper than std::pow
+    if (settings.order == 2.0) {
+      for (size_t k{0}; k < input.size(); ++k) {
+        sum[k] += std::copysign(std::sqrt(std::abs(input[k])), input[k]);
+      }
+      break;
+    }
+    const double root{1.0 / settings.order};
+    for (size_t k{0}; k < input.size(); ++k) {
+      sum[k] += std::copysign(std::pow(std::abs(input[k]), root), input[k]);
+    }
+    break;
+  }
+  case stack_method::phase_weighted: {
+    thread_local std::vector<complex> analytic{};
+    analytic.resize(data.size());
+    analytic_signal(data, analytic);
+    for (size_t k{0}; k < input.size(); ++k) {
+      sum[k] += input[k];
+      const complex value{analytic[begin + k]};
+      const double magnitude{std::abs(value)};
+      if (magnitude > 0.0) {
+        phases[start + k] += value / magnitude;
+      }
+    }
+    break;
+  }
+  }
+}
+
+/*!
+  \brief Accumulate a Trace.
+
+  The sample at time reference (relative to the Trace's reference time, like
+  b) is placed at stack time 0; positions are rounded to the nearest sample.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] reference double Alignment time.
+  @throw processing_error If the Trace is not an evenly-sampled time-series,
+  its sampling interval differs from the stack's, or reference is unset.
+ */
+void stacker::add(const Trace &trace, const double reference) {
+  check_time_series(trace);
+  if (std::abs(trace.delta() - settings.delta) >
+      merge_delta_tolerance * settings.delta) {
+    throw processing_error("Trace sampling interval differs from the stack.");
+  }
+  if (reference == unset_double) {
+    throw processing_error("Stack alignment time is not set.");
+  }
+  const auto offset{static_cast<std::ptrdiff_t>(std::llround(
+      (trace.b() - reference - settings.begin) / settings.delta))};
+  add(trace.data1_view(), offset);
+}
+
+/*!
+  \brief Accumulate a Trace aligned on a marker.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] marker time_marker Marker placed at stack time 0.
+  @throw processing_error If the Trace is unsuitable or the marker is unset.
+ */
+void stacker::add(const Trace &trace, const time_marker marker) {
+  add(trace, marker_time(trace, marker));
+}
+
+/*!
+  \brief Combine a partial stack.
+
+  @param[in] other stacker Partial stack (same specification).
+  @throw processing_error If the specifications differ.
+ */
+void stacker::merge(const stacker &other) {
+  const stack_spec &spec{other.settings};
+  if ((spec.length != settings.length) || (spec.delta != settings.delta) ||
+      (spec.begin != settings.begin) || (spec.method != settings.method) ||
+      (spec.order != settings.order)) {
+    throw processing_error("Stacks have different specifications.");
+  }
+  inputs += other.inputs;
+  for (size_t i{0}; i < settings.length; ++i) {
+    sums[i] += other.sums[i];
+    counts[i] += other.counts[i];
+  }
+  for (size_t i{0}; i < phases.size(); ++i) {
+    phases[i] += other.phases[i];
+  }
+}
+
+/*!
+  \brief Stack.
+
+  Linear: \f$\bar{x}\f$. nth-root: \f$\mathrm{sign}(r)|r|^n\f$ with \f$r\f$
+  the mean of \f$\mathrm{sign}(x)|x|^{1/n}\f$. Phase-weighted:
+  \f$\bar{x}\,|\bar{\phi}|^\nu\f$ with \f$\bar{\phi}\f$ the mean of the unit
+  phasors of the analytic signals.
+
+  @returns std::vector<double> Stack (length samples).
+ */
+std::vector<double> stacker::result() const {
+  std::vector<double> stack(settings.length, 0.0);
+  for (size_t i{0}; i < settings.length; ++i) {
+    if (counts[i] == 0) {
+      continue;
+    }
+    const double scale{1.0 / static_cast<double>(counts[i])};
+    const double mean{sums[i] * scale};
+    switch (settings.method) {
+    case stack_method::linear:
+      stack[i] = mean;
+      break;
+    case stack_method::nth_root:
+      stack[i] = std::copysign(std::pow(std::abs(mean), settings.order), mean);
+      break;
+    case stack_method::phase_weighted:
+      stack[i] = mean * std::pow(std::abs(phases[i]) * scale, settings.order);
+      break;
+    }
+  }
+  return stack;
+}
+
+/*!
+  \brief Stack as a Trace.
+
+  @returns Trace Evenly-sampled time-series (b is the stack's begin time,
+  relative to the alignment; depmin, depmax, and depmen set).
+ */
+Trace stacker::to_trace() const {
+  Trace trace{};
+  trace.iftype(itime);
+  trace.leven(true);
+  trace.delta(settings.delta);
+  trace.b(settings.begin);
+  trace.data1(result());
+  trace.e(settings.begin +
+          (static_cast<double>(settings.length - 1) * settings.delta));
+  trace.update_stats();
+  return trace;
+}
+
+/*!
+  \brief Stack inputs added on demand.
+
+  Inputs 0 ... count - 1 are split into one contiguous range per thread; each
+  thread adds its range (add_input(index, partial), which may read the input
+  from disk) to its own partial stack, and the partial stacks are merged in
+  order. Memory is proportional to the number of threads times the stack
+  length.
+
+  @param[in] count size_t Number of inputs.
+  @param[in] add_input std::function<void(size_t, stacker*)> Adds an input to
+  a (partial) stack.
+  @param[in] spec stack_spec Specification.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns stacker Combined stack.
+  @throw processing_error If the specification is invalid; any exception from
+  add_input is rethrown.
+ */
+stacker stack(const size_t count,
+              const std::function<void(size_t, stacker *)> &add_input,
+              const stack_spec &spec, const size_t threads) {
+  size_t n_chunks{threads == 0 ? std::thread::hardware_concurrency()
+                               : threads};
+  n_chunks = std::max(size_t{1}, std::min(n_chunks, count));
+  std::vector<stacker> partials(n_chunks, stacker{spec});
+  parallel_for(
+      n_chunks,
+      [count, n_chunks, &add_input, &partials](const size_t chunk) {
+        const size_t first{(count * chunk) / n_chunks};
+        const size_t last{(count * (chunk + 1)) / n_chunks};
+        for (size_t i{first}; i < last; ++i) {
+          add_input(i, &partials[chunk]);
+        }
+      },
+      n_chunks);
+  for (size_t chunk{1}; chunk < n_chunks; ++chunk) {
+    partials.front().merge(partials[chunk]);
+  }
+  return std::move(partials.front());
+}
+
+/*!
+  \brief Stack Traces aligned on a marker.
+
+  @param[in] traces std::span<const Trace> Evenly-sampled time-series Traces.
+  @param[in] marker time_marker Marker placed at stack time 0.
+  @param[in] spec stack_spec Specification.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns stacker Stack.
+  @throw processing_error If a Trace is unsuitable (see stacker::add) or the
+  specification is invalid.
+ */
+stacker stack(std::span<const Trace> traces, const time_marker marker,
+              const stack_spec &spec, const size_t threads) {
+  return stack(
+      traces.size(),
+      [&traces, marker](const size_t i, stacker *partial) {
+        partial->add(traces[i], marker);
+      },
+      spec, threads);
+}
+//-----------------------------------------------------------------------------
+// Array Processing
+//-----------------------------------------------------------------------------
+/*!
+  \brief Station positions relative to the array center.
+
+  The center is the mean station latitude and longitude; offsets use a flat
+  Earth (suitable for small apertures).
+
+  @param[in] traces std::span<const Trace> Traces (stla and stlo set).
+  @returns array_geometry Center and station offsets (km).
+  @throw processing_error If there are no Traces or a location is not set.
+ */
+array_geometry array_coordinates(std::span<const Trace> traces) {
+  if (traces.empty()) {
+    throw processing_error("Array has no stations.");
+  }
+  array_geometry geometry{};
+  for (const Trace &trace : traces) {
+    if ((trace.stla() == unset_double) || (trace.stlo() == unset_double)) {
+      throw processing_error("Station location (stla, stlo) is not set.");
+    }
+    geometry.latitude += trace.stla();
+    geometry.longitude += trace.stlo();
+  }
+  geometry.latitude /= static_cast<double>(traces.size());
+  geometry.longitude /= static_cast<double>(traces.size());
+  const double km_per_deg{earth_radius * rad_per_deg};
+  const double parallel{std::cos(geometry.latitude * rad_per_deg)};
+  for (const Trace &trace : traces) {
+    geometry.east.push_back((trace.stlo() - geometry.longitude) * km_per_deg *
+                            parallel);
+    geometry.north.push_back((trace.stla() - geometry.latitude) * km_per_deg);
+  }
+  return geometry;
+}
+
+/*!
+  \brief Slowness of a point on an axis.
+
+  @param[in] index size_t Point (0 to points - 1).
+  @returns double Slowness (seconds/km).
+ */
+double slowness_grid::value(const size_t index) const noexcept {
+  if (points < 2) {
+    return 0.0;
+  }
+  return -max + (2.0 * max * static_cast<double>(index) /
+                 static_cast<double>(points - 1));
+}
+
+/*!
+  \brief Prepare f-k beam power.
+
+  A plane wave with slowness \f$\mathbf{s}\f$ reaches station \f$j\f$ (offset
+  \f$\mathbf{r}_j\f$) \f$\tau_j = \mathbf{s}\cdot\mathbf{r}_j\f$ after the
+  center, so its beam is \f$\sum_j X_j(f)e^{2\pi if\tau_j}\f$. The factors
+  for the first bin and their per-bin change are stored per grid point and
+  station.
+
+  @param[in] geometry array_geometry Station offsets.
+  @param[in] grid slowness_grid Slowness grid.
+  @param[in] window size_t Window length (samples).
+  @param[in] delta double Sampling interval.
+  @param[in] low double Lowest frequency (Hz).
+  @param[in] high double Highest frequency (Hz).
+  @throw processing_error If there are no stations, the grid or window is
+  empty, delta is not positive, or the band contains no frequency.
+ */
+fk_plan::fk_plan(const array_geometry &geometry, const slowness_grid &grid,
+                 const size_t window, const double delta, const double low,
+                 const double high)
+    : slowness{grid}, n_stations{geometry.east.size()}, length{window},
+      interval{delta} {
+  if ((n_stations == 0) || (geometry.north.size() != n_stations) ||
+      (grid.points == 0) || (window == 0) || !(delta > 0.0)) {
+    throw processing_error(
+        "f-k needs stations, a slowness grid, a window, and a positive delta.");
+  }
+  plan = rfft_plan::get(next_fast_size(window));
+  const double frequency_step{1.0 /
+                              (static_cast<double>(plan->size()) * delta)};
+  first_bin = static_cast<size_t>(std::ceil(std::max(low, 0.0) /
+                                            frequency_step));
+  const size_t last_bin{std::min(
+      plan->bins() - 1,
+      static_cast<size_t>(std::floor(std::max(high, 0.0) / frequency_step)))};
+  if ((high < low) || (first_bin > last_bin)) {
+    throw processing_error("f-k frequency band contains no frequency.");
+  }
+  n_bins = last_bin - first_bin + 1;
+  constexpr double pi{std::numbers::pi_v<double>};
+  weights.resize(window);
+  for (size_t j{0}; j < window; ++j) {
+    weights[j] = 0.5 - (0.5 * std::cos(2.0 * pi * static_cast<double>(j) /
+                                       static_cast<double>(window)));
+  }
+  const size_t n_points{grid.points * grid.points};
+  phasors.resize(n_points * n_stations);
+  steps.resize(n_points * n_stations);
+  for (size_t row{0}; row < grid.points; ++row) {
+    for (size_t col{0}; col < grid.points; ++col) {
+      const size_t point{(row * grid.points) + col};
+      for (size_t j{0}; j < n_stations; ++j) {
+        const double delay{(grid.value(col) * geometry.east[j]) +
+                           (grid.value(row) * geometry.north[j])};
+        const double phase{2.0 * pi * frequency_step * delay};
+        phasors[(point * n_stations) + j] =
+            std::polar(1.0, phase * static_cast<double>(first_bin));
+        steps[(point * n_stations) + j] = std::polar(1.0, phase);
+      }
+    }
+  }
+}
+
+/*!
+  \brief Number of stations.
+
+  @returns size_t Number of stations.
+ */
+size_t fk_plan::stations() const noexcept { return n_stations; }
+
+/*!
+  \brief Window length.
+
+  @returns size_t Window length (samples).
+ */
+size_t fk_plan::window() const noexcept { return length; }
+
+/*!
+  \brief Slowness grid.
+
+  @returns slowness_grid Grid.
+ */
+const slowness_grid &fk_plan::grid() const noexcept { return slowness; }
+
+/*!
+  \brief Beam power of a window.
+
+  Each station's window (mean removed, Hann taper) is transformed once; the
+  relative power of grid point \f$\mathbf{s}\f$ is
+  \f$\sum_f|\sum_jX_j(f)e^{2\pi if\tau_j}|^2 / (N\sum_f\sum_j|X_j(f)|^2)\f$
+  (1 for a perfectly coherent plane wave). Grid rows are evaluated in
+  parallel (parallel_for).
+
+  @param[in] traces std::span<const Trace> Aligned Traces (see check_aligned),
+  in the order of the geometry.
+  @param[in] start size_t First sample of the window.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns fk_result Relative power and its peak.
+  @throw processing_error If the Traces are not aligned, do not match the
+  plan (number, delta), or are too short for the window.
+ */
+fk_result fk_plan::power(std::span<const Trace> traces, const size_t start,
+                         const size_t threads) const {
+  if (traces.size() != n_stations) {
+    throw processing_error("Number of Traces differs from the f-k plan.");
+  }
+  std::vector<const Trace *> pointers{};
+  pointers.reserve(traces.size());
+  for (const Trace &trace : traces) {
+    pointers.push_back(&trace);
+  }
+  check_aligned(pointers);
+  if (std::abs(traces[0].delta() - interval) >
+      merge_delta_tolerance * interval) {
+    throw processing_error("Trace sampling interval differs from the plan.");
+  }
+  if (start + length > traces[0].data1_view().size()) {
+    throw processing_error("f-k window extends past the end of the data.");
+  }
+  // Spectra in the band (bin-major, stations contiguous)
+  std::vector<complex> spectra(n_bins * n_stations);
+  std::vector<double> frame(plan->size(), 0.0);
+  std::vector<complex> spectrum(plan->bins());
+  double total{0.0};
+  for (size_t j{0}; j < n_stations; ++j) {
+    const std::span<const double> data{
+        traces[j].data1_view().subspan(start, length)};
+    double sum{0.0};
+    for (const double value : data) {
+      sum += value;
+    }
+    const double mean{sum / static_cast<double>(length)};
+    for (size_t i{0}; i < length; ++i) {
+      frame[i] = (data[i] - mean) * weights[i];
+    }
+    plan->forward(frame, spectrum);
+    for (size_t k{0}; k < n_bins; ++k) {
+      spectra[(k * n_stations) + j] = spectrum[first_bin + k];
+      total += std::norm(spectrum[first_bin + k]);
+    }
+  }
+  const size_t points{slowness.points};
+  fk_result result{};
+  result.power.assign(points * points, 0.0);
+  const double scale{total > 0.0
+                         ? 1.0 / (static_cast<double>(n_stations) * total)
+                         : 0.0};
+  parallel_for(
+      points,
+      [this, points, scale, &spectra, &result](const size_t row) {
+        thread_local std::vector<complex> factors{};
+        factors.resize(n_stations);
+        for (size_t col{0}; col < points; ++col) {
+          const size_t point{(row * points) + col};
+          const complex *const step{steps.data() + (point * n_stations)};
+          std::copy_n(phasors.begin() +
+                          static_cast<std::ptrdiff_t>(point * n_stations),
+                      n_stations, factors.begin());
+          double power{0.0};
+          for (size_t k{0}; k < n_bins; ++k) {
+            const complex *const values{spectra.data() + (k * n_stations)};
+            complex beam{0.0, 0.0};
+            for (size_t j{0}; j < n_stations; ++j) {
+              beam += complex_multiply(values[j], factors[j]);
+              factors[j] = complex_multiply(factors[j], step[j]);
+            }
+            power += std::norm(beam);
+          }
+          result.power[point] = power * scale;
+        }
+      },
+      threads);
+  const auto peak{std::max_element(result.power.begin(), result.power.end())};
+  const auto index{static_cast<size_t>(peak - result.power.begin())};
+  result.peak = *peak;
+  result.slowness_east = slowness.value(index % points);
+  result.slowness_north = slowness.value(index / points);
+  // Waves arrive from the direction opposite the slowness vector
+  result.back_azimuth = limit_360(
+      std::atan2(-result.slowness_east, -result.slowness_north) *
+      deg_per_rad);
+  const double magnitude{std::hypot(result.slowness_east,
+                                    result.slowness_north)};
+  result.velocity = magnitude > 0.0 ? 1.0 / magnitude : 0.0;
+  return result;
+}
+
+/*!
+  \brief Delay-and-sum beam.
+
+  Station \f$j\f$ is advanced by \f$\tau_j = \mathbf{s}\cdot\mathbf{r}_j\f$
+  (rounded to the nearest sample) and the Traces are averaged (a linear
+  stacker, normalized per sample by the stations that cover it). The beam has
+  the headers of the first Trace, at the array center (stla, stlo), with
+  kstnm BEAM.
+
+  @param[in] traces std::span<const Trace> Aligned Traces (see
+  check_aligned), in the order of the geometry.
+  @param[in] geometry array_geometry Station offsets.
+  @param[in] slowness_east double East slowness (seconds/km).
+  @param[in] slowness_north double North slowness (seconds/km).
+  @returns Trace Beam.
+  @throw processing_error If the Traces are not aligned or do not match the
+  geometry.
+ */
+Trace delay_and_sum(std::span<const Trace> traces,
+                    const array_geometry &geometry,
+                    const double slowness_east, const double slowness_north) {
+  if (traces.empty() || (traces.size() != geometry.east.size()) ||
+      (traces.size() != geometry.north.size())) {
+    throw processing_error("Number of Traces differs from the geometry.");
+  }
+  std::vector<const Trace *> pointers{};
+  pointers.reserve(traces.size());
+  for (const Trace &trace : traces) {
+    pointers.push_back(&trace);
+  }
+  check_aligned(pointers);
+  const Trace &head{traces[0]};
+  const double delta{head.delta()};
+  stacker beam{{head.data1_view().size(), delta, 0.0, stack_method::linear}};
+  for (size_t j{0}; j < traces.size(); ++j) {
+    const double delay{(slowness_east * geometry.east[j]) +
+                       (slowness_north * geometry.north[j])};
+    beam.add(traces[j].data1_view(),
+             -static_cast<std::ptrdiff_t>(std::llround(delay / delta)));
+  }
+  Trace result{head};
+  result.data1(beam.result());
+  result.stla(geometry.latitude);
+  result.stlo(geometry.longitude);
+  result.kstnm("BEAM");
+  result.update_stats();
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Amplitude Metrics
+//-----------------------------------------------------------------------------
+/*!
+  \brief Sliding-window amplitude metrics of data.
+
+  Windows start every window - overlap samples. The data is read once in
+  blocks of gcd(window, step) samples (block sums of squares and peaks, a
+  vectorizable pass), so every window is a run of whole blocks: sums of
+  squares slide over the blocks (recomputed exactly once per window length to
+  bound rounding error) and peaks use a monotonic queue of blocks. Percentiles
+  (linear interpolation between order statistics of the absolute amplitude)
+  are selected in each window.
+
+  @param[in] data std::span<const double> Data.
+  @param[in] spec amplitude_spec Windows and percentiles.
+  @returns amplitude_metrics Metrics (start and time_step in samples).
+  @throw processing_error If window is zero, overlap is not less than window,
+  or a percentile is not between 0 and 100.
+ */
+amplitude_metrics amplitudes(std::span<const double> data,
+                             const amplitude_spec &spec) {
+  if ((spec.window == 0) || (spec.overlap >= spec.window)) {
+    throw processing_error(
+        "Amplitude windows must satisfy 0 <= overlap < window.");
+  }
+  for (const double percentile : spec.percentiles) {
+    if (!((percentile >= 0.0) && (percentile <= 100.0))) {
+      throw processing_error("Percentiles must be between 0 and 100.");
+    }
+  }
+  const size_t window{spec.window};
+  const size_t step{window - spec.overlap};
+  amplitude_metrics result{};
+  result.windows =
+      data.size() < window ? 0 : 1 + ((data.size() - window) / step);
+  result.start = 0.5 * static_cast<double>(window - 1);
+  result.time_step = static_cast<double>(step);
+  result.rms.resize(result.windows);
+  result.peak.resize(result.windows);
+  result.percentiles.resize(result.windows * spec.percentiles.size());
+  if (result.windows == 0) {
+    return result;
+  }
+  const size_t block{std::gcd(window, step)};
+  const size_t per_window{window / block};
+  const size_t per_step{step / block};
+  const size_t n_blocks{((result.windows - 1) * per_step) + per_window};
+  thread_local std::vector<double> squares{};
+  thread_local std::vector<double> peaks{};
+  squares.resize(n_blocks);
+  peaks.resize(n_blocks);
+  for (size_t index{0}; index < n_blocks; ++index) {
+    const double *const values{data.data() + (index * block)};
+    double sum{0.0};
+    double peak{0.0};
+    for (size_t i{0}; i < block; ++i) {
+      sum += values[i] * values[i];
+      peak = std::max(peak, std::abs(values[i]));
+    }
+    squares[index] = sum;
+    peaks[index] = peak;
+  }
+  double sum{0.0};
+  size_t exact{0};
+  std::deque<size_t> maxima{};
+  size_t next{0};
+  const double scale{1.0 / static_cast<double>(window)};
+  for (size_t index{0}; index < result.windows; ++index) {
+    const size_t first{index * per_step};
+    const size_t last{first + per_window};
+    if ((index == 0) || (first >= exact + per_window)) {
+      sum = 0.0;
+      for (size_t i{first}; i < last; ++i) {
+        sum += squares[i];
+      }
+      exact = first;
+    } else {
+      for (size_t i{first - per_step}; i < first; ++i) {
+        sum -= squares[i];
+      }
+      for (size_t i{std::max(last - per_step, first)}; i < last; ++i) {
+        sum += squares[i];
+      }
+    }
+    for (; next < last; ++next) {
+      while (!maxima.empty() && (peaks[maxima.back()] <= peaks[next])) {
+        maxima.pop_back();
+      }
+      maxima.push_back(next);
+    }
+    while (maxima.front() < first) {
+      maxima.pop_front();
+    }
+    result.rms[index] = std::sqrt(std::max(sum, 0.0) * scale);
+    result.peak[index] = peaks[maxima.front()];
+  }
+  if (spec.percentiles.empty()) {
+    return result;
+  }
+  thread_local std::vector<double> sorted{};
+  sorted.resize(window);
+  for (size_t index{0}; index < result.windows; ++index) {
+    const std::span<const double> values{data.subspan(index * step, window)};
+    for (size_t i{0}; i < window; ++i) {
+      sorted[i] = std::abs(values[i]);
+    }
+    for (size_t k{0}; k < spec.percentiles.size(); ++k) {
+      const double position{spec.percentiles[k] / 100.0 *
+                            static_cast<double>(window - 1)};
+      const auto lower{static_cast<size_t>(position)};
+      const auto nth{sorted.begin() + static_cast<std::ptrdiff_t>(lower)};
+      std::nth_element(sorted.begin(), nth, sorted.end());
+      double value{*nth};
+      if (lower + 1 < window) {
+        const double upper{*std::min_element(nth + 1, sorted.end())};
+        value += (position - static_cast<double>(lower)) * (upper - value);
+      }
+      result.percentiles[(index * spec.percentiles.size()) + k] = value;
+    }
+  }
+  return result;
+}
+
+/*!
+  \brief Sliding-window amplitude metrics of a Trace.
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @param[in] spec amplitude_spec Windows and percentiles.
+  @returns amplitude_metrics Metrics (start relative to the reference time,
+  like b; time_step in seconds).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  the specification is invalid.
+ */
+amplitude_metrics amplitudes(const Trace &trace, const amplitude_spec &spec) {
+  check_time_series(trace);
+  amplitude_metrics result{amplitudes(trace.data1_view(), spec)};
+  result.start = trace.b() + (result.start * trace.delta());
+  result.time_step *= trace.delta();
+  return result;
+}
+
+/*!
+  \brief Sliding-window amplitude metrics of many Traces.
+
+  @param[in] traces std::span<const Trace> Evenly-sampled time-series Traces.
+  @param[in] spec amplitude_spec Windows and percentiles.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<amplitude_metrics> Metrics per Trace.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing) or the specification is invalid.
+ */
+std::vector<amplitude_metrics> amplitudes(std::span<const Trace> traces,
+                                          const amplitude_spec &spec,
+                                          const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  std::vector<amplitude_metrics> result(traces.size());
+  parallel_for(
+      traces.size(),
+      [&traces, &spec, &result](const size_t i) {
+        result[i] = amplitudes(traces[i], spec);
+      },
+      threads);
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Level of Detail
+//-----------------------------------------------------------------------------
+/*!
+  \brief Samples per block of a pyramid level.
+
+  @param[in] level size_t Pyramid level.
+  @returns size_t lod_factor^(level + 1).
+ */
+size_t lod_pyramid::block(const size_t level) const noexcept {
+  size_t result{lod_factor};
+  for (size_t i{0}; i < level; ++i) {
+    result *= lod_factor;
+  }
+  return result;
+}
+
+/*!
+  \brief Build the min/max level-of-detail pyramid of a Trace.
+
+  The finest level is a single pass over the data (the block minimum and
+  maximum vectorize); every coarser level is reduced from the one below, so the
+  whole pyramid costs about 4/3 of a pass and about 2/3 of the data in memory
+  (single-precision, like SAC-files).
+
+  @param[in] trace Trace Evenly-sampled time-series Trace (data1).
+  @returns lod_pyramid Pyramid.
+  @throw processing_error If the Trace is not an evenly-sampled time-series.
+ */
+lod_pyramid build_lod(const Trace &trace) {
+  check_time_series(trace);
+  const std::span<const double> data{trace.data1_view()};
+  lod_pyramid result{data.size(), trace.b(), trace.delta(), {}};
+  if (data.empty()) {
+    return result;
+  }
+  size_t blocks{(data.size() + lod_factor - 1) / lod_factor};
+  std::vector<float> level(2 * blocks);
+  const size_t full{data.size() / lod_factor};
+  for (size_t index{0}; index < full; ++index) {
+    const double *const values{data.data() + (index * lod_factor)};
+    double minimum{values[0]};
+    double maximum{values[0]};
+    for (size_t i{1}; i < lod_factor; ++i) {
+      minimum = std::min(minimum, values[i]);
+      maximum = std::max(maximum, values[i]);
+    }
+    level[2 * index] = static_cast<float>(minimum);
+    level[(2 * index) + 1] = static_cast<float>(maximum);
+  }
+  if (full < blocks) {
+    const auto [minimum, maximum]{
+        std::ranges::minmax(data.subspan(full * lod_factor))};
+    level[2 * full] = static_cast<float>(minimum);
+    level[(2 * full) + 1] = static_cast<float>(maximum);
+  }
+  result.levels.push_back(std::move(level));
+  while (blocks > 1) {
+    const std::vector<float> &below{result.levels.back()};
+    const size_t n_below{blocks};
+    blocks = (blocks + lod_factor - 1) / lod_factor;
+    std::vector<float> coarser(2 * blocks);
+    for (size_t index{0}; index < blocks; ++index) {
+      const size_t first{index * lod_factor};
+      const size_t last{std::min(first + lod_factor, n_below)};
+      float minimum{below[2 * first]};
+      float maximum{below[(2 * first) + 1]};
+      for (size_t i{first + 1}; i < last; ++i) {
+        minimum = std::min(minimum, below[2 * i]);
+        maximum = std::max(maximum, below[(2 * i) + 1]);
+      }
+      coarser[2 * index] = minimum;
+      coarser[(2 * index) + 1] = maximum;
+    }
+    result.levels.push_back(std::move(coarser));
+  }
+  return result;
+}
+
+/*!
+  \brief Min/max envelope of a time range at pixel resolution.
+
+  Uses the coarsest level whose blocks are no longer than a pixel, so each
+  pixel combines at most a few blocks: O(pixels) regardless of the range. Every
+  block overlapping a pixel is included, so the envelope is never narrower
+  than the data (when zoomed in past lod_factor samples per pixel, plot the
+  data itself).
+
+  @param[in] pyramid lod_pyramid Level-of-detail pyramid.
+  @param[in] t0 double Start time (like b).
+  @param[in] t1 double End time.
+  @param[in] pixels size_t Number of pixels.
+  @returns lod_envelope Envelope (NaN for pixels without data).
+  @throw processing_error If t1 <= t0 or pixels is zero.
+ */
+lod_envelope lod_range(const lod_pyramid &pyramid, const double t0,
+                       const double t1, const size_t pixels) {
+  if (!(t1 > t0) || (pixels == 0)) {
+    throw processing_error("Envelope range requires t0 < t1 and pixels > 0.");
+  }
+  lod_envelope result{t0, (t1 - t0) / static_cast<double>(pixels), 0,
+                      std::vector<float>(pixels, std::nanf("")),
+                      std::vector<float>(pixels, std::nanf(""))};
+  if (pyramid.levels.empty() || !(pyramid.delta > 0.0)) {
+    return result;
+  }
+  const double per_pixel{result.step / pyramid.delta};
+  while ((result.level + 1 < pyramid.levels.size()) &&
+         (static_cast<double>(pyramid.block(result.level + 1)) <= per_pixel)) {
+    ++result.level;
+  }
+  const std::vector<float> &level{pyramid.levels[result.level]};
+  const size_t block{pyramid.block(result.level)};
+  const double origin{(t0 - pyramid.begin) / pyramid.delta};
+  const auto npts{static_cast<double>(pyramid.npts)};
+  for (size_t pixel{0}; pixel < pixels; ++pixel) {
+    const double first{std::max(
+        std::floor(origin + (static_cast<double>(pixel) * per_pixel)), 0.0)};
+    const double last{std::min(
+        std::ceil(origin + (static_cast<double>(pixel + 1) * per_pixel)),
+        npts)};
+    if (!(first < last)) {
+      continue;
+    }
+    const size_t first_block{static_cast<size_t>(first) / block};
+    const size_t last_block{(static_cast<size_t>(last) - 1) / block};
+    float minimum{level[2 * first_block]};
+    float maximum{level[(2 * first_block) + 1]};
+    for (size_t i{first_block + 1}; i <= last_block; ++i) {
+      minimum = std::min(minimum, level[2 * i]);
+      maximum = std::max(maximum, level[(2 * i) + 1]);
+    }
+    result.minimum[pixel] = minimum;
+    result.maximum[pixel] = maximum;
+  }
+  return result;
+}
+
+/*!
+  \brief Level-of-detail file next to a SAC-file.
+
+  @param[in] path std::filesystem::path SAC-file.
+  @returns std::filesystem::path path with ".lod" appended.
+ */
+std::filesystem::path lod_path(const std::filesystem::path &path) {
+  std::filesystem::path result{path};
+  result += ".lod";
+  return result;
+}
+
+/*!
+  \brief Write a level-of-detail pyramid.
+
+  Layout (native byte-order, like SAC-files): lod_magic, npts (64-bit), begin
+  and delta (double), lod_factor and the number of levels (32-bit), every
+  level's interleaved minimum and maximum (float), and a CRC-32C of all
+  preceding bytes.
+
+  @param[in] pyramid lod_pyramid Level-of-detail pyramid.
+  @param[in,out] output std::ostream* Output stream.
+  @throw io_error If writing fails.
+ */
+void write_lod(const lod_pyramid &pyramid, std::ostream *output) {
+  std::uint32_t crc{0};
+  const auto write_bytes{[output, &crc](const void *bytes, const size_t size) {
+    const std::span<const char> view{static_cast<const char *>(bytes), size};
+    crc = crc32c(view, crc);
+    output->write(view.data(), static_cast<std::streamsize>(size));
+  }};
+  const auto npts{static_cast<std::uint64_t>(pyramid.npts)};
+  const auto factor{static_cast<std::uint32_t>(lod_factor)};
+  const auto n_levels{static_cast<std::uint32_t>(pyramid.levels.size())};
+  write_bytes(lod_magic.data(), lod_magic.size());
+  write_bytes(&npts, sizeof(npts));
+  write_bytes(&pyramid.begin, sizeof(pyramid.begin));
+  write_bytes(&pyramid.delta, sizeof(pyramid.delta));
+  write_bytes(&factor, sizeof(factor));
+  write_bytes(&n_levels, sizeof(n_levels));
+  for (const std::vector<float> &level : pyramid.levels) {
+    write_bytes(level.data(), level.size() * sizeof(float));
+  }
+  std::array<char, sizeof(crc)> checksum{};
+  // flawfinder: ignore
+  std::memcpy(checksum.data(), &crc, sizeof(crc));
+  output->write(checksum.data(), checksum.size());
+  if (!*output) {
+    throw io_error("Level-of-detail pyramid cannot be written.");
+  }
+}
+
+/*!
+  \brief Write a level-of-detail pyramid to a file.
+
+  @param[in] pyramid lod_pyramid Level-of-detail pyramid.
+  @param[in] path std::filesystem::path File (see lod_path).
+  @throw io_error If the file cannot be opened or written.
+ */
+void write_lod(const lod_pyramid &pyramid, const std::filesystem::path &path) {
+  std::ofstream file{path, std::ios::binary | std::ios::out | std::ios::trunc};
+  if (!file) {
+    throw io_error(path.string() + " cannot be opened to write.");
+  }
+  write_lod(pyramid, &file);
+}
+
+/*!
+  \brief Read a level-of-detail pyramid.
+
+  @param[in,out] input std::istream* Input stream (see write_lod).
+  @returns lod_pyramid Pyramid.
+  @throw io_error If the stream is not a valid level-of-detail pyramid
+  (identifier, block factor, level sizes, or checksum).
+ */
+lod_pyramid read_lod(std::istream *input) {
+  std::uint32_t crc{0};
+  const auto read_bytes{[input, &crc](void *bytes, const size_t size) {
+    const std::span<char> view{static_cast<char *>(bytes), size};
+    input->read(view.data(), static_cast<std::streamsize>(size));
+    if (!*input) {
+      throw io_error("Level-of-detail pyramid is truncated.");
+    }
+    crc = crc32c(view, crc);
+  }};
+  std::array<char, lod_magic.size()> magic{};
+  std::uint64_t npts{0};
+  std::uint32_t factor{0};
+  std::uint32_t n_levels{0};
+  lod_pyramid result{};
+  read_bytes(magic.data(), magic.size());
+  if (magic != lod_magic) {
+    throw io_error("Not a level-of-detail pyramid.");
+  }
+  read_bytes(&npts, sizeof(npts));
+  read_bytes(&result.begin, sizeof(result.begin));
+  read_bytes(&result.delta, sizeof(result.delta));
+  read_bytes(&factor, sizeof(factor));
+  read_bytes(&n_levels, sizeof(n_levels));
+  result.npts = static_cast<size_t>(npts);
+  // Level sizes follow from npts, so a corrupt header cannot allocate wildly
+  size_t blocks{(result.npts + lod_factor - 1) / lod_factor};
+  size_t expected{blocks > 0 ? 1U : 0U};
+  for (; blocks > 1; ++expected) {
+    blocks = (blocks + lod_factor - 1) / lod_factor;
+  }
+  if ((factor != lod_factor) || (n_levels != expected)) {
+    throw io_error("Level-of-detail pyramid has an inconsistent header.");
+  }
+  blocks = result.npts;
+  result.levels.resize(n_levels);
+  for (std::vector<float> &level : result.levels) {
+    blocks = (blocks + lod_factor - 1) / lod_factor;
+    level.resize(2 * blocks);
+    read_bytes(level.data(), level.size() * sizeof(float));
+  }
+  const std::uint32_t computed{crc};
+  std::uint32_t checksum{0};
+  read_bytes(&checksum, sizeof(checksum));
+  if (checksum != computed) {
+    throw io_error("Level-of-detail pyramid checksum does not match.");
+  }
+  return result;
+}
+
+/*!
+  \brief Read a level-of-detail pyramid from a file.
+
+  @param[in] path std::filesystem::path File (see lod_path).
+  @returns lod_pyramid Pyramid.
+  @throw io_error If the file cannot be opened or is not a valid
+  level-of-detail pyramid.
+ */
+lod_pyramid read_lod(const std::filesystem::path &path) {
+  std::ifstream file{path, std::ifstream::binary};
+  if (!file) {
+    throw io_error(path.string() + " cannot be opened to read.");
+  }
+  return read_lod(&file);
+}
+//-----------------------------------------------------------------------------
+// Time Shifting
+//-----------------------------------------------------------------------------
+/*!
+  \brief Delay data by a (fractional) number of samples.
+
+  Afterwards data[i] is the (band-limited) value of the original data at
+  sample i - shift; samples from outside the data are zero. The sinc method is
+  a Kaiser-windowed sinc (::resample_half_width zero crossings per side, beta
+  ::resample_kaiser_beta, unit DC gain), O(npts) with errors of about 1e-4 of
+  the amplitude up to 80% of the Nyquist frequency. The FFT method multiplies
+  the zero-padded spectrum by a linear phase ramp: exact for band-limited data,
+  O(npts log(npts)).
+
+  @param[in,out] data std::span<double> Data (shifted in place).
+  @param[in] shift double Delay (samples, negative to advance).
+  @param[in] method shift_method Interpolation method.
+ */
+void fractional_shift(std::span<double> data, const double shift,
+                      const shift_method method) {
+  const size_t size{data.size()};
+  if ((size == 0) || (shift == 0.0)) {
+    return;
+  }
+  constexpr auto half{static_cast<std::ptrdiff_t>(resample_half_width)};
+  const double whole{std::round(shift)};
+  if (std::abs(whole) >= static_cast<double>(size) + half) {
+    std::ranges::fill(data, 0.0);
+    return;
+  }
+  if (method == shift_method::fft) {
+    const size_t n_fft{next_fast_size(
+        size + static_cast<size_t>(std::ceil(std::abs(shift))) +
+        (2 * resample_half_width))};
+    const std::shared_ptr<const rfft_plan> plan{rfft_plan::get(n_fft)};
+    thread_local std::vector<complex> spectrum{};
+    thread_local std::vector<double> padded{};
+    spectrum.resize(plan->bins());
+    padded.assign(n_fft, 0.0);
+    std::ranges::copy(data, padded.begin());
+    plan->forward(padded, spectrum);
+    const double step{-2.0 * std::numbers::pi_v<double> * shift /
+                      static_cast<double>(n_fft)};
+    for (size_t k{0}; k < spectrum.size(); ++k) {
+      const double phase{step * static_cast<double>(k)};
+      spectrum[k] *= complex{std::cos(phase), std::sin(phase)};
+    }
+    if (n_fft % 2 == 0) {
+      // The Nyquist bin of a real signal stays real
+      spectrum.back() = complex{
+          spectrum.back().real() * std::cos(std::numbers::pi_v<double> * shift),
+          0.0};
+    }
+    plan->inverse(spectrum, padded);
+    std::ranges::copy(std::span{padded}.first(size), data.begin());
+    return;
+  }
+  const auto offset{static_cast<std::ptrdiff_t>(whole)};
+  const double fraction{shift - whole};
+  std::array<double, (2 * resample_half_width) + 1> taps{};
+  if (fraction == 0.0) {
+    taps[resample_half_width] = 1.0;
+  } else {
+    const double window_scale{1.0 / bessel_i0(resample_kaiser_beta)};
+    const double width{static_cast<double>(resample_half_width + 1)};
+    double sum{0.0};
+    for (size_t i{0}; i < taps.size(); ++i) {
+      const double position{static_cast<double>(i) -
+                            static_cast<double>(resample_half_width) -
+                            fraction};
+      const double argument{std::numbers::pi_v<double> * position};
+      const double ratio{position / width};
+      taps[i] = std::sin(argument) / argument *
+                bessel_i0(resample_kaiser_beta *
+                          std::sqrt(std::max(0.0, 1.0 - (ratio * ratio)))) *
+                window_scale;
+      sum += taps[i];
+    }
+    for (double &tap : taps) {
+      tap /= sum;
+    }
+  }
+  thread_local std::vector<double> input{};
+  input.assign(data.begin(), data.end());
+  const auto n_input{static_cast<std::ptrdiff_t>(size)};
+  for (std::ptrdiff_t i{0}; i < n_input; ++i) {
+    // data[i] = sum over j of taps[j + half] * input[i - offset - j]
+    const std::ptrdiff_t center{i - offset};
+    const std::ptrdiff_t first{std::max(-half, center - n_input + 1)};
+    const std::ptrdiff_t last{std::min(half, center)};
+    double value{0.0};
+    for (std::ptrdiff_t j{first}; j <= last; ++j) {
+      value += taps[static_cast<size_t>(j + half)] *
+               input[static_cast<size_t>(center - j)];
+    }
+    data[static_cast<size_t>(i)] = value;
+  }
+}
+
+/*!
+  \brief Delay a Trace by a time shift.
+
+  The whole-sample part of the shift moves b (exact, no resampling); the
+  remaining fraction (at most half a sample) is interpolated into data1, so
+  the waveform arrives shift seconds later. e, depmin, depmax, and depmen are
+  updated.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace (data1).
+  @param[in] shift double Delay (seconds, negative to advance).
+  @param[in] method shift_method Interpolation method.
+  @throw processing_error If the Trace is not an evenly-sampled time-series.
+ */
+void time_shift(Trace *trace, const double shift, const shift_method method) {
+  check_time_series(*trace);
+  const double delta{trace->delta()};
+  const double samples{shift / delta};
+  const double whole{std::round(samples)};
+  trace->b(trace->b() + (whole * delta));
+  trace->e(trace->b() +
+           (static_cast<double>(std::max(trace->npts(), 1) - 1) * delta));
+  if (samples != whole) {
+    fractional_shift(trace->data1_view(), samples - whole, method);
+    trace->update_stats();
+  }
+}
+
+/*!
+  \brief Move the sample times of a Trace (keeping the waveform).
+
+  data1 is interpolated at b + offset * delta and b and e move there, so the
+  waveform stays at the same time. depmin, depmax, and depmen are updated.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace (data1).
+  @param[in] offset double Sample time offset (samples).
+  @param[in] method shift_method Interpolation method.
+  @throw processing_error If the Trace is not an evenly-sampled time-series.
+ */
+void regrid(Trace *trace, const double offset, const shift_method method) {
+  check_time_series(*trace);
+  if (offset == 0.0) {
+    return;
+  }
+  trace->b(trace->b() + (offset * trace->delta()));
+  trace->e(trace->e() + (offset * trace->delta()));
+  fractional_shift(trace->data1_view(), -offset, method);
+  trace->update_stats();
+}
+
+/*!
+  \brief Align Traces on a marker with sub-sample accuracy.
+
+  Every Trace is resampled (by at most half a sample) so that the marker
+  falls exactly on a sample: marker-aligned Traces then differ by whole
+  samples, so stacking (stacker::add) and array processing are exact. The
+  waveforms keep their timing; b and e move with the samples, the markers do
+  not.
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces
+  (the same sampling interval).
+  @param[in] marker time_marker Alignment marker.
+  @param[in] method shift_method Interpolation method.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw processing_error If any Trace is unsuitable, the sampling intervals
+  differ, or a marker is unset (checked before any processing).
+ */
+void align(std::span<Trace> traces, const time_marker marker,
+           const shift_method method, const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+    if (std::abs(trace.delta() - traces.front().delta()) >
+        merge_delta_tolerance * traces.front().delta()) {
+      throw processing_error("Traces have different sampling intervals.");
+    }
+    if (marker_time(trace, marker) == unset_double) {
+      throw processing_error("Alignment marker is not set.");
+    }
+  }
+  parallel_for(
+      traces.size(),
+      [&traces, marker, method](const size_t i) {
+        Trace &trace{traces[i]};
+        const double samples{(marker_time(trace, marker) - trace.b()) /
+                             trace.delta()};
+        regrid(&trace, samples - std::round(samples), method);
+      },
+      threads);
+}
+
+/*!
+  \brief Align Traces onto a common absolute time grid.
+
+  Every Trace is resampled (by at most half a sample) so that its samples fall
+  on multiples of delta in absolute time (since the Unix epoch), so Traces
+  with different start times share one grid. The waveforms keep their timing.
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces
+  (the same sampling interval, reference times set).
+  @param[in] method shift_method Interpolation method.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw processing_error If any Trace is unsuitable, the sampling intervals
+  differ, or a reference time is unset (checked before any processing).
+ */
+void align(std::span<Trace> traces, const shift_method method,
+           const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+    if (std::abs(trace.delta() - traces.front().delta()) >
+        merge_delta_tolerance * traces.front().delta()) {
+      throw processing_error("Traces have different sampling intervals.");
+    }
+    if (trace.reference_epoch() == unset_double) {
+      throw processing_error("Trace reference time is not set.");
+    }
+  }
+  parallel_for(
+      traces.size(),
+      [&traces, method](const size_t i) {
+        Trace &trace{traces[i]};
+        // fmod is exact, so the large epoch does not swamp the phase
+        const double delta{trace.delta()};
+        const double phase{
+            std::fmod(std::fmod(trace.reference_epoch(), delta) +
+                          std::fmod(trace.b(), delta),
+                      delta) /
+            delta};
+        regrid(&trace, std::round(phase) - phase, method);
+      },
+      threads);
+}
+//-----------------------------------------------------------------------------
+// Noise Correlation
+//-----------------------------------------------------------------------------
+/*!
+  \brief Prepare to stack ambient-noise cross-correlations.
+
+  @param[in] stations size_t Number of stations (at least 2).
+  @param[in] delta double Sampling interval.
+  @param[in] spec noise_spec Windows, normalization, and whitening.
+  @throw processing_error If there are fewer than 2 stations, delta is not
+  positive, the windows are invalid (0 <= overlap < window, max_lag <
+  window), the running window is not odd (running_mean), or the band corners
+  are invalid.
+ */
+noise_correlator::noise_correlator(const size_t stations, const double delta,
+                                   const noise_spec &spec)
+    : settings{spec}, n_stations{stations}, sampling{delta} {
+  if ((stations < 2) || !(delta > 0.0)) {
+    throw processing_error(
+        "Noise correlation requires 2 or more stations and a positive delta.");
+  }
+  if ((spec.window == 0) || (spec.overlap >= spec.window) ||
+      (spec.max_lag >= spec.window)) {
+    throw processing_error(
+        "Noise windows must satisfy 0 <= overlap < window and "
+        "max_lag < window.");
+  }
+  if ((spec.normalization == temporal_normalization::running_mean) &&
+      (spec.running_window % 2 == 0)) {
+    throw processing_error("Running absolute mean window must be odd.");
+  }
+  const response_prefilter &band{spec.band};
+  if ((band.f4 > 0.0) &&
+      !((band.f1 >= 0.0) && (band.f1 < band.f2) && (band.f2 <= band.f3) &&
+        (band.f3 < band.f4))) {
+    throw processing_error(
+        "Band corners must satisfy 0 <= f1 < f2 <= f3 < f4.");
+  }
+  // Zero padding by max_lag keeps the kept lags free of wrap-around
+  n_fft = next_fast_size(spec.window + spec.max_lag);
+  plan = rfft_plan::get(n_fft);
+  const double frequency_step{1.0 / (static_cast<double>(n_fft) * delta)};
+  size_t last_bin{plan->bins()};
+  if (band.f4 > 0.0) {
+    first_bin = std::min(
+        static_cast<size_t>(std::floor(band.f1 / frequency_step)) + 1,
+        plan->bins());
+    last_bin = std::min(
+        static_cast<size_t>(std::ceil(band.f4 / frequency_step)), last_bin);
+    last_bin = std::max(last_bin, first_bin);
+  }
+  weights.resize(last_bin - first_bin);
+  for (size_t k{0}; k < weights.size(); ++k) {
+    weights[k] = prefilter_weight(
+        band, static_cast<double>(first_bin + k) * frequency_step);
+  }
+  sums.assign(pairs() * weights.size(), complex{0.0, 0.0});
+}
+
+/*!
+  \brief Specification.
+
+  @returns noise_spec Windows, normalization, and whitening.
+ */
+const noise_spec &noise_correlator::spec() const noexcept { return settings; }
+
+/*!
+  \brief Number of stations.
+
+  @returns size_t Number of stations.
+ */
+size_t noise_correlator::stations() const noexcept { return n_stations; }
+
+/*!
+  \brief Number of station pairs.
+
+  @returns size_t stations * (stations - 1) / 2.
+ */
+size_t noise_correlator::pairs() const noexcept {
+  return n_stations * (n_stations - 1) / 2;
+}
+
+/*!
+  \brief Number of windows accumulated.
+
+  @returns size_t Number of windows.
+ */
+size_t noise_correlator::windows() const noexcept { return stacked; }
+
+/*!
+  \brief Transform size.
+
+  @returns size_t Transform size (window + max_lag, padded).
+ */
+size_t noise_correlator::fft_size() const noexcept { return n_fft; }
+
+/*!
+  \brief Number of frequency bins kept (in the band).
+
+  @returns size_t Number of bins.
+ */
+size_t noise_correlator::bins() const noexcept { return weights.size(); }
+
+/*!
+  \brief Index of a pair (first < second) in the stack.
+
+  @param[in] first size_t First station.
+  @param[in] second size_t Second station.
+  @returns size_t Pair index.
+ */
+size_t noise_correlator::pair_index(const size_t first,
+                                    const size_t second) const noexcept {
+  return (first * ((2 * n_stations) - first - 1) / 2) + (second - first - 1);
+}
+
+/*!
+  \brief Accumulate the cross-spectra of every pair with a first station.
+
+  @param[in] first size_t First station (pairs with every later station).
+  @param[in] spectra std::span<const complex> Station spectra of one window
+  (station-major, bins() values each).
+  @param[in,out] output std::span<complex> Cross-spectra (pair-major, like the
+  stack).
+ */
+void noise_correlator::accumulate(const size_t first,
+                                  std::span<const complex> spectra,
+                                  std::span<complex> output) const noexcept {
+  const size_t n_bins{weights.size()};
+  const complex *const source{spectra.data() + (first * n_bins)};
+  for (size_t j{first + 1}; j < n_stations; ++j) {
+    const complex *const receiver{spectra.data() + (j * n_bins)};
+    complex *const sum{output.data() + (pair_index(first, j) * n_bins)};
+    for (size_t k{0}; k < n_bins; ++k) {
+      sum[k] += complex_multiply(std::conj(source[k]), receiver[k]);
+    }
+  }
+}
+
+/*!
+  \brief Normalized, whitened spectrum of one window.
+
+  The window is demeaned, normalized in time (one-bit or running absolute
+  mean), transformed, and (optionally) whitened: divided by its amplitude
+  (smoothed over 2 * smoothing + 1 bins), then weighted by the band.
+
+  @param[in] data std::span<const double> Window (spec().window samples).
+  @param[out] output std::span<complex> Spectrum (bins() values, starting at
+  the first bin in the band).
+  @throw processing_error If the sizes do not match.
+ */
+void noise_correlator::spectrum(std::span<const double> data,
+                                std::span<complex> output) const {
+  if ((data.size() != settings.window) || (output.size() != weights.size())) {
+    throw processing_error("Noise window or spectrum size does not match.");
+  }
+  thread_local std::vector<double> padded{};
+  thread_local std::vector<complex> full{};
+  padded.assign(n_fft, 0.0);
+  full.resize(plan->bins());
+  const double mean{std::accumulate(data.begin(), data.end(), 0.0) /
+                    static_cast<double>(data.size())};
+  for (size_t i{0}; i < data.size(); ++i) {
+    padded[i] = data[i] - mean;
+  }
+  const std::span<double> values{padded.data(), data.size()};
+  if (settings.normalization == temporal_normalization::one_bit) {
+    for (double &value : values) {
+      value = value > 0.0 ? 1.0 : (value < 0.0 ? -1.0 : 0.0);
+    }
+  } else if (settings.normalization == temporal_normalization::running_mean) {
+    thread_local std::vector<double> magnitudes{};
+    magnitudes.resize(values.size());
+    std::ranges::transform(values, magnitudes.begin(),
+                           [](const double value) { return std::abs(value); });
+    const size_t half{settings.running_window / 2};
+    double sum{0.0};
+    size_t first{0};
+    size_t last{0};
+    for (size_t i{0}; i < values.size(); ++i) {
+      // Window [i - half, i + half] clipped to the data
+      for (; last < std::min(i + half + 1, values.size()); ++last) {
+        sum += magnitudes[last];
+      }
+      for (; first + half < i; ++first) {
+        sum -= magnitudes[first];
+      }
+      const double average{std::max(sum, 0.0) /
+                           static_cast<double>(last - first)};
+      values[i] = average > 0.0 ? values[i] / average : 0.0;
+    }
+  }
+  plan->forward(padded, full);
+  const std::span<const complex> band{full.data() + first_bin, output.size()};
+  if (!settings.whiten) {
+    for (size_t k{0}; k < output.size(); ++k) {
+      output[k] = band[k] * weights[k];
+    }
+    return;
+  }
+  thread_local std::vector<double> amplitudes{};
+  amplitudes.resize(output.size());
+  std::ranges::transform(band, amplitudes.begin(),
+                         [](const complex value) { return std::abs(value); });
+  const size_t half{settings.smoothing};
+  double sum{0.0};
+  size_t first{0};
+  size_t last{0};
+  for (size_t k{0}; k < output.size(); ++k) {
+    for (; last < std::min(k + half + 1, output.size()); ++last) {
+      sum += amplitudes[last];
+    }
+    for (; first + half < k; ++first) {
+      sum -= amplitudes[first];
+    }
+    const double amplitude{half == 0 ? amplitudes[k]
+                                     : std::max(sum, 0.0) /
+                                           static_cast<double>(last - first)};
+    output[k] = amplitude > 0.0 ? band[k] * (weights[k] / amplitude)
+                                : complex{0.0, 0.0};
+  }
+}
+
+/*!
+  \brief Accumulate one simultaneous window per station.
+
+  The station spectra are computed once (in parallel), then every pair's
+  cross-spectrum is accumulated (in parallel over the first station).
+
+  @param[in] windows std::span<const std::span<const double>> One window per
+  station (spec().window samples each).
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @throw processing_error If the number of windows or their sizes do not
+  match.
+ */
+void noise_correlator::add(std::span<const std::span<const double>> windows,
+                           const size_t threads) {
+  if (windows.size() != n_stations) {
+    throw processing_error("Number of noise windows does not match stations.");
+  }
+  for (const std::span<const double> window : windows) {
+    if (window.size() != settings.window) {
+      throw processing_error("Noise window size does not match.");
+    }
+  }
+  const size_t n_bins{weights.size()};
+  std::vector<complex> spectra(n_stations * n_bins);
+  parallel_for(
+      n_stations,
+      [this, &windows, &spectra, n_bins](const size_t i) {
+        spectrum(windows[i], std::span{spectra}.subspan(i * n_bins, n_bins));
+      },
+      threads);
+  parallel_for(
+      n_stations - 1,
+      [this, &spectra](const size_t i) { accumulate(i, spectra, sums); },
+      threads);
+  ++stacked;
+}
+
+/*!
+  \brief Split aligned Traces into windows and accumulate.
+
+  Windows start every window - overlap samples; a trailing partial window is
+  ignored. The windows are split into one contiguous chunk per thread (one
+  parallel pass for the whole call); each chunk accumulates into its own
+  partial cross-spectra, which are summed into the stack at the end.
+
+  @param[in] traces std::span<const Trace> One aligned evenly-sampled
+  time-series Trace per station (data1; see check_aligned).
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns size_t Number of windows accumulated.
+  @throw processing_error If the Traces are unsuitable, not aligned, or do not
+  match the stations or sampling interval.
+ */
+size_t noise_correlator::add(std::span<const Trace> traces,
+                             const size_t threads) {
+  if (traces.size() != n_stations) {
+    throw processing_error("Number of noise Traces does not match stations.");
+  }
+  std::vector<const Trace *> pointers{};
+  pointers.reserve(traces.size());
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+    pointers.push_back(&trace);
+  }
+  check_aligned(pointers);
+  if (std::abs(traces.front().delta() - sampling) >
+      merge_delta_tolerance * sampling) {
+    throw processing_error("Trace sampling interval differs from the stack.");
+  }
+  const size_t size{traces.front().data1_view().size()};
+  const size_t step{settings.window - settings.overlap};
+  const size_t count{size < settings.window
+                         ? 0
+                         : ((size - settings.window) / step) + 1};
+  if (count == 0) {
+    return 0;
+  }
+  size_t n_chunks{threads == 0 ? std::thread::hardware_concurrency()
+                               : threads};
+  n_chunks = std::max(size_t{1}, std::min(n_chunks, count));
+  const size_t n_bins{weights.size()};
+  std::vector<std::vector<complex>> partials(
+      n_chunks, std::vector<complex>(sums.size()));
+  parallel_for(
+      n_chunks,
+      [this, &traces, &partials, count, n_chunks, step,
+       n_bins](const size_t chunk) {
+        std::vector<complex> spectra(n_stations * n_bins);
+        const size_t first{(count * chunk) / n_chunks};
+        const size_t last{(count * (chunk + 1)) / n_chunks};
+        for (size_t index{first}; index < last; ++index) {
+          for (size_t i{0}; i < n_stations; ++i) {
+            spectrum(traces[i].data1_view().subspan(index * step,
+                                                    settings.window),
+                     std::span{spectra}.subspan(i * n_bins, n_bins));
+          }
+          for (size_t i{0}; i + 1 < n_stations; ++i) {
+            accumulate(i, spectra, partials[chunk]);
+          }
+        }
+      },
+      n_chunks);
+  for (const std::vector<complex> &partial : partials) {
+    for (size_t i{0}; i < sums.size(); ++i) {
+      sums[i] += partial[i];
+    }
+  }
+  stacked += count;
+  return count;
+}
+
+/*!
+  \brief Combine a partial stack.
+
+  @param[in] other noise_correlator Partial stack (same stations, sampling
+  interval, and specification).
+  @throw processing_error If the stacks are not compatible.
+ */
+void noise_correlator::merge(const noise_correlator &other) {
+  const noise_spec &spec{other.settings};
+  if ((other.n_stations != n_stations) || (other.sampling != sampling) ||
+      (spec.window != settings.window) || (spec.max_lag != settings.max_lag) ||
+      (spec.normalization != settings.normalization) ||
+      (spec.running_window != settings.running_window) ||
+      (spec.whiten != settings.whiten) ||
+      (spec.smoothing != settings.smoothing) ||
+      (spec.band.f1 != settings.band.f1) ||
+      (spec.band.f2 != settings.band.f2) ||
+      (spec.band.f3 != settings.band.f3) ||
+      (spec.band.f4 != settings.band.f4)) {
+    throw processing_error("Noise stacks have different specifications.");
+  }
+  stacked += other.stacked;
+  for (size_t i{0}; i < sums.size(); ++i) {
+    sums[i] += other.sums[i];
+  }
+}
+
+/*!
+  \brief Stacked correlation of a station pair.
+
+  @param[in] first size_t First station.
+  @param[in] second size_t Second station (swapping the stations reverses the
+  lags).
+  @returns std::vector<double> Mean correlation over the windows, lags
+  -max_lag to max_lag (2 * max_lag + 1 values; zero if nothing is stacked).
+  @throw processing_error If a station is out of range or both are the same.
+ */
+std::vector<double> noise_correlator::correlation(const size_t first,
+                                                  const size_t second) const {
+  if ((first >= n_stations) || (second >= n_stations) || (first == second)) {
+    throw processing_error("Noise correlation requires two distinct stations.");
+  }
+  const size_t max_lag{settings.max_lag};
+  std::vector<double> result((2 * max_lag) + 1, 0.0);
+  if (stacked == 0) {
+    return result;
+  }
+  const size_t n_bins{weights.size()};
+  const size_t pair{pair_index(std::min(first, second),
+                               std::max(first, second))};
+  thread_local std::vector<complex> full{};
+  thread_local std::vector<double> lags{};
+  full.assign(plan->bins(), complex{0.0, 0.0});
+  lags.resize(n_fft);
+  const double scale{1.0 / static_cast<double>(stacked)};
+  for (size_t k{0}; k < n_bins; ++k) {
+    full[first_bin + k] = sums[(pair * n_bins) + k] * scale;
+  }
+  plan->inverse(full, lags);
+  for (size_t k{0}; k <= max_lag; ++k) {
+    result[max_lag + k] = lags[k];
+    result[max_lag - k] = lags[(n_fft - k) % n_fft];
+  }
+  if (first > second) {
+    std::ranges::reverse(result);
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Phase Picking
+//-----------------------------------------------------------------------------
+/*!
+  \brief AIC characteristic function (Maeda).
+
+  \f$AIC(k) = k\log(\mathrm{var}(x[0,k))) +
+  (N - k)\log(\mathrm{var}(x[k,N)))\f$: the minimum is the sample that best
+  splits the data into noise before and signal after (the onset). Variances
+  come from running sums in both directions, so the cost is O(N).
+
+  @param[in] data std::span<const double> Data (a window around the onset).
+  @param[out] output std::span<double> AIC (data.size() values; +infinity
+  where either side has fewer than 2 samples).
+ */
+void aic_function(std::span<const double> data,
+                  std::span<double> output) noexcept {
+  const size_t size{std::min(data.size(), output.size())};
+  std::fill(output.begin(),
+            output.begin() + static_cast<std::ptrdiff_t>(size),
+            std::numeric_limits<double>::infinity());
+  if (size < 4) {
+    return;
+  }
+  // Centering limits cancellation in the running variances
+  const std::span<const double> values{data.first(size)};
+  const double mean{std::accumulate(values.begin(), values.end(), 0.0) /
+                    static_cast<double>(size)};
+  thread_local std::vector<double> suffix{};
+  suffix.resize(size + 1);
+  suffix[size] = 0.0;
+  double total{0.0};
+  double total_squares{0.0};
+  for (size_t i{size}; i-- > 0;) {
+    const double value{data[i] - mean};
+    total += value;
+    total_squares += value * value;
+    suffix[i] = total_squares;
+  }
+  constexpr double smallest{std::numeric_limits<double>::min()};
+  double sum{0.0};
+  double squares{0.0};
+  for (size_t k{1}; k < size; ++k) {
+    const double value{data[k - 1] - mean};
+    sum += value;
+    squares += value * value;
+    if ((k < 2) || (size - k < 2)) {
+      continue;
+    }
+    const auto before{static_cast<double>(k)};
+    const auto after{static_cast<double>(size - k)};
+    const double tail{total - sum};
+    const double variance_before{(squares - (sum * sum / before)) / before};
+    const double variance_after{(suffix[k] - (tail * tail / after)) / after};
+    output[k] = (before * std::log(std::max(variance_before, smallest))) +
+                (after * std::log(std::max(variance_after, smallest)));
+  }
+}
+
+/*!
+  \brief Sliding excess kurtosis characteristic function.
+
+  The excess kurtosis of the trailing window [i - window + 1, i] rises
+  sharply when the window reaches an impulsive onset. Power sums are updated
+  in O(1) per sample (recomputed exactly once per window to bound rounding).
+
+  @param[in] data std::span<const double> Data.
+  @param[in] window size_t Window length (samples, at least 4).
+  @param[out] output std::span<double> Excess kurtosis (data.size() values;
+  0 until the window is filled, where the window is constant, or if the window
+  is shorter than 4 samples).
+ */
+void kurtosis_function(std::span<const double> data, const size_t window,
+                       std::span<double> output) noexcept {
+  const size_t size{std::min(data.size(), output.size())};
+  std::fill(output.begin(),
+            output.begin() + static_cast<std::ptrdiff_t>(size), 0.0);
+  if ((window < 4) || (size < window)) {
+    return;
+  }
+  const auto n_window{static_cast<double>(window)};
+  std::array<double, 4> sums{};
+  const auto add{[&sums](const double value, const double sign) {
+    const double square{value * value};
+    sums[0] += sign * value;
+    sums[1] += sign * square;
+    sums[2] += sign * square * value;
+    sums[3] += sign * square * square;
+  }};
+  for (size_t i{window - 1}; i < size; ++i) {
+    if ((i + 1) % window == 0) {
+      sums.fill(0.0);
+      for (size_t j{i + 1 - window}; j <= i; ++j) {
+        add(data[j], 1.0);
+      }
+    } else {
+      add(data[i], 1.0);
+      add(data[i - window], -1.0);
+    }
+    const double mean{sums[0] / n_window};
+    const double mean_square{mean * mean};
+    const double m2{(sums[1] / n_window) - mean_square};
+    const double m4{(sums[3] / n_window) - (4.0 * mean * sums[2] / n_window) +
+                    (6.0 * mean_square * sums[1] / n_window) -
+                    (3.0 * mean_square * mean_square)};
+    if (m2 > 1e-12 * (sums[1] / n_window)) {
+      output[i] = (m4 / (m2 * m2)) - 3.0;
+    }
+  }
+}
+
+/*!
+  \brief Pick a phase near a predicted time.
+
+  The search window is [predicted - before, predicted + after]:
+
+  - picker_method::aic: the AIC minimum in the window.
+  - picker_method::kurtosis: the steepest rise of the sliding kurtosis
+  (computed from a window earlier, so it is defined across the search window).
+  - picker_method::sta_lta: the first classic STA/LTA ratio at or above on
+  (averages from up to lta before the window), refined by the AIC minimum
+  from two short windows before the crossing to one after it.
+
+  The signal-to-noise ratio is the RMS of the spec window after the pick over
+  the RMS of the spec window before it. Picks with at least min_snr are
+  written to the spec marker with the spec label.
+
+  @param[in,out] trace Trace* Evenly-sampled time-series Trace (data1).
+  @param[in] predicted double Predicted time (like b; unset_double for none).
+  @param[in] spec pick_spec Method, windows, and pick header.
+  @returns phase_pick Pick (time unset if there is no pick or the SNR is too
+  low).
+  @throw processing_error If the Trace is not an evenly-sampled time-series or
+  the specification is invalid (windows, or a marker other than t0 to t9).
+ */
+phase_pick pick_phase(Trace *trace, const double predicted,
+                      const pick_spec &spec) {
+  check_time_series(*trace);
+  if ((spec.marker < time_marker::t0) || !(spec.before >= 0.0) ||
+      !(spec.after >= 0.0) || !(spec.window > 0.0) ||
+      ((spec.method == picker_method::sta_lta) &&
+       (!(spec.lta > spec.window) || !(spec.on > 0.0)))) {
+    throw processing_error(
+        "Picks need non-negative search windows, a positive window (shorter "
+        "than lta for STA/LTA), and a t0 to t9 marker.");
+  }
+  phase_pick result{};
+  const std::span<const double> data{trace->data1_view()};
+  if ((predicted == unset_double) || data.empty()) {
+    return result;
+  }
+  const double delta{trace->delta()};
+  const double begin{trace->b() != unset_double ? trace->b() : 0.0};
+  const auto to_sample{[begin, delta, &data](const double time) {
+    return static_cast<std::ptrdiff_t>(std::clamp(
+        std::round((time - begin) / delta), 0.0,
+        static_cast<double>(data.size())));
+  }};
+  const auto first{static_cast<size_t>(to_sample(predicted - spec.before))};
+  const auto last{static_cast<size_t>(
+      std::min(to_sample(predicted + spec.after) + 1,
+               static_cast<std::ptrdiff_t>(data.size())))};
+  const auto n_window{static_cast<size_t>(
+      std::max(std::round(spec.window / delta), 1.0))};
+  if ((last < first) || (last - first < 4)) {
+    return result;
+  }
+  thread_local std::vector<double> function{};
+  const auto aic_minimum{[&data](const size_t low, const size_t high) {
+    function.resize(high - low);
+    aic_function(data.subspan(low, high - low), function);
+    return low + static_cast<size_t>(std::ranges::min_element(function) -
+                                     function.begin());
+  }};
+  size_t onset{0};
+  switch (spec.method) {
+  case picker_method::aic:
+    onset = aic_minimum(first, last);
+    break;
+  case picker_method::kurtosis: {
+    const size_t start{first - std::min(first, n_window)};
+    function.resize(last - start);
+    kurtosis_function(data.subspan(start, last - start), n_window, function);
+    double steepest{-std::numeric_limits<double>::infinity()};
+    for (size_t i{std::max(first, start + n_window)}; i < last; ++i) {
+      const double rise{function[i - start] - function[i - start - 1]};
+      if (rise > steepest) {
+        steepest = rise;
+        onset = i;
+      }
+    }
+    if (steepest <= 0.0) {
+      return result;
+    }
+    break;
+  }
+  case picker_method::sta_lta: {
+    const auto n_lta{static_cast<size_t>(std::round(spec.lta / delta))};
+    const size_t start{first - std::min(first, n_lta)};
+    sta_lta detector{n_window, n_lta, sta_lta_method::classic};
+    function.resize(last - start);
+    detector.process(data.subspan(start, last - start), function);
+    const auto crossing{std::find_if(
+        function.begin() + static_cast<std::ptrdiff_t>(first - start),
+        function.end(),
+        [&spec](const double ratio) { return ratio >= spec.on; })};
+    if (crossing == function.end()) {
+      return result;
+    }
+    const size_t index{start +
+                       static_cast<size_t>(crossing - function.begin())};
+    const size_t low{index - std::min(index, 2 * n_window)};
+    const size_t high{std::min(index + n_window + 1, data.size())};
+    onset = aic_minimum(low, high);
+    break;
+  }
+  }
+  const auto rms{[&data](const size_t low, const size_t high) {
+    double sum{0.0};
+    for (size_t i{low}; i < high; ++i) {
+      sum += data[i] * data[i];
+    }
+    return high > low ? std::sqrt(sum / static_cast<double>(high - low)) : 0.0;
+  }};
+  const double noise{rms(onset - std::min(onset, n_window), onset)};
+  const double signal{rms(onset, std::min(onset + n_window, data.size()))};
+  result.snr = noise > 0.0 ? signal / noise
+                           : (signal > 0.0
+                                  ? std::numeric_limits<double>::infinity()
+                                  : 0.0);
+  if (result.snr < spec.min_snr) {
+    return result;
+  }
+  result.time = begin + (static_cast<double>(onset) * delta);
+  constexpr std::array<const char *, 3> default_labels{"AIC", "KURT",
+                                                       "STA/LTA"};
+  write_pick(trace, spec.marker, result.time,
+             spec.label.empty()
+                 ? std::string{default_labels[static_cast<size_t>(
+                       spec.method)]}
+                 : spec.label);
+  return result;
+}
+
+/*!
+  \brief Pick phases near a predicted marker on many Traces.
+
+  Traces without the predicted marker get no pick.
+
+  @param[in,out] traces std::span<Trace> Evenly-sampled time-series Traces.
+  @param[in] predicted time_marker Marker holding the predicted time.
+  @param[in] spec pick_spec Method, windows, and pick header.
+  @param[in] threads size_t Number of threads (0 = hardware concurrency).
+  @returns std::vector<phase_pick> Pick per Trace.
+  @throw processing_error If any Trace is unsuitable (checked before any
+  processing) or the specification is invalid.
+ */
+std::vector<phase_pick> pick_phases(std::span<Trace> traces,
+                                    const time_marker predicted,
+                                    const pick_spec &spec,
+                                    const size_t threads) {
+  for (const Trace &trace : traces) {
+    check_time_series(trace);
+  }
+  std::vector<phase_pick> result(traces.size());
+  parallel_for(
+      traces.size(),
+      [&traces, predicted, &spec, &result](const size_t i) {
+        result[i] = pick_phase(&traces[i], marker_time(traces[i], predicted),
+                               spec);
+      },
+      threads);
+  return result;
+}
+}  // namespace sacfmt
@@ -401,10 +401,10 @@ word_four concat_words(const word_pair<word_two> &pair_words) noexcept {
   Note that this modifies the position of the reader within the stream (to the
   end of the read word).
 
-  @param[in, out] sac std::ifstream* Input binary SAC-file.
+  @param[in, out] sac std::istream* Input binary SAC-file.
   @returns ::word_one Binary bitset representation of single word.
  */
-word_one read_word(std::ifstream *sac) {
+word_one read_word(std::istream *sac) {
   word_one bits{};
   constexpr size_t char_size{bits_per_byte};
   // Where we will store the characters
@@ -433,10 +433,10 @@ word_one read_word(std::ifstream *sac) {
   Note that this modifies the position of the reader within the stream (to the
   end of the read words).
 
-  @param[in, out] sac std::ifstream* Input binary SAC-file.
+  @param[in, out] sac std::istream* Input binary SAC-file.
   @returns ::word_two Binary bitset representation of two words.
  */
-word_two read_two_words(std::ifstream *sac) {
+word_two read_two_words(std::istream *sac) {
   const word_one first_word{read_word(sac)};
   const word_one second_word{read_word(sac)};
   word_pair<word_one> pair_words{};
@@ -456,10 +456,10 @@ word_two read_two_words(std::ifstream *sac) {
   Note that this modifies the position of the reader within the stream (to the
   end of the read words).
 
-  @param[in, out] sac std::ifstream* Input binary SAC-file.
+  @param[in, out] sac std::istream* Input binary SAC-file.
   @returns ::word_four Binary bitset representation of four words.
  */
-word_four read_four_words(std::ifstream *sac) {
+word_four read_four_words(std::istream *sac) {
   const word_two first_words{read_two_words(sac)};
   const word_two second_words{read_two_words(sac)};
   word_pair<word_two> pair_words{};
@@ -480,17 +480,48 @@ word_four read_four_words(std::ifstream *sac) {
   Note that this modifies the position of the reader within the stream (to the
   end of the read words).
 
+  Words are read in chunks of ::io_chunk values (one stream read per chunk)
+  and, if requested, the raw bytes are added to a running CRC-32C in the same
+  pass.
+
   @param[in, out] sac std::ifstream* Input binary SAC-file.
   @param[in] spec read_spec Reading specification.
+  @param[in, out] crc std::uint32_t* Running CRC-32C to update (optional).
   @returns std::vector<double> Data vector read in.
  */
-std::vector<double> read_data(std::ifstream *sac, const read_spec &spec) {
+std::vector<double> read_data(std::ifstream *sac, const read_spec &spec,
+                              std::uint32_t *crc) {
   sac->seekg(word_position(spec.start_word));
   std::vector<double> result{};
   result.resize(spec.num_words);
-  std::for_each(result.begin(), result.end(), [&sac](double &value) {
-    value = static_cast<double>(binary_to_float(read_word(sac)));
-  });
+  std::vector<char> buffer(std::min(io_chunk, spec.num_words) * word_length);
+  for (size_t start{0}; start < spec.num_words; start += io_chunk) {
+    const size_t count{std::min(io_chunk, spec.num_words - start)};
+    const size_t n_bytes{count * word_length};
+    // flawfinder: ignore
+    if (!sac->read(buffer.data(), static_cast<std::streamsize>(n_bytes))) {
+      break;
+    }
+    if (crc != nullptr) {
+      *crc = crc32c(std::span<const char>{buffer.data(), n_bytes}, *crc);
+    }
+    // SAC-files are little-endian
+    for (size_t i{0}; i < count; ++i) [[likely]] {
+      const size_t pos{i * word_length};
+      const std::uint32_t bits{
+          static_cast<std::uint32_t>(static_cast<unsigned char>(buffer[pos])) |
+          (static_cast<std::uint32_t>(
+               static_cast<unsigned char>(buffer[pos + 1]))
+           << bits_per_byte) |
+          (static_cast<std::uint32_t>(
+               static_cast<unsigned char>(buffer[pos + 2]))
+           << (2 * bits_per_byte)) |
+          (static_cast<std::uint32_t>(
+               static_cast<unsigned char>(buffer[pos + 3]))
+           << (3 * bits_per_byte))};
+      result[start + i] = static_cast<double>(std::bit_cast<float>(bits));
+    }
+  }
   return result;
 }
 //-----------------------------------------------------------------------------
@@ -503,16 +534,14 @@ std::vector<double> read_data(std::ifstream *sac, const read_spec &spec) {
   Note that this modifies the position of the writer within the stream (to the
   end of the written words).
 
-  @param[in, out] sac_file std::ofstream* Output binary SAC-file.
+  @param[in, out] sac_file std::ostream* Output binary SAC-file.
   @param[in] input std::vector<char> Character vector representation of data for
   writing.
  */
-void write_words(std::ofstream *sac_file, const std::vector<char> &input) {
-  std::ofstream &sac = *sac_file;
-  if (sac.is_open()) {
-    std::for_each(input.begin(), input.end(), [&sac](const char &character) {
-      sac.write(&character, sizeof(char));
-    });
+void write_words(std::ostream *sac_file, const std::vector<char> &input) {
+  std::ostream &sac = *sac_file;
+  if (sac.good()) {
+    sac.write(input.data(), static_cast<std::streamsize>(input.size()));
   }
 }
 
@@ -623,12 +652,8 @@ bool equal_within_tolerance(const std::vector<double> &vector1,
   if (vector1.size() != vector2.size()) {
     return false;
   }
-  for (size_t i{0}; i < vector1.size(); ++i) [[likely]] {
-    if (!equal_within_tolerance(vector1[i], vector2[i], tolerance)) {
-      return false;
-    }
-  }
-  return true;
+  return first_mismatch(vector1, vector2, tolerance_spec{tolerance, 0}) ==
+         no_mismatch;
 }
 
 /*!
@@ -645,6 +670,323 @@ bool equal_within_tolerance(const double val1, const double val2,
                             const double tolerance) noexcept {
   return std::abs(val1 - val2) < tolerance;
 }
+
+/*!
+  \brief Distance between two values in units-in-the-last-place.
+
+  The values are compared at single-precision (SAC data precision). The
+  IEEE-754 bit patterns are mapped onto a monotonic integer line, so that the
+  distance between adjacent representable floats is 1 (+0.0 and -0.0 are
+  identical).
+
+  @param[in] val1 First value in comparison.
+  @param[in] val2 Second value in comparison.
+  @returns std::int64_t ULP distance (maximum value if either is NaN).
+ */
+std::int64_t ulp_distance(const float val1, const float val2) noexcept {
+  if (std::isnan(val1) || std::isnan(val2)) {
+    return std::numeric_limits<std::int64_t>::max();
+  }
+  const auto ordered = [](const float value) {
+    const std::int64_t bits{std::bit_cast<std::int32_t>(value)};
+    return (bits < 0 ? std::numeric_limits<std::int32_t>::min() - bits : bits);
+  };
+  const std::int64_t diff{ordered(val1) - ordered(val2)};
+  return (diff < 0 ? -diff : diff);
+}
+
+/*!
+  \brief Count values outside tolerance in a block (branch-free).
+
+  Written without early exits so the compiler can vectorize it.
+
+  @param[in] first Pointer to first value of first block.
+  @param[in] second Pointer to first value of second block.
+  @param[in] size Number of values in the block.
+  @param[in] spec tolerance_spec Comparison tolerances.
+  @returns size_t Number of values outside tolerance.
+ */
+size_t count_mismatches(const double *first, const double *second,
+                        const size_t size,
+                        const tolerance_spec &spec) noexcept {
+  size_t count{0};
+  if (spec.ulps > 0) {
+    const std::int64_t ulps{spec.ulps};
+    for (size_t i{0}; i < size; ++i) {
+      const bool close{std::abs(first[i] - second[i]) < spec.absolute};
+      const bool ulp_close{ulp_distance(static_cast<float>(first[i]),
+                                        static_cast<float>(second[i])) <=
+                           ulps};
+      count += static_cast<size_t>(!(close || ulp_close));
+    }
+  } else {
+    for (size_t i{0}; i < size; ++i) {
+      count += static_cast<size_t>(
+          !(std::abs(first[i] - second[i]) < spec.absolute));
+    }
+  }
+  return count;
+}
+
+/*!
+  \brief Find the first element outside tolerance.
+
+  Compares in blocks of ::compare_block values, only falling back to scalar
+  comparison inside the first block with a mismatch. Only the common length of
+  the vectors is compared.
+
+  @param[in] vector1 First data vector in comparison.
+  @param[in] vector2 Second data vector in comparison.
+  @param[in] spec tolerance_spec Comparison tolerances.
+  @returns size_t Index of first mismatch (::no_mismatch if none).
+ */
+size_t first_mismatch(std::span<const double> vector1,
+                      std::span<const double> vector2,
+                      const tolerance_spec &spec) noexcept {
+  const size_t size{std::min(vector1.size(), vector2.size())};
+  for (size_t start{0}; start < size; start += compare_block) {
+    const size_t block{std::min(compare_block, size - start)};
+    if (count_mismatches(&vector1[start], &vector2[start], block, spec) > 0)
+        [[unlikely]] {
+      for (size_t i{start}; i < start + block; ++i) {
+        if (count_mismatches(&vector1[i], &vector2[i], 1, spec) > 0) {
+          return i;
+        }
+      }
+    }
+  }
+  return no_mismatch;
+}
+
+/*!
+  \brief Compare two data vectors without stopping at the first mismatch.
+
+  If the vectors differ in length, the excess values count as mismatches and
+  the first mismatch is no later than the end of the shorter vector.
+
+  @param[in] vector1 First data vector in comparison.
+  @param[in] vector2 Second data vector in comparison.
+  @param[in] spec tolerance_spec Comparison tolerances.
+  @returns data_comparison Summary of the differences.
+ */
+data_comparison compare_data(std::span<const double> vector1,
+                             std::span<const double> vector2,
+                             const tolerance_spec &spec) noexcept {
+  data_comparison result{};
+  const size_t size{std::min(vector1.size(), vector2.size())};
+  for (size_t start{0}; start < size; start += compare_block) {
+    const size_t block{std::min(compare_block, size - start)};
+    double max_error{0.0};
+    for (size_t i{start}; i < start + block; ++i) {
+      const double error{std::abs(vector1[i] - vector2[i])};
+      max_error = (error > max_error ? error : max_error);
+    }
+    result.max_abs_error = std::max(result.max_abs_error, max_error);
+    const size_t count{
+        count_mismatches(&vector1[start], &vector2[start], block, spec)};
+    if ((count > 0) && (result.mismatches == 0)) {
+      result.first_mismatch =
+          start + first_mismatch(vector1.subspan(start, block),
+                                 vector2.subspan(start, block), spec);
+    }
+    result.mismatches += count;
+  }
+  const size_t excess{std::max(vector1.size(), vector2.size()) - size};
+  if ((excess > 0) && (result.mismatches == 0)) {
+    result.first_mismatch = size;
+  }
+  result.mismatches += excess;
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Checksums
+//-----------------------------------------------------------------------------
+//! Slicing-by-8 lookup tables for CRC-32C.
+using crc_table = std::array<std::array<std::uint32_t, 256>, 8>;
+
+/*!
+  \brief Build the slicing-by-8 CRC-32C lookup tables (compile-time).
+
+  @returns crc_table Lookup tables.
+ */
+constexpr crc_table make_crc32c_table() noexcept {
+  crc_table table{};
+  for (std::uint32_t i{0}; i < 256; ++i) {
+    std::uint32_t crc{i};
+    for (size_t bit{0}; bit < bits_per_byte; ++bit) {
+      crc = ((crc & 1U) != 0 ? (crc >> 1U) ^ crc32c_polynomial : crc >> 1U);
+    }
+    table[0][i] = crc;
+  }
+  for (std::uint32_t i{0}; i < 256; ++i) {
+    for (size_t slice{1}; slice < table.size(); ++slice) {
+      const std::uint32_t prev{table[slice - 1][i]};
+      table[slice][i] = (prev >> bits_per_byte) ^ table[0][prev & 0xFFU];
+    }
+  }
+  return table;
+}
+
+//! CRC-32C lookup tables.
+constexpr crc_table crc32c_table{make_crc32c_table()};
+
+/*!
+  \brief Update a CRC-32C checksum with additional bytes.
+
+  Uses slicing-by-8 (eight bytes per step). Chaining calls is equivalent to a
+  single call over the concatenated bytes (start with crc = 0).
+
+  @param[in] bytes std::span<const char> Bytes to add to the checksum.
+  @param[in] crc std::uint32_t Checksum of all previous bytes (default 0).
+  @returns std::uint32_t Updated checksum.
+ */
+std::uint32_t crc32c(std::span<const char> bytes,
+                     const std::uint32_t crc) noexcept {
+  constexpr std::uint32_t mask{0xFFU};
+  const auto byte = [&bytes](const size_t index) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[index]));
+  };
+  std::uint32_t result{~crc};
+  size_t pos{0};
+  for (; pos + 8 <= bytes.size(); pos += 8) [[likely]] {
+    const std::uint32_t low{result ^ (byte(pos) | (byte(pos + 1) << 8U) |
+                                      (byte(pos + 2) << 16U) |
+                                      (byte(pos + 3) << 24U))};
+    const std::uint32_t high{byte(pos + 4) | (byte(pos + 5) << 8U) |
+                             (byte(pos + 6) << 16U) | (byte(pos + 7) << 24U)};
+    result = crc32c_table[7][low & mask] ^ crc32c_table[6][(low >> 8U) & mask] ^
+             crc32c_table[5][(low >> 16U) & mask] ^
+             crc32c_table[4][low >> 24U] ^ crc32c_table[3][high & mask] ^
+             crc32c_table[2][(high >> 8U) & mask] ^
+             crc32c_table[1][(high >> 16U) & mask] ^
+             crc32c_table[0][high >> 24U];
+  }
+  for (; pos < bytes.size(); ++pos) {
+    result = crc32c_table[0][(result ^ byte(pos)) & mask] ^ (result >> 8U);
+  }
+  return ~result;
+}
+
+/*!
+  \brief Path of the fingerprint sidecar file for a SAC-file.
+
+  @param[in] path std::filesystem::path SAC-file.
+  @returns std::filesystem::path Sidecar path (SAC-file path + ".crc32c").
+ */
+std::filesystem::path fingerprint_path(const std::filesystem::path &path) {
+  std::filesystem::path result{path};
+  result += ".crc32c";
+  return result;
+}
+
+/*!
+  \brief Write fingerprint sidecar file for a SAC-file.
+
+  The sidecar holds one line: the checksum (8 hexadecimal digits), two spaces,
+  and the SAC-file name (the layout used by common checksum utilities).
+
+  @param[in] path std::filesystem::path SAC-file.
+  @param[in] fingerprint std::uint32_t CRC-32C of the SAC-file.
+  @throw io_error If the sidecar cannot be written.
+ */
+void write_fingerprint(const std::filesystem::path &path,
+                       const std::uint32_t fingerprint) {
+  const std::filesystem::path sidecar{fingerprint_path(path)};
+  std::ofstream file(sidecar, std::ios::out | std::ios::trunc);
+  if (!file) {
+    throw io_error(sidecar.string() + " cannot be opened to write.");
+  }
+  file << std::hex << std::setw(2 * word_length) << std::setfill('0')
+       << fingerprint << "  " << path.filename().string() << '\n';
+}
+
+/*!
+  \brief Read fingerprint sidecar file for a SAC-file.
+
+  @param[in] path std::filesystem::path SAC-file (not the sidecar).
+  @returns std::uint32_t Stored CRC-32C.
+  @throw io_error If the sidecar cannot be read or is malformed.
+ */
+std::uint32_t read_fingerprint(const std::filesystem::path &path) {
+  const std::filesystem::path sidecar{fingerprint_path(path)};
+  std::ifstream file(sidecar);
+  if (!file) {
+    throw io_error(sidecar.string() + " cannot be opened to read.");
+  }
+  std::uint32_t result{};
+  if (!(file >> std::hex >> result)) {
+    throw io_error(sidecar.string() + " is not a valid fingerprint file.");
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------
+// Statistics
+//-----------------------------------------------------------------------------
+/*!
+  \brief Single-pass statistics of a data vector.
+
+  Minimum, maximum, sum, and sum-of-squares are accumulated together in
+  ::stats_lanes independent lanes (branch-free, auto-vectorizable), then
+  reduced. Sums are taken relative to the first value (shifted data) to limit
+  cancellation in the variance.
+
+  @param[in] data std::span<const double> Data vector.
+  @returns data_stats Statistics (unset if data is empty).
+ */
+data_stats compute_stats(std::span<const double> data) noexcept {
+  data_stats result{};
+  const size_t size{data.size()};
+  if (size == 0) {
+    return result;
+  }
+  const double shift{data[0]};
+  std::array<double, stats_lanes> lows{};
+  std::array<double, stats_lanes> highs{};
+  std::array<double, stats_lanes> sums{};
+  std::array<double, stats_lanes> squares{};
+  lows.fill(shift);
+  highs.fill(shift);
+  size_t pos{0};
+  for (; pos + stats_lanes <= size; pos += stats_lanes) [[likely]] {
+    for (size_t lane{0}; lane < stats_lanes; ++lane) {
+      const double value{data[pos + lane]};
+      const double shifted{value - shift};
+      lows[lane] = (value < lows[lane] ? value : lows[lane]);
+      highs[lane] = (value > highs[lane] ? value : highs[lane]);
+      sums[lane] += shifted;
+      squares[lane] += shifted * shifted;
+    }
+  }
+  for (size_t lane{0}; pos < size; ++pos, ++lane) {
+    const double value{data[pos]};
+    const double shifted{value - shift};
+    lows[lane] = (value < lows[lane] ? value : lows[lane]);
+    highs[lane] = (value > highs[lane] ? value : highs[lane]);
+    sums[lane] += shifted;
+    squares[lane] += shifted * shifted;
+  }
+  double sum{0.0};
+  double square{0.0};
+  result.min = lows[0];
+  result.max = highs[0];
+  for (size_t lane{0}; lane < stats_lanes; ++lane) {
+    result.min = std::min(result.min, lows[lane]);
+    result.max = std::max(result.max, highs[lane]);
+    sum += sums[lane];
+    square += squares[lane];
+  }
+  const auto count{static_cast<double>(size)};
+  const double shifted_mean{sum / count};
+  result.count = size;
+  result.mean = shift + shifted_mean;
+  result.stddev = std::sqrt(
+      std::max(0.0, (square / count) - (shifted_mean * shifted_mean)));
+  // sum(x^2) = sum((y + shift)^2) with y = x - shift
+  const double raw_square{square + (2.0 * shift * sum) +
+                          (count * shift * shift)};
+  result.rms = std::sqrt(std::max(0.0, raw_square / count));
+  return result;
+}
 // Position methods
 /*!
   \brief Convert decimal degrees to radians.
@@ -894,6 +1236,50 @@ bool Trace::operator==(const Trace &other) const noexcept {
   }
   return true;
 }
+
+/*!
+  \brief Compare two Traces, reporting all differences.
+
+  Header fields are compared exactly (as in Trace::operator==, but booleans
+  are included), data vectors are compared using the provided tolerances.
+
+  @param[in] trace1 First Trace in comparison.
+  @param[in] trace2 Second Trace in comparison.
+  @param[in] spec tolerance_spec Data comparison tolerances.
+  @returns trace_comparison Report of all differences.
+ */
+trace_comparison compare(const Trace &trace1, const Trace &trace2,
+                         const tolerance_spec &spec) {
+  trace_comparison result{};
+  const auto first{static_cast<int>(name::depmin)};
+  const auto last{static_cast<int>(name::kinst)};
+  const auto first_double{static_cast<int>(name::delta)};
+  const auto first_int{static_cast<int>(name::nzyear)};
+  const auto first_bool{static_cast<int>(name::leven)};
+  const auto first_string{static_cast<int>(name::kstnm)};
+  for (int value{first}; value <= last; ++value) {
+    const auto field{static_cast<name>(value)};
+    const size_t index{sac_map.at(field)};
+    bool same{};
+    if (value < first_double) {
+      same = (trace1.floats[index] == trace2.floats[index]);
+    } else if (value < first_int) {
+      same = (trace1.doubles[index] == trace2.doubles[index]);
+    } else if (value < first_bool) {
+      same = (trace1.ints[index] == trace2.ints[index]);
+    } else if (value < first_string) {
+      same = (trace1.bools[index] == trace2.bools[index]);
+    } else {
+      same = (trace1.strings[index] == trace2.strings[index]);
+    }
+    if (!same) {
+      result.headers.push_back(field);
+    }
+  }
+  result.data1 = compare_data(trace1.data[0], trace2.data[0], spec);
+  result.data2 = compare_data(trace1.data[1], trace2.data[1], spec);
+  return result;
+}
 // Convenience functions
 /*!
   \brief Calculates gcarc, dist, az, and baz from stla, stlo, evla, and evlo.
@@ -929,6 +1315,40 @@ double Trace::frequency() const noexcept {
   return 1.0 / delta_val;
 }
 
+/*!
+  \brief Get SAC-file fingerprint.
+
+  The fingerprint is the CRC-32C of the SAC-file bytes (header, data, and
+  footer) computed while the Trace was read. Any setter or writable data view
+  drops it (the Trace may no longer match the file). Trace::write returns the
+  checksum of the bytes it writes instead of caching it, so writing stays const
+  and thread-safe.
+
+  @returns std::optional<std::uint32_t> Fingerprint (empty if the Trace was
+  not read from a SAC-file or has been modified since).
+ */
+std::optional<std::uint32_t> Trace::fingerprint() const noexcept {
+  return checksum;
+}
+
+/*!
+  \brief Update depmin, depmax, and depmen from data1.
+
+  Computed in a single pass (see compute_stats). If data1 is empty the headers
+  are unset.
+
+  @returns data_stats Statistics of data1 (includes RMS and standard
+  deviation).
+ */
+data_stats Trace::update_stats() noexcept {
+  const data_stats stats{compute_stats(data[sac_map.at(name::data1)])};
+  // Unset values (empty data) convert exactly to unset_float
+  depmin(static_cast<float>(stats.min));
+  depmax(static_cast<float>(stats.max));
+  depmen(static_cast<float>(stats.mean));
+  return stats;
+}
+
 /*!
   \brief Determine if locations are set for geometry calculation.
 
@@ -1022,6 +1442,39 @@ std::string Trace::time() const noexcept {
   return oss.str();
 }
 
+/*!
+  \brief Get the reference time as seconds since 1970-01-01T00:00:00 (UTC).
+
+  Absolute time of sample i is reference_epoch() + b + (i * delta). Uses the
+  proleptic Gregorian calendar (days from civil) so no time-zone database is
+  needed.
+
+  @returns double Reference time (seconds since the Unix epoch), or
+  unset_double if any of nzyear, nzjday, nzhour, nzmin, nzsec, and nzmsec is
+  unset.
+ */
+double Trace::reference_epoch() const noexcept {
+  if ((nzyear() == unset_int) || (nzjday() == unset_int) ||
+      (nzhour() == unset_int) || (nzmin() == unset_int) ||
+      (nzsec() == unset_int) || (nzmsec() == unset_int)) {
+    return unset_double;
+  }
+  // Days from 1970-01-01 to January 1st of nzyear (March-based era math)
+  const std::int64_t year{static_cast<std::int64_t>(nzyear()) - 1};
+  const std::int64_t era{(year >= 0 ? year : year - 399) / 400};
+  const std::int64_t year_of_era{year - (era * 400)};
+  constexpr std::int64_t january_first{306};  // day of the March-based year
+  const std::int64_t day_of_era{(365 * year_of_era) + (year_of_era / 4) -
+                                (year_of_era / 100) + january_first};
+  constexpr std::int64_t epoch_offset{719468};  // 0000-03-01 to 1970-01-01
+  const std::int64_t days{(era * 146097) + day_of_era - epoch_offset +
+                          nzjday() - 1};
+  constexpr double seconds_per_day{86400.0};
+  return (static_cast<double>(days) * seconds_per_day) +
+         (nzhour() * 3600.0) + (nzmin() * 60.0) + nzsec() +
+         (nzmsec() / 1000.0);
+}
+
 // Getters
 // Floats
 float Trace::depmin() const noexcept {
@@ -1211,175 +1664,247 @@ std::vector<double> Trace::data1() const noexcept {
 std::vector<double> Trace::data2() const noexcept {
   return data[sac_map.at(name::data2)];
 }
+// Data views
+std::span<const double> Trace::data1_view() const noexcept {
+  return data[sac_map.at(name::data1)];
+}
+std::span<const double> Trace::data2_view() const noexcept {
+  return data[sac_map.at(name::data2)];
+}
+// Writable views may change the data (drop the fingerprint)
+std::span<double> Trace::data1_view() noexcept {
+  checksum.reset();
+  return data[sac_map.at(name::data1)];
+}
+std::span<double> Trace::data2_view() noexcept {
+  checksum.reset();
+  return data[sac_map.at(name::data2)];
+}
 // Setters
 // Floats
 void Trace::depmin(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::depmin)] = input;
 }
 void Trace::depmax(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::depmax)] = input;
 }
 void Trace::odelta(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::odelta)] = input;
 }
 void Trace::resp0(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp0)] = input;
 }
 void Trace::resp1(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp1)] = input;
 }
 void Trace::resp2(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp2)] = input;
 }
 void Trace::resp3(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp3)] = input;
 }
 void Trace::resp4(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp4)] = input;
 }
 void Trace::resp5(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp5)] = input;
 }
 void Trace::resp6(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp6)] = input;
 }
 void Trace::resp7(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp7)] = input;
 }
 void Trace::resp8(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp8)] = input;
 }
 void Trace::resp9(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::resp9)] = input;
 }
 void Trace::stel(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::stel)] = input;
 }
 void Trace::stdp(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::stdp)] = input;
 }
 void Trace::evel(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::evel)] = input;
 }
 void Trace::evdp(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::evdp)] = input;
 }
 void Trace::mag(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::mag)] = input;
 }
 void Trace::user0(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user0)] = input;
 }
 void Trace::user1(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user1)] = input;
 }
 void Trace::user2(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user2)] = input;
 }
 void Trace::user3(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user3)] = input;
 }
 void Trace::user4(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user4)] = input;
 }
 void Trace::user5(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user5)] = input;
 }
 void Trace::user6(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user6)] = input;
 }
 void Trace::user7(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user7)] = input;
 }
 void Trace::user8(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user8)] = input;
 }
 void Trace::user9(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::user9)] = input;
 }
 void Trace::dist(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::dist)] = input;
 }
 void Trace::az(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::az)] = input;
 }
 void Trace::baz(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::baz)] = input;
 }
 void Trace::gcarc(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::gcarc)] = input;
 }
 void Trace::depmen(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::depmen)] = input;
 }
 void Trace::cmpaz(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::cmpaz)] = input;
 }
 void Trace::cmpinc(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::cmpinc)] = input;
 }
 void Trace::xminimum(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::xminimum)] = input;
 }
 void Trace::xmaximum(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::xmaximum)] = input;
 }
 void Trace::yminimum(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::yminimum)] = input;
 }
 void Trace::ymaximum(const float input) noexcept {
+  checksum.reset();
   floats[sac_map.at(name::ymaximum)] = input;
 }
 // Doubles
 void Trace::delta(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::delta)] = input;
 }
 void Trace::b(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::b)] = input;
 }
 void Trace::e(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::e)] = input;
 }
 void Trace::o(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::o)] = input;
 }
 void Trace::a(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::a)] = input;
 }
 void Trace::t0(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t0)] = input;
 }
 void Trace::t1(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t1)] = input;
 }
 void Trace::t2(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t2)] = input;
 }
 void Trace::t3(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t3)] = input;
 }
 void Trace::t4(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t4)] = input;
 }
 void Trace::t5(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t5)] = input;
 }
 void Trace::t6(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t6)] = input;
 }
 void Trace::t7(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t7)] = input;
 }
 void Trace::t8(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t8)] = input;
 }
 void Trace::t9(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::t9)] = input;
 }
 void Trace::f(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::f)] = input;
 }
 void Trace::stla(const double input) noexcept {
+  checksum.reset();
   double clean_input{input};
   if (clean_input != unset_double) {
     clean_input = limit_90(clean_input);
@@ -1387,6 +1912,7 @@ void Trace::stla(const double input) noexcept {
   doubles[sac_map.at(name::stla)] = clean_input;
 }
 void Trace::stlo(const double input) noexcept {
+  checksum.reset();
   double clean_input{input};
   if (clean_input != unset_double) {
     clean_input = limit_180(clean_input);
@@ -1394,6 +1920,7 @@ void Trace::stlo(const double input) noexcept {
   doubles[sac_map.at(name::stlo)] = clean_input;
 }
 void Trace::evla(const double input) noexcept {
+  checksum.reset();
   double clean_input{input};
   if (clean_input != unset_double) {
     clean_input = limit_90(clean_input);
@@ -1401,6 +1928,7 @@ void Trace::evla(const double input) noexcept {
   doubles[sac_map.at(name::evla)] = clean_input;
 }
 void Trace::evlo(const double input) noexcept {
+  checksum.reset();
   double clean_input{input};
   if (clean_input != unset_double) {
     clean_input = limit_180(clean_input);
@@ -1408,40 +1936,52 @@ void Trace::evlo(const double input) noexcept {
   doubles[sac_map.at(name::evlo)] = clean_input;
 }
 void Trace::sb(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::sb)] = input;
 }
 void Trace::sdelta(const double input) noexcept {
+  checksum.reset();
   doubles[sac_map.at(name::sdelta)] = input;
 }
 // Ints
 void Trace::nzyear(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzyear)] = input;
 }
 void Trace::nzjday(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzjday)] = input;
 }
 void Trace::nzhour(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzhour)] = input;
 }
 void Trace::nzmin(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzmin)] = input;
 }
 void Trace::nzsec(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzsec)] = input;
 }
 void Trace::nzmsec(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nzmsec)] = input;
 }
 void Trace::nvhdr(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nvhdr)] = input;
 }
 void Trace::norid(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::norid)] = input;
 }
 void Trace::nevid(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nevid)] = input;
 }
 void Trace::npts(const int input) noexcept {
+  checksum.reset();
   if ((input >= 0) || (input == unset_int)) {
     ints[sac_map.at(name::npts)] = input;
     const size_t size{static_cast<size_t>(input >= 0 ? input : 0)};
@@ -1449,18 +1989,23 @@ void Trace::npts(const int input) noexcept {
   }
 }
 void Trace::nsnpts(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nsnpts)] = input;
 }
 void Trace::nwfid(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nwfid)] = input;
 }
 void Trace::nxsize(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nxsize)] = input;
 }
 void Trace::nysize(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::nysize)] = input;
 }
 void Trace::iftype(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::iftype)] = input;
   const size_t size{npts() >= 0 ? static_cast<size_t>(npts()) : 0};
   // Uneven 2D data not supported as not in specification
@@ -1470,40 +2015,52 @@ void Trace::iftype(const int input) noexcept {
   resize_data2(size);
 }
 void Trace::idep(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::idep)] = input;
 }
 void Trace::iztype(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::iztype)] = input;
 }
 void Trace::iinst(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::iinst)] = input;
 }
 void Trace::istreg(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::istreg)] = input;
 }
 void Trace::ievreg(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::ievreg)] = input;
 }
 void Trace::ievtyp(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::ievtyp)] = input;
 }
 void Trace::iqual(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::iqual)] = input;
 }
 void Trace::isynth(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::isynth)] = input;
 }
 void Trace::imagtyp(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::imagtyp)] = input;
 }
 void Trace::imagsrc(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::imagsrc)] = input;
 }
 void Trace::ibody(const int input) noexcept {
+  checksum.reset();
   ints[sac_map.at(name::ibody)] = input;
 }
 // Bools
 void Trace::leven(const bool input) noexcept {
+  checksum.reset();
   bools[sac_map.at(name::leven)] = input;
   const size_t size{npts() >= 0 ? static_cast<size_t>(npts()) : 0};
   // Uneven 2D data not supported since not in specification
@@ -1513,100 +2070,138 @@ void Trace::leven(const bool input) noexcept {
   resize_data2(size);
 }
 void Trace::lpspol(const bool input) noexcept {
+  checksum.reset();
   bools[sac_map.at(name::lpspol)] = input;
 }
 void Trace::lovrok(const bool input) noexcept {
+  checksum.reset();
   bools[sac_map.at(name::lovrok)] = input;
 }
 void Trace::lcalda(const bool input) noexcept {
+  checksum.reset();
   bools[sac_map.at(name::lcalda)] = input;
 }
 // Strings
 void Trace::kstnm(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kstnm)] = input;
 }
 void Trace::kevnm(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kevnm)] = input;
 }
 void Trace::khole(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::khole)] = input;
 }
 void Trace::ko(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::ko)] = input;
 }
 void Trace::ka(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::ka)] = input;
 }
 void Trace::kt0(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt0)] = input;
 }
 void Trace::kt1(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt1)] = input;
 }
 void Trace::kt2(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt2)] = input;
 }
 void Trace::kt3(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt3)] = input;
 }
 void Trace::kt4(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt4)] = input;
 }
 void Trace::kt5(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt5)] = input;
 }
 void Trace::kt6(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt6)] = input;
 }
 void Trace::kt7(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt7)] = input;
 }
 void Trace::kt8(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt8)] = input;
 }
 void Trace::kt9(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kt9)] = input;
 }
 void Trace::kf(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kf)] = input;
 }
 void Trace::kuser0(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kuser0)] = input;
 }
 void Trace::kuser1(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kuser1)] = input;
 }
 void Trace::kuser2(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kuser2)] = input;
 }
 void Trace::kcmpnm(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kcmpnm)] = input;
 }
 void Trace::knetwk(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::knetwk)] = input;
 }
 void Trace::kdatrd(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kdatrd)] = input;
 }
 void Trace::kinst(const std::string &input) noexcept {
+  checksum.reset();
   strings[sac_map.at(name::kinst)] = input;
 }
 
 // Data
 void Trace::data1(const std::vector<double> &input) noexcept {
-  data[sac_map.at(name::data1)] = input;
+  checksum.reset();
+  data1(std::vector<double>{input});
+}
+
+void Trace::data2(const std::vector<double> &input) noexcept {
+  checksum.reset();
+  data2(std::vector<double>{input});
+}
+
+void Trace::data1(std::vector<double> &&input) noexcept {
+  checksum.reset();
+  data[sac_map.at(name::data1)] = std::move(input);
   // Propagate change as needed
-  int size{static_cast<int>(data1().size())};
+  int size{static_cast<int>(data1_view().size())};
   size = (((size == 0) && (npts() == unset_int)) ? unset_int : size);
   if (size != npts()) {
     npts(size);
   }
 }
 
-void Trace::data2(const std::vector<double> &input) noexcept {
-  data[sac_map.at(name::data2)] = input;
+void Trace::data2(std::vector<double> &&input) noexcept {
+  checksum.reset();
+  data[sac_map.at(name::data2)] = std::move(input);
   // Proagate change as needed
-  int size{static_cast<int>(data2().size())};
+  int size{static_cast<int>(data2_view().size())};
   size = (((size == 0) && (npts() == unset_int)) ? unset_int : size);
   // Need to make sure this is legal
   // If positive size and not-legal, make spectral
@@ -1623,25 +2218,24 @@ void Trace::data2(const std::vector<double> &input) noexcept {
 }
 
 void Trace::resize_data1(const size_t size) noexcept {
-  if (size != data1().size()) {
-    std::vector<double> new_data1{data1()};
+  if (size != data1_view().size()) {
+    std::vector<double> new_data1{std::move(data[sac_map.at(name::data1)])};
     new_data1.resize(size, 0.0);
-    data1(new_data1);
+    data1(std::move(new_data1));
   }
 }
 
 void Trace::resize_data2(const size_t size) noexcept {
   // Data2 is legal
   if (!leven() || (iftype() > 1)) {
-    if (size != data2().size()) {
-      std::vector<double> new_data2{data2()};
+    if (size != data2_view().size()) {
+      std::vector<double> new_data2{std::move(data[sac_map.at(name::data2)])};
       new_data2.resize(size, 0.0);
-      data2(new_data2);
+      data2(std::move(new_data2));
     }
   } else {
-    if (!data2().empty()) {
-      std::vector<double> new_data2{};
-      data2(new_data2);
+    if (!data2_view().empty()) {
+      data2(std::vector<double>{});
     }
   }
 }
@@ -1775,7 +2369,7 @@ void safe_to_finish_reading(std::ifstream *sac) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_starter(std::ifstream *sac_file) {
+void Trace::read_float_headers_starter(std::istream *sac_file) {
   delta(binary_to_float(read_word(sac_file)));   // 000
   depmin(binary_to_float(read_word(sac_file)));  // 001
   depmax(binary_to_float(read_word(sac_file)));  // 002
@@ -1802,7 +2396,7 @@ void Trace::read_float_headers_starter(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_t(std::ifstream *sac_file) {
+void Trace::read_float_headers_t(std::istream *sac_file) {
   t0(binary_to_float(read_word(sac_file)));  // 010
   t1(binary_to_float(read_word(sac_file)));  // 011
   t2(binary_to_float(read_word(sac_file)));  // 012
@@ -1829,7 +2423,7 @@ void Trace::read_float_headers_t(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_resp(std::ifstream *sac_file) {
+void Trace::read_float_headers_resp(std::istream *sac_file) {
   resp0(binary_to_float(read_word(sac_file)));  // 021
   resp1(binary_to_float(read_word(sac_file)));  // 022
   resp2(binary_to_float(read_word(sac_file)));  // 023
@@ -1854,7 +2448,7 @@ void Trace::read_float_headers_resp(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_station_event(std::ifstream *sac_file) {
+void Trace::read_float_headers_station_event(std::istream *sac_file) {
   // Station headers
   stla(binary_to_float(read_word(sac_file)));  // 031
   stlo(binary_to_float(read_word(sac_file)));  // 032
@@ -1881,7 +2475,7 @@ void Trace::read_float_headers_station_event(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_user(std::ifstream *sac_file) {
+void Trace::read_float_headers_user(std::istream *sac_file) {
   user0(binary_to_float(read_word(sac_file)));  // 040
   user1(binary_to_float(read_word(sac_file)));  // 041
   user2(binary_to_float(read_word(sac_file)));  // 042
@@ -1906,7 +2500,7 @@ void Trace::read_float_headers_user(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_geometry(std::ifstream *sac_file) {
+void Trace::read_float_headers_geometry(std::istream *sac_file) {
   dist(binary_to_float(read_word(sac_file)));   // 050
   az(binary_to_float(read_word(sac_file)));     // 051
   baz(binary_to_float(read_word(sac_file)));    // 052
@@ -1926,7 +2520,7 @@ void Trace::read_float_headers_geometry(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_float_headers_meta(std::ifstream *sac_file) {
+void Trace::read_float_headers_meta(std::istream *sac_file) {
   sb(binary_to_float(read_word(sac_file)));        // 054
   sdelta(binary_to_float(read_word(sac_file)));    // 055
   depmen(binary_to_float(read_word(sac_file)));    // 056
@@ -1954,7 +2548,7 @@ void Trace::read_float_headers_meta(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
   */
-void Trace::read_float_headers(std::ifstream *sac_file) {
+void Trace::read_float_headers(std::istream *sac_file) {
   read_float_headers_starter(sac_file);        // 000-009
   read_float_headers_t(sac_file);              // 010-020
   read_float_headers_resp(sac_file);           // 021-030
@@ -1976,7 +2570,7 @@ void Trace::read_float_headers(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_int_headers_datetime(std::ifstream *sac_file) {
+void Trace::read_int_headers_datetime(std::istream *sac_file) {
   nzyear(binary_to_int(read_word(sac_file)));  // 070
   nzjday(binary_to_int(read_word(sac_file)));  // 071
   nzhour(binary_to_int(read_word(sac_file)));  // 072
@@ -1999,7 +2593,7 @@ void Trace::read_int_headers_datetime(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_int_headers_meta(std::ifstream *sac_file) {
+void Trace::read_int_headers_meta(std::istream *sac_file) {
   nvhdr(binary_to_int(read_word(sac_file)));   // 076
   norid(binary_to_int(read_word(sac_file)));   // 077
   nevid(binary_to_int(read_word(sac_file)));   // 078
@@ -2042,7 +2636,7 @@ void Trace::read_int_headers_meta(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_int_headers(std::ifstream *sac_file) {
+void Trace::read_int_headers(std::istream *sac_file) {
   read_int_headers_datetime(sac_file);  // 070--075
   read_int_headers_meta(sac_file);      // 076--104
 }
@@ -2059,7 +2653,7 @@ void Trace::read_int_headers(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_bool_headers(std::ifstream *sac_file) {
+void Trace::read_bool_headers(std::istream *sac_file) {
   // Logical headers
   leven(binary_to_bool(read_word(sac_file)));   // 105
   lpspol(binary_to_bool(read_word(sac_file)));  // 106
@@ -2081,7 +2675,7 @@ void Trace::read_bool_headers(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_string_headers(std::ifstream *sac_file) {
+void Trace::read_string_headers(std::istream *sac_file) {
   // KSTNM is 2 words (normal)
   kstnm(binary_to_string(read_two_words(sac_file)));  // 110-111
   // KEVNM is 4 words long (unique!)
@@ -2121,8 +2715,9 @@ void Trace::read_string_headers(std::ifstream *sac_file) {
   For data2 reads words (158 + 1 + npts)--(159 + (2 * npts))
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
+  @param[in,out] crc std::uint32_t* Running CRC-32C to update (optional).
  */
-void Trace::read_datas(std::ifstream *sac_file) {
+void Trace::read_datas(std::ifstream *sac_file, std::uint32_t *crc) {
   const bool is_data{npts() != unset_int};
   // data1
   const size_t n_words{static_cast<size_t>(npts())};
@@ -2131,14 +2726,14 @@ void Trace::read_datas(std::ifstream *sac_file) {
     safe_to_read_data(sac_file, n_words, false);  // throws io_error if unsafe
     const read_spec spec{n_words, data_word};
     // Originally floats, read as doubles
-    data1(read_data(sac_file, spec));
+    data1(read_data(sac_file, spec, crc));
   }
   // data2 (uneven or spectral data)
   if (is_data && (!leven() || (iftype() > 1))) {
     // true flags for data2
     safe_to_read_data(sac_file, n_words, true);  // throws io_error if unsafe
     const read_spec spec{n_words, data_word + static_cast<size_t>(npts())};
-    data2(read_data(sac_file, spec));
+    data2(read_data(sac_file, spec, crc));
   }
 }
 
@@ -2150,7 +2745,7 @@ void Trace::read_datas(std::ifstream *sac_file) {
 
   @param[in,out] sac_file std::ifstream* SAC-file to be read.
  */
-void Trace::read_footers(std::ifstream *sac_file) {
+void Trace::read_footers(std::istream *sac_file) {
   delta(binary_to_double(read_two_words(sac_file)));   // 00-01
   b(binary_to_double(read_two_words(sac_file)));       // 02-03
   e(binary_to_double(read_two_words(sac_file)));       // 04-05
@@ -2175,9 +2770,30 @@ void Trace::read_footers(std::ifstream *sac_file) {
   sdelta(binary_to_double(read_two_words(sac_file)));  // 42-43
 }
 
+/*!
+  \brief Read a block of bytes, adding them to a running CRC-32C.
+
+  @param[in,out] sac_file std::ifstream* SAC-file to be read.
+  @param[in] n_bytes Number of bytes to read.
+  @param[in,out] crc std::uint32_t* Running CRC-32C to update.
+  @returns std::string Bytes read.
+ */
+std::string Trace::read_block(std::ifstream *sac_file, const size_t n_bytes,
+                              std::uint32_t *crc) {
+  std::string result(n_bytes, '\0');
+  // flawfinder: ignore
+  sac_file->read(result.data(), static_cast<std::streamsize>(n_bytes));
+  *crc = crc32c(result, *crc);
+  return result;
+}
+
 /*!
   \brief Binary SAC-file reader.
 
+  The header and footer are read as single blocks and parsed from memory; the
+  data are read in bulk. All bytes are hashed (CRC-32C) in the same pass, see
+  Trace::fingerprint.
+
   @param[in] path std::filesystem::path SAC-file to be read.
   @returns Trace read in-file.
   @throw io_error If the file is not safe to read for whatever reason.
@@ -2189,17 +2805,23 @@ Trace::Trace(const std::filesystem::path &path) {
     throw io_error(path.string() + " cannot be opened to read.");
   }
   safe_to_read_header(&file);  // throws io_error if not safe
-  read_float_headers(&file);
-  read_int_headers(&file);
-  read_bool_headers(&file);
-  read_string_headers(&file);
-  read_datas(&file);
+  std::uint32_t crc{0};
+  std::istringstream header{read_block(
+      &file, static_cast<size_t>(word_position(data_word)), &crc)};
+  read_float_headers(&header);
+  read_int_headers(&header);
+  read_bool_headers(&header);
+  read_string_headers(&header);
+  read_datas(&file, &crc);
   if (nvhdr() == modern_hdr_version) {
     safe_to_read_footer(&file);  // throws io_error if not safe
-    read_footers(&file);
+    std::istringstream footer{read_block(
+        &file, static_cast<size_t>(num_footer) * 2 * word_length, &crc)};
+    read_footers(&footer);
   }
   safe_to_finish_reading(&file);  // throws io_error if the file isn't finished
   file.close();
+  checksum = crc;
 }
 //------------------------------------------------------------------------------
 // Write
@@ -2214,15 +2836,29 @@ Trace::Trace(const std::filesystem::path &path) {
 
   For data2 writess words (158 + 1 + npts)--(159 + (2 * npts))
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
-  @param[in] data_vec std::vector<double> Data-vector to write.
- */
-void Trace::write_data(std::ofstream *sac_file,
-                       const std::vector<double> &data_vec) {
-  std::for_each(
-      data_vec.begin(), data_vec.end(), [&sac_file](const auto &value) {
-        write_words(sac_file, convert_to_word(static_cast<float>(value)));
-      });
+  Values are converted in chunks of ::io_chunk (one stream write per chunk)
+  and, if requested, added to a running CRC-32C in the same pass.
+
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
+  @param[in] data_vec std::span<const double> Data-vector to write.
+  @param[in,out] crc std::uint32_t* Running CRC-32C to update (optional).
+ */
+void Trace::write_data(std::ostream *sac_file,
+                       std::span<const double> data_vec, std::uint32_t *crc) {
+  std::vector<char> buffer(std::min(io_chunk, data_vec.size()) * word_length);
+  for (size_t start{0}; start < data_vec.size(); start += io_chunk) {
+    const size_t count{std::min(io_chunk, data_vec.size() - start)};
+    for (size_t i{0}; i < count; ++i) [[likely]] {
+      const auto value{static_cast<float>(data_vec[start + i])};
+      // flawfinder: ignore
+      std::memcpy(&buffer[i * word_length], &value, word_length);
+    }
+    const size_t n_bytes{count * word_length};
+    if (crc != nullptr) {
+      *crc = crc32c(std::span<const char>{buffer.data(), n_bytes}, *crc);
+    }
+    sac_file->write(buffer.data(), static_cast<std::streamsize>(n_bytes));
+  }
 }
 
 /*!
@@ -2235,9 +2871,9 @@ void Trace::write_data(std::ofstream *sac_file,
 
   Headers written: delta, depmin, depmax, odelta, b, e, o, and a.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_starter(std::ofstream *sac_file) const {
+void Trace::write_float_headers_starter(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(static_cast<float>(delta())));  // 000
   write_words(sac_file, convert_to_word(depmin()));                     // 001
   write_words(sac_file, convert_to_word(depmax()));                     // 002
@@ -2262,9 +2898,9 @@ void Trace::write_float_headers_starter(std::ofstream *sac_file) const {
 
   Headers written: t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, and f.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_t(std::ofstream *sac_file) const {
+void Trace::write_float_headers_t(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(static_cast<float>(t0())));  // 010
   write_words(sac_file, convert_to_word(static_cast<float>(t1())));  // 011
   write_words(sac_file, convert_to_word(static_cast<float>(t2())));  // 012
@@ -2289,9 +2925,9 @@ void Trace::write_float_headers_t(std::ofstream *sac_file) const {
   Headers written: resp0, resp1, resp2, resp3, resp4, resp5, resp6, resp7,
   resp8, and resp9.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_resp(std::ofstream *sac_file) const {
+void Trace::write_float_headers_resp(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(resp0()));  // 021
   write_words(sac_file, convert_to_word(resp1()));  // 022
   write_words(sac_file, convert_to_word(resp2()));  // 023
@@ -2314,9 +2950,9 @@ void Trace::write_float_headers_resp(std::ofstream *sac_file) const {
 
   Headers written: stla, stlo, stel, stdp, evla, evlo, evel, evdp, and mag.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_station_event(std::ofstream *sac_file) const {
+void Trace::write_float_headers_station_event(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(static_cast<float>(stla())));  // 031
   write_words(sac_file, convert_to_word(static_cast<float>(stlo())));  // 032
   write_words(sac_file, convert_to_word(stel()));                      // 033
@@ -2339,9 +2975,9 @@ void Trace::write_float_headers_station_event(std::ofstream *sac_file) const {
   Headers written: user0, user1, user2, user3, user4, user5, user6, user7,
   user8, and user9.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_user(std::ofstream *sac_file) const {
+void Trace::write_float_headers_user(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(user0()));  // 040
   write_words(sac_file, convert_to_word(user1()));  // 041
   write_words(sac_file, convert_to_word(user2()));  // 042
@@ -2364,9 +3000,9 @@ void Trace::write_float_headers_user(std::ofstream *sac_file) const {
 
   Headers written: dist, az, baz, and gcarc.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_geometry(std::ofstream *sac_file) const {
+void Trace::write_float_headers_geometry(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(dist()));   // 050
   write_words(sac_file, convert_to_word(az()));     // 051
   write_words(sac_file, convert_to_word(baz()));    // 052
@@ -2384,9 +3020,9 @@ void Trace::write_float_headers_geometry(std::ofstream *sac_file) const {
   Headers written: sb, sdelta, depmen, cmpaz, cmpinc, xminimum, xmaximum,
   yminimum, and ymaximum.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_float_headers_meta(std::ofstream *sac_file) const {
+void Trace::write_float_headers_meta(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(static_cast<float>(sb())));      // 054
   write_words(sac_file, convert_to_word(static_cast<float>(sdelta())));  // 055
   write_words(sac_file, convert_to_word(depmen()));                      // 056
@@ -2412,9 +3048,9 @@ void Trace::write_float_headers_meta(std::ofstream *sac_file) const {
 
   Writes all the float headers.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
   */
-void Trace::write_float_headers(std::ofstream *sac_file) const {
+void Trace::write_float_headers(std::ostream *sac_file) const {
   write_float_headers_starter(sac_file);        // 000-009
   write_float_headers_t(sac_file);              // 010-020
   write_float_headers_resp(sac_file);           // 031-030
@@ -2434,9 +3070,9 @@ void Trace::write_float_headers(std::ofstream *sac_file) const {
 
   Headers written: nzyear, nzjday, nzhour, nzmin, nzsec, and nzmsec.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_int_headers_datetime(std::ofstream *sac_file) const {
+void Trace::write_int_headers_datetime(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(nzyear()));  // 070
   write_words(sac_file, convert_to_word(nzjday()));  // 071
   write_words(sac_file, convert_to_word(nzhour()));  // 072
@@ -2457,10 +3093,10 @@ void Trace::write_int_headers_datetime(std::ofstream *sac_file) const {
   iftype, idep, iztype, iinst, istreg, ievreg, ievtyp, iqual, isynth, imagtyp,
   imagsrc, and ibody.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
   @param[in] hdr_ver Integer header version to be written.
  */
-void Trace::write_int_headers_meta(std::ofstream *sac_file,
+void Trace::write_int_headers_meta(std::ostream *sac_file,
                                    const int hdr_ver) const {
   write_words(sac_file, convert_to_word(hdr_ver));   // 076
   write_words(sac_file, convert_to_word(norid()));   // 077
@@ -2502,10 +3138,10 @@ void Trace::write_int_headers_meta(std::ofstream *sac_file,
 
   Writes all integer headers.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
   @param[in] hdr_ver Integer header version to be written.
  */
-void Trace::write_int_headers(std::ofstream *sac_file,
+void Trace::write_int_headers(std::ostream *sac_file,
                               const int hdr_ver) const {
   write_int_headers_datetime(sac_file);       // 070-075
   write_int_headers_meta(sac_file, hdr_ver);  // 076-104
@@ -2521,9 +3157,9 @@ void Trace::write_int_headers(std::ofstream *sac_file,
 
   Writes all boolean headers.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_bool_headers(std::ofstream *sac_file) const {
+void Trace::write_bool_headers(std::ostream *sac_file) const {
   write_words(sac_file, bool_to_word(leven()));   // 105
   write_words(sac_file, bool_to_word(lpspol()));  // 106
   write_words(sac_file, bool_to_word(lovrok()));  // 107
@@ -2542,9 +3178,9 @@ void Trace::write_bool_headers(std::ofstream *sac_file) const {
 
   Writes all string headers.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_string_headers(std::ofstream *sac_file) const {
+void Trace::write_string_headers(std::ostream *sac_file) const {
   // Strings are special
   std::array<char, static_cast<size_t>(2) * word_length> two_words{
       convert_to_words<sizeof(two_words)>(kstnm(), 2)};
@@ -2647,9 +3283,9 @@ void Trace::write_string_headers(std::ofstream *sac_file) const {
   Note that this modifies the position of the writer to the end of the footer
   section.
 
-  @param[in,out] sac_file std::ofstream* SAC-file to be written.
+  @param[in,out] sac_file std::ostream* SAC-file to be written.
  */
-void Trace::write_footers(std::ofstream *sac_file) const {
+void Trace::write_footers(std::ostream *sac_file) const {
   write_words(sac_file, convert_to_word(delta()));   // 00-01
   write_words(sac_file, convert_to_word(b()));       // 02-03
   write_words(sac_file, convert_to_word(e()));       // 04-05
@@ -2677,45 +3313,83 @@ void Trace::write_footers(std::ofstream *sac_file) const {
 /*!
   \brief Binary SAC-file writer.
 
+  If with_stats is true, depmin, depmax, and depmen are computed from data1
+  (single pass) and written in place of the stored values; the Trace itself is
+  not modified (use Trace::update_stats for that).
+
   @param[in] path std::filesystem::path SAC-file to write.
   @param[in] legacy bool Legacy-write flag (default false = v7, true = v6).
+  @param[in] with_stats bool Write computed data statistics (default false).
+  @returns std::uint32_t CRC-32C of the written bytes (see
+  Trace::fingerprint).
   @throw io_error If the file cannot be written (bad path or bad permissions).
   @throw std::exception Other unwritable issues (not enough space, disk failure,
   etc.).
  */
-void Trace::write(const std::filesystem::path &path, const bool legacy) const {
+std::uint32_t Trace::write(const std::filesystem::path &path,
+                           const bool legacy, const bool with_stats) const {
   std::ofstream file(path, std::ios::binary | std::ios::out | std::ios::trunc);
   if (!file) {
     throw io_error(path.string() + " cannot be opened to write.");
   }
   const int header_version{legacy ? old_hdr_version : modern_hdr_version};
-  write_float_headers(&file);
-  write_int_headers(&file, header_version);
-  write_bool_headers(&file);
-  write_string_headers(&file);
+  std::uint32_t crc{0};
+  // Header is assembled in memory and written (and hashed) as one block
+  std::ostringstream header{};
+  if (with_stats) {
+    // Header-only copy (no data) to hold the updated statistics
+    Trace stats_header{};
+    stats_header.floats = floats;
+    stats_header.doubles = doubles;
+    stats_header.ints = ints;
+    stats_header.bools = bools;
+    stats_header.strings = strings;
+    // Statistics are those of this Trace's data1
+    const data_stats stats{compute_stats(data[sac_map.at(name::data1)])};
+    stats_header.depmin(static_cast<float>(stats.min));
+    stats_header.depmax(static_cast<float>(stats.max));
+    stats_header.depmen(static_cast<float>(stats.mean));
+    stats_header.write_float_headers(&header);
+  } else {
+    write_float_headers(&header);
+  }
+  write_int_headers(&header, header_version);
+  write_bool_headers(&header);
+  write_string_headers(&header);
+  const std::string header_bytes{header.str()};
+  crc = crc32c(header_bytes, crc);
+  file.write(header_bytes.data(),
+             static_cast<std::streamsize>(header_bytes.size()));
   // Data
-  std::vector<double> tmp{data1()};
-  write_data(&file, tmp);
+  write_data(&file, data[sac_map.at(name::data1)], &crc);
   if (!leven() || (iftype() > 1)) {
-    tmp = data2();
-    write_data(&file, tmp);
+    write_data(&file, data[sac_map.at(name::data2)], &crc);
   }
   if (header_version == modern_hdr_version) {
     // Write footer
-    write_footers(&file);
+    std::ostringstream footer{};
+    write_footers(&footer);
+    const std::string footer_bytes{footer.str()};
+    crc = crc32c(footer_bytes, crc);
+    file.write(footer_bytes.data(),
+               static_cast<std::streamsize>(footer_bytes.size()));
   }
   file.close();
+  return crc;
 }
 
 /*!
   \brief Binary SAC-file legacy-write convenience function.
 
   @param[in] path std::filesystem::path SAC-file to be written.
+  @param[in] with_stats bool Write computed data statistics (default false).
+  @returns std::uint32_t CRC-32C of the written bytes.
   @throw io_error If the file cannot be written (bad path or bad permissions).
   @throw std::execption Other unwritable issues (not enough space, disk failure,
   etc.).
  */
-void Trace::legacy_write(const std::filesystem::path &path) const {
-  write(path, true);
+std::uint32_t Trace::legacy_write(const std::filesystem::path &path,
+                                  const bool with_stats) const {
+  return write(path, true, with_stats);
 }
 };  // namespace sacfmt
@@ -19,6 +19,7 @@ TEST_CASE("DateTime: Default Trace") {
   REQUIRE(date == unset_word);
   const std::string time{trace.time()};
   REQUIRE(time == unset_word);
+  REQUIRE(trace.reference_epoch() == unset_double);
 }
 
 TEST_CASE("DateTime: Standard Fake Trace") {
@@ -27,5 +28,31 @@ TEST_CASE("DateTime: Standard Fake Trace") {
   REQUIRE(date == "2023-123");
   const std::string time{trace.time()};
   REQUIRE(time == "13:57:34.0");
+  REQUIRE(trace.reference_epoch() == 1683122254.0);
+}
+
+TEST_CASE("DateTime: Reference Epoch") {
+  Trace trace{};
+  trace.nzyear(1970);
+  trace.nzjday(1);
+  trace.nzhour(0);
+  trace.nzmin(0);
+  trace.nzsec(0);
+  trace.nzmsec(0);
+  REQUIRE(trace.reference_epoch() == 0.0);
+  // Leap year, last day
+  trace.nzyear(2024);
+  trace.nzjday(366);
+  REQUIRE(trace.reference_epoch() == 1735603200.0);
+  // Before the epoch
+  trace.nzyear(1969);
+  trace.nzjday(365);
+  trace.nzhour(23);
+  trace.nzmin(59);
+  trace.nzsec(59);
+  trace.nzmsec(500);
+  REQUIRE(trace.reference_epoch() == -0.5);
+  trace.nzmsec(unset_int);
+  REQUIRE(trace.reference_epoch() == unset_double);
 }
 }  // namespace sacfmt
@@ -0,0 +1,2581 @@
+// Copyright 2023-2024 Alexander R. Blanchette
+
+// sac-format
+#include "sac-format/processing.hpp"
+#include "sac-format/sac_format.hpp"
+#include "sac-format/util.hpp"
+// Standard Library
+//   https://en.cppreference.com/w/cpp/standard_library
+// Catch2 https://github.com/catchorg/Catch2/tree/v3.4.0
+#define CATCH_CONFIG_FAST_COMPILE
+#define CATCH_CONFIG_MAIN
+// testing macros
+// TEST_CASE, SECTION, REQUIRE, CAPTURE, REQUIRE_THROWS, REQUIRE_NOTHROW
+#include <catch2/catch_test_macros.hpp>
+// from catch_matchers.hpp (any matcher includes it)
+// REQUIRE_THAT
+// Catch::Matchers::WithinAbs
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+using Catch::Matchers::WithinAbs;
+
+namespace sacfmt {
+// NOLINTBEGIN(readability-magic-numbers)
+// Linear trend plus a zero-mean, trend-free signal
+std::vector<double> trended(const size_t size, const double intercept,
+                            const double slope) {
+  std::vector<double> result(size);
+  for (size_t i{0}; i < size; ++i) {
+    const double signal{(i % 2 == 0) ? 1.0 : -1.0};
+    result[i] = intercept + (slope * static_cast<double>(i)) + signal;
+  }
+  return result;
+}
+
+TEST_CASE("Processing: Data Views") {
+  Trace trace = gen_fake_trace();
+  std::vector<double> data{trace.data1()};
+  random_vector(&data);
+  trace.data1(data);
+  REQUIRE(trace.data1_view().size() == data.size());
+  REQUIRE(trace.data1_view().data() ==
+          std::as_const(trace).data1_view().data());
+  trace.data1_view()[0] = 42.0;
+  REQUIRE(trace.data1()[0] == 42.0);
+  REQUIRE(trace.npts() == static_cast<int>(data.size()));
+}
+
+TEST_CASE("Processing: Fit Trend") {
+  SECTION("Empty") {
+    const linear_fit fit{fit_trend(std::vector<double>{})};
+    REQUIRE(fit.slope == 0.0);
+    REQUIRE(fit.intercept == 0.0);
+  }
+  SECTION("Single") {
+    const linear_fit fit{fit_trend(std::vector<double>{3.0})};
+    REQUIRE(fit.slope == 0.0);
+    REQUIRE(fit.intercept == 3.0);
+  }
+  SECTION("Evenly-Spaced") {
+    const std::vector<double> data{trended(1001, 5.0, 0.25)};
+    const linear_fit fit{fit_trend(data)};
+    REQUIRE_THAT(fit.slope, WithinAbs(0.25, 1e-5));
+    REQUIRE_THAT(fit.intercept + (fit.slope * (0.0 - fit.center)),
+                 WithinAbs(5.0, 1e-2));
+  }
+  SECTION("Independent Variable") {
+    std::vector<double> x{};
+    std::vector<double> data{};
+    for (size_t i{0}; i < 100; ++i) {
+      const double x_value{static_cast<double>(i * i) / 10.0};
+      x.push_back(x_value);
+      data.push_back(2.0 - (3.0 * x_value));
+    }
+    const linear_fit fit{fit_trend(data, x)};
+    REQUIRE_THAT(fit.slope, WithinAbs(-3.0, 1e-12));
+    REQUIRE_THAT(fit.intercept + (fit.slope * (0.0 - fit.center)),
+                 WithinAbs(2.0, 1e-9));
+  }
+}
+
+TEST_CASE("Processing: Rmean") {
+  std::vector<double> data{trended(257, 10.0, 0.0)};
+  rmean(data);
+  REQUIRE_THAT(compute_stats(data).mean, WithinAbs(0.0, 1e-12));
+  Trace trace = gen_fake_trace();
+  std::vector<double> values{trace.data1()};
+  random_vector(&values);
+  trace.data1(values);
+  rmean(&trace);
+  REQUIRE_THAT(compute_stats(trace.data1_view()).mean, WithinAbs(0.0, 1e-9));
+  REQUIRE_THAT(trace.depmen(), WithinAbs(0.0, 1e-6));
+  REQUIRE(trace.depmax() ==
+          static_cast<float>(compute_stats(trace.data1_view()).max));
+}
+
+TEST_CASE("Processing: Rtrend") {
+  SECTION("Evenly-Spaced") {
+    std::vector<double> data{trended(1000, 5.0, 0.25)};
+    rtrend(data);
+    const linear_fit fit{fit_trend(data)};
+    REQUIRE_THAT(fit.slope, WithinAbs(0.0, 1e-12));
+    REQUIRE_THAT(fit.intercept, WithinAbs(0.0, 1e-9));
+  }
+  SECTION("Unevenly-Spaced Trace") {
+    Trace trace{};
+    std::vector<double> x{};
+    std::vector<double> data{};
+    for (size_t i{0}; i < 100; ++i) {
+      const double x_value{std::sqrt(static_cast<double>(i))};
+      x.push_back(x_value);
+      data.push_back(1.0 + (2.0 * x_value));
+    }
+    trace.leven(false);
+    trace.data1(data);
+    trace.data2(x);
+    rtrend(&trace);
+    for (const double value : trace.data1_view()) {
+      REQUIRE_THAT(value, WithinAbs(0.0, 1e-12));
+    }
+  }
+}
+
+TEST_CASE("Processing: Taper") {
+  const size_t size{1000};
+  SECTION("Hann") {
+    std::vector<double> data(size, 1.0);
+    taper(data, 0.1, taper_window::hann);
+    REQUIRE(taper_length(size, 0.1) == 100);
+    REQUIRE_THAT(data[0], WithinAbs(0.0, 1e-12));
+    REQUIRE_THAT(data[size - 1], WithinAbs(0.0, 1e-12));
+    REQUIRE_THAT(data[50], WithinAbs(0.5, 1e-12));
+    REQUIRE(data[100] == 1.0);
+    REQUIRE(data[size / 2] == 1.0);
+    REQUIRE(data[size - 101] == 1.0);
+    // Symmetric
+    for (size_t i{0}; i < 100; ++i) {
+      REQUIRE_THAT(data[i], WithinAbs(data[size - 1 - i], 1e-15));
+      const double expected{
+          0.5 - (0.5 * std::cos(std::numbers::pi_v<double> *
+                                static_cast<double>(i) / 100.0))};
+      REQUIRE_THAT(data[i], WithinAbs(expected, 1e-12));
+    }
+  }
+  SECTION("Hamming") {
+    std::vector<double> data(size, 1.0);
+    taper(data, 0.1, taper_window::hamming);
+    REQUIRE_THAT(data[0], WithinAbs(0.08, 1e-12));
+    REQUIRE_THAT(data[50], WithinAbs(0.54, 1e-12));
+  }
+  SECTION("Cosine") {
+    std::vector<double> data(size, 1.0);
+    taper(data, 0.1, taper_window::cosine);
+    REQUIRE_THAT(data[0], WithinAbs(0.0, 1e-12));
+    REQUIRE_THAT(data[50], WithinAbs(std::sqrt(0.5), 1e-12));
+  }
+  SECTION("Width Limits") {
+    REQUIRE(taper_length(size, -1.0) == 0);
+    REQUIRE(taper_length(size, 1.0) == size / 2);
+    std::vector<double> data(size, 1.0);
+    taper(data, 0.0);
+    REQUIRE(data == std::vector<double>(size, 1.0));
+  }
+}
+
+TEST_CASE("Processing: Preprocess") {
+  Trace trace = gen_fake_trace();
+  std::vector<double> data{trace.data1()};
+  random_vector(&data);
+  for (size_t i{0}; i < data.size(); ++i) {
+    data[i] += 100.0 + (0.5 * static_cast<double>(i));
+  }
+  trace.data1(data);
+  Trace sequential{trace};
+  rmean(&sequential);
+  rtrend(&sequential);
+  taper(&sequential, 0.05, taper_window::hann);
+  preprocess(&trace, 0.05, taper_window::hann);
+  REQUIRE(trace.npts() == sequential.npts());
+  const std::span<const double> fused{trace.data1_view()};
+  const std::span<const double> expected{sequential.data1_view()};
+  for (size_t i{0}; i < fused.size(); ++i) {
+    REQUIRE_THAT(fused[i], WithinAbs(expected[i], 1e-9));
+  }
+  const data_stats stats{compute_stats(fused)};
+  REQUIRE(trace.depmin() == static_cast<float>(stats.min));
+  REQUIRE(trace.depmax() == static_cast<float>(stats.max));
+  REQUIRE(trace.depmen() == static_cast<float>(stats.mean));
+}
+
+// Direct (O(n^2)) DFT for reference
+std::vector<complex> direct_dft(const std::vector<complex> &data) {
+  const size_t size{data.size()};
+  std::vector<complex> result(size);
+  for (size_t k{0}; k < size; ++k) {
+    for (size_t j{0}; j < size; ++j) {
+      const double angle{-2.0 * std::numbers::pi_v<double> *
+                         static_cast<double>((j * k) % size) /
+                         static_cast<double>(size)};
+      result[k] += data[j] * std::polar(1.0, angle);
+    }
+  }
+  return result;
+}
+
+TEST_CASE("Processing: FFT: Next Fast Size") {
+  REQUIRE(next_fast_size(0) == 1);
+  REQUIRE(next_fast_size(1) == 1);
+  REQUIRE(next_fast_size(7) == 8);
+  REQUIRE(next_fast_size(11) == 12);
+  REQUIRE(next_fast_size(97) == 100);
+  REQUIRE(next_fast_size(1000) == 1000);
+  REQUIRE(next_fast_size(1001) == 1024);
+}
+
+TEST_CASE("Processing: FFT: Complex") {
+  for (const size_t size : std::array<size_t, 24>{
+           1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 25, 30, 49, 60, 77, 97, 100,
+           128, 243, 1000, 1009, 2 * 127}) {
+    CAPTURE(size);
+    std::vector<double> values(2 * size);
+    random_vector(&values);
+    std::vector<complex> data(size);
+    for (size_t i{0}; i < size; ++i) {
+      data[i] = complex{values[2 * i], values[(2 * i) + 1]};
+    }
+    const std::vector<complex> expected{direct_dft(data)};
+    const fft_plan plan{size};
+    std::vector<complex> result{data};
+    plan.forward(result);
+    for (size_t k{0}; k < size; ++k) {
+      REQUIRE_THAT(result[k].real(), WithinAbs(expected[k].real(), 1e-9));
+      REQUIRE_THAT(result[k].imag(), WithinAbs(expected[k].imag(), 1e-9));
+    }
+    plan.inverse(result);
+    for (size_t i{0}; i < size; ++i) {
+      REQUIRE_THAT(result[i].real(), WithinAbs(data[i].real(), 1e-12));
+      REQUIRE_THAT(result[i].imag(), WithinAbs(data[i].imag(), 1e-12));
+    }
+  }
+  std::vector<complex> wrong_size(3);
+  REQUIRE_THROWS_AS(fft_plan{4}.forward(wrong_size), processing_error);
+}
+
+TEST_CASE("Processing: FFT: Real") {
+  for (const size_t size : std::array<size_t, 15>{
+           1, 2, 3, 4, 5, 6, 7, 10, 16, 30, 97, 100, 1000, 1009, 2 * 1009}) {
+    CAPTURE(size);
+    std::vector<double> data(size);
+    random_vector(&data);
+    std::vector<complex> full(size);
+    std::transform(data.begin(), data.end(), full.begin(),
+                   [](const double value) { return complex{value, 0.0}; });
+    const std::vector<complex> expected{direct_dft(full)};
+    const std::vector<complex> spectrum{rfft(data)};
+    REQUIRE(spectrum.size() == (size / 2) + 1);
+    for (size_t k{0}; k < spectrum.size(); ++k) {
+      REQUIRE_THAT(spectrum[k].real(), WithinAbs(expected[k].real(), 1e-9));
+      REQUIRE_THAT(spectrum[k].imag(), WithinAbs(expected[k].imag(), 1e-9));
+    }
+    const std::vector<double> result{irfft(spectrum, size)};
+    for (size_t i{0}; i < size; ++i) {
+      REQUIRE_THAT(result[i], WithinAbs(data[i], 1e-12));
+    }
+  }
+  SECTION("Zero Padding") {
+    const std::vector<double> data{1.0, 2.0, 3.0};
+    const std::vector<complex> spectrum{rfft(data, 8)};
+    REQUIRE(spectrum.size() == 5);
+    REQUIRE_THAT(spectrum[0].real(), WithinAbs(6.0, 1e-12));
+    REQUIRE_THAT(spectrum[4].real(), WithinAbs(2.0, 1e-12));
+  }
+  SECTION("Plan Cache") {
+    REQUIRE(fft_plan::get(64) == fft_plan::get(64));
+    REQUIRE(rfft_plan::get(64) == rfft_plan::get(64));
+    REQUIRE(rfft_plan::get(64)->bins() == 33);
+    // Bounded: the oldest plan is rebuilt after max_cached_plans new sizes
+    const std::shared_ptr<const fft_plan> oldest{fft_plan::get(3 * 1009)};
+    for (size_t size{7001}; size <= 7000 + max_cached_plans; ++size) {
+      REQUIRE(fft_plan::get(size)->size() == size);
+    }
+    REQUIRE(fft_plan::get(3 * 1009) != oldest);
+  }
+}
+
+TEST_CASE("Processing: FFT: Spectral Trace") {
+  Trace trace = gen_fake_trace();
+  std::vector<double> data(1001);
+  random_vector(&data);
+  trace.data1(data);
+  const double delta{trace.delta()};
+  const double begin{trace.b()};
+  SECTION("Real/Imaginary") {
+    to_spectral(&trace, irlim);
+    REQUIRE(trace.iftype() == irlim);
+    REQUIRE(trace.npts() == 1024);
+    REQUIRE(trace.data2_view().size() == 1024);
+    REQUIRE(trace.nsnpts() == 1001);
+    REQUIRE(trace.sdelta() == delta);
+    REQUIRE(trace.sb() == begin);
+    REQUIRE_THAT(trace.delta(), WithinAbs(1.0 / (1024.0 * delta), 1e-15));
+    REQUIRE(trace.b() == 0.0);
+    // Hermitian
+    REQUIRE_THAT(trace.data1_view()[1], WithinAbs(trace.data1_view()[1023],
+                                                  1e-9));
+    REQUIRE_THAT(trace.data2_view()[1], WithinAbs(-trace.data2_view()[1023],
+                                                  1e-9));
+    REQUIRE_THROWS_AS(to_spectral(&trace), processing_error);
+    to_time(&trace);
+  }
+  SECTION("Amplitude/Phase") {
+    to_spectral(&trace, iamph);
+    REQUIRE(trace.iftype() == iamph);
+    for (const double amplitude : trace.data1_view()) {
+      REQUIRE(amplitude >= 0.0);
+    }
+    to_time(&trace);
+  }
+  REQUIRE(trace.iftype() == itime);
+  REQUIRE(trace.npts() == 1001);
+  REQUIRE(trace.data2_view().empty());
+  REQUIRE(trace.delta() == delta);
+  REQUIRE(trace.b() == begin);
+  for (size_t i{0}; i < data.size(); ++i) {
+    REQUIRE_THAT(trace.data1_view()[i], WithinAbs(data[i], 1e-9));
+  }
+}
+
+TEST_CASE("Processing: FFT: Spectral Trace: Errors") {
+  Trace trace{};
+  REQUIRE_THROWS_AS(to_time(&trace), processing_error);
+  trace.data1(std::vector<double>{1.0, 2.0});
+  REQUIRE_THROWS_AS(to_spectral(&trace), processing_error);  // uneven
+  trace.leven(true);
+  REQUIRE_THROWS_AS(to_spectral(&trace), processing_error);  // no delta
+  trace.delta(0.1);
+  REQUIRE_THROWS_AS(to_spectral(&trace, ixy), processing_error);
+  REQUIRE_NOTHROW(to_spectral(&trace));
+}
+
+TEST_CASE("Processing: Filter: Design") {
+  constexpr double delta{0.01};
+  constexpr double pi{std::numbers::pi_v<double>};
+  const auto omega = [](const double frequency) {
+    return 2.0 * pi * frequency * delta;
+  };
+  const auto gain = [](const std::vector<biquad> &sections, const double w) {
+    return std::abs(sos_response(sections, w));
+  };
+  const double half_power{1.0 / std::sqrt(2.0)};
+  SECTION("Lowpass") {
+    for (const int order : {1, 2, 3, 4, 7}) {
+      const std::vector<biquad> sos{
+          butterworth({filter_type::lowpass, order, 5.0}, delta)};
+      REQUIRE(sos.size() == static_cast<size_t>((order + 1) / 2));
+      REQUIRE_THAT(gain(sos, 0.0), WithinAbs(1.0, 1e-12));
+      REQUIRE_THAT(gain(sos, omega(5.0)), WithinAbs(half_power, 1e-9));
+      REQUIRE(gain(sos, omega(20.0)) < 0.3);
+    }
+  }
+  SECTION("Highpass") {
+    for (const int order : {1, 4, 5}) {
+      const std::vector<biquad> sos{
+          butterworth({filter_type::highpass, order, 2.0}, delta)};
+      REQUIRE_THAT(gain(sos, pi), WithinAbs(1.0, 1e-12));
+      REQUIRE_THAT(gain(sos, omega(2.0)), WithinAbs(half_power, 1e-9));
+      REQUIRE_THAT(gain(sos, 0.0), WithinAbs(0.0, 1e-9));
+    }
+  }
+  SECTION("Bandpass") {
+    for (const int order : {1, 2, 4}) {
+      const std::vector<biquad> sos{
+          butterworth({filter_type::bandpass, order, 1.0, 10.0}, delta)};
+      REQUIRE(sos.size() == static_cast<size_t>(order));
+      REQUIRE_THAT(gain(sos, omega(1.0)), WithinAbs(half_power, 1e-9));
+      REQUIRE_THAT(gain(sos, omega(10.0)), WithinAbs(half_power, 1e-9));
+      REQUIRE_THAT(gain(sos, 0.0), WithinAbs(0.0, 1e-9));
+      REQUIRE_THAT(gain(sos, pi), WithinAbs(0.0, 1e-9));
+    }
+  }
+  SECTION("Bandstop") {
+    for (const int order : {1, 2, 4}) {
+      const std::vector<biquad> sos{
+          butterworth({filter_type::bandstop, order, 1.0, 10.0}, delta)};
+      REQUIRE_THAT(gain(sos, 0.0), WithinAbs(1.0, 1e-12));
+      REQUIRE_THAT(gain(sos, pi), WithinAbs(1.0, 1e-9));
+      REQUIRE_THAT(gain(sos, omega(1.0)), WithinAbs(half_power, 1e-9));
+      REQUIRE_THAT(gain(sos, omega(10.0)), WithinAbs(half_power, 1e-9));
+      const double center{2.0 * std::atan(std::sqrt(
+                                     std::tan(pi * 1.0 * delta) *
+                                     std::tan(pi * 10.0 * delta)))};
+      REQUIRE_THAT(gain(sos, center), WithinAbs(0.0, 1e-9));
+    }
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(butterworth({filter_type::lowpass, 0, 5.0}, delta),
+                      processing_error);
+    REQUIRE_THROWS_AS(
+        butterworth({filter_type::lowpass, max_filter_order + 1, 5.0}, delta),
+        processing_error);
+    REQUIRE_THROWS_AS(butterworth({filter_type::lowpass, 4, 50.0}, delta),
+                      processing_error);
+    REQUIRE_THROWS_AS(butterworth({filter_type::lowpass, 4, 0.0}, delta),
+                      processing_error);
+    REQUIRE_THROWS_AS(
+        butterworth({filter_type::bandpass, 4, 10.0, 1.0}, delta),
+        processing_error);
+    REQUIRE_THROWS_AS(butterworth({filter_type::lowpass, 4, 5.0}, 0.0),
+                      processing_error);
+  }
+}
+
+TEST_CASE("Processing: Filter: Apply") {
+  constexpr double delta{0.01};
+  constexpr double pi{std::numbers::pi_v<double>};
+  const filter_spec lowpass{filter_type::lowpass, 4, 5.0};
+  const iir_filter design{lowpass, delta};
+  SECTION("Impulse Response Decays") {
+    std::vector<double> data(4000, 0.0);
+    data[0] = 1.0;
+    design.apply(data);
+    REQUIRE(std::abs(data[1]) > 0.0);
+    for (size_t i{3000}; i < data.size(); ++i) {
+      REQUIRE(std::abs(data[i]) < 1e-10);
+    }
+  }
+  SECTION("Attenuates Above Corner") {
+    std::vector<double> data(5000);
+    for (size_t i{0}; i < data.size(); ++i) {
+      data[i] = std::sin(2.0 * pi * 30.0 * static_cast<double>(i) * delta);
+    }
+    design.apply(data, true);
+    for (size_t i{1000}; i < 4000; ++i) {
+      REQUIRE(std::abs(data[i]) < 1e-3);
+    }
+  }
+  SECTION("Zero Phase") {
+    std::vector<double> data(2001, 0.0);
+    for (size_t i{0}; i < data.size(); ++i) {
+      const double time{(static_cast<double>(i) - 1000.0) * delta};
+      data[i] = std::exp(-time * time / 0.02);
+    }
+    design.apply(data, true);
+    const auto peak{std::max_element(data.begin(), data.end())};
+    REQUIRE(std::distance(data.begin(), peak) == 1000);
+    REQUIRE_THAT(data[990], WithinAbs(data[1010], 1e-9));
+  }
+  SECTION("Batched Matches Single") {
+    std::vector<std::vector<double>> data(7, std::vector<double>(3000));
+    for (auto &channel : data) {
+      random_vector(&channel);
+    }
+    data[5].resize(1500);
+    for (const bool zero_phase : {false, true}) {
+      std::vector<std::vector<double>> expected{data};
+      std::vector<std::vector<double>> batched{data};
+      std::vector<std::span<double>> channels{};
+      for (size_t i{0}; i < data.size(); ++i) {
+        design.apply(expected[i], zero_phase);
+        channels.emplace_back(batched[i]);
+      }
+      design.apply(channels, zero_phase);
+      for (size_t i{0}; i < data.size(); ++i) {
+        for (size_t j{0}; j < data[i].size(); ++j) {
+          REQUIRE_THAT(batched[i][j], WithinAbs(expected[i][j], 1e-12));
+        }
+      }
+    }
+  }
+  SECTION("Cache") {
+    REQUIRE(iir_filter::get(lowpass, delta) == iir_filter::get(lowpass, delta));
+    REQUIRE(iir_filter::get(lowpass, delta) !=
+            iir_filter::get(lowpass, delta * 2.0));
+    // Bounded: the oldest design is rebuilt after max_cached_filters new ones
+    const std::shared_ptr<const iir_filter> oldest{
+        iir_filter::get(lowpass, delta * 3.0)};
+    for (size_t i{1}; i <= max_cached_filters; ++i) {
+      REQUIRE_NOTHROW(iir_filter::get(
+          {filter_type::lowpass, 2, static_cast<double>(i) * 0.01}, delta));
+    }
+    REQUIRE(iir_filter::get(lowpass, delta * 3.0) != oldest);
+  }
+}
+
+TEST_CASE("Processing: Filter: Traces") {
+  const filter_spec bandpass{filter_type::bandpass, 2, 0.5, 2.0};
+  std::vector<Trace> traces(6, gen_fake_trace());
+  for (size_t i{0}; i < traces.size(); ++i) {
+    std::vector<double> data(i == 2 ? 800 : 1200);
+    random_vector(&data);
+    traces[i].data1(data);
+    traces[i].delta(i == 4 ? 0.05 : 0.1);
+  }
+  std::vector<Trace> expected{traces};
+  for (Trace &trace : expected) {
+    filter(&trace, bandpass, true);
+  }
+  filter(traces, bandpass, true);
+  for (size_t i{0}; i < traces.size(); ++i) {
+    REQUIRE(traces[i].npts() == expected[i].npts());
+    // Statistics follow the filtered data
+    const data_stats stats{compute_stats(traces[i].data1_view())};
+    REQUIRE(traces[i].depmin() == static_cast<float>(stats.min));
+    REQUIRE(traces[i].depmax() == static_cast<float>(stats.max));
+    REQUIRE(traces[i].depmen() == static_cast<float>(stats.mean));
+    for (size_t j{0}; j < traces[i].data1_view().size(); ++j) {
+      REQUIRE_THAT(traces[i].data1_view()[j],
+                   WithinAbs(expected[i].data1_view()[j], 1e-12));
+    }
+  }
+  SECTION("Errors") {
+    traces[3].leven(false);
+    const std::vector<double> before(traces[0].data1_view().begin(),
+                                     traces[0].data1_view().end());
+    REQUIRE_THROWS_AS(filter(traces, bandpass), processing_error);
+    REQUIRE(std::equal(before.begin(), before.end(),
+                       traces[0].data1_view().begin()));
+    REQUIRE_THROWS_AS(filter(&traces[3], bandpass), processing_error);
+    REQUIRE_THROWS_AS(
+        filter(&traces[0], {filter_type::lowpass, 4, 6.0}), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Resample: Design") {
+  SECTION("Factors") {
+    REQUIRE(resample_factors(0.005, 0.025) == std::pair<size_t, size_t>{1, 5});
+    REQUIRE(resample_factors(0.01, 0.025) == std::pair<size_t, size_t>{2, 5});
+    REQUIRE(resample_factors(0.025, 0.01) == std::pair<size_t, size_t>{5, 2});
+    REQUIRE(resample_factors(0.01, 0.01) == std::pair<size_t, size_t>{1, 1});
+    REQUIRE_THROWS_AS(resample_factors(0.01, 0.01 * std::numbers::pi),
+                      processing_error);
+    REQUIRE_THROWS_AS(resample_factors(0.01, 0.0), processing_error);
+  }
+  SECTION("Kaiser Lowpass") {
+    REQUIRE_THAT(bessel_i0(0.0), WithinAbs(1.0, 1e-15));
+    REQUIRE_THAT(bessel_i0(1.0), WithinAbs(1.2660658777520082, 1e-14));
+    const std::vector<double> taps{kaiser_lowpass(40, 0.1, 8.0)};
+    REQUIRE(taps.size() == 81);
+    REQUIRE_THAT(std::accumulate(taps.begin(), taps.end(), 0.0),
+                 WithinAbs(1.0, 1e-12));
+    for (size_t i{0}; i < 40; ++i) {
+      REQUIRE_THAT(taps[i], WithinAbs(taps[80 - i], 1e-15));
+    }
+  }
+  SECTION("Dot Product") {
+    std::vector<double> lhs(13);
+    std::vector<double> rhs(13);
+    double expected{0.0};
+    for (size_t i{0}; i < lhs.size(); ++i) {
+      lhs[i] = static_cast<double>(i);
+      rhs[i] = 1.0 - static_cast<double>(i);
+      expected += lhs[i] * rhs[i];
+    }
+    REQUIRE_THAT(dot_product(lhs, rhs), WithinAbs(expected, 1e-12));
+  }
+  SECTION("Cache") {
+    REQUIRE(resampler::get(2, 10) == resampler::get(1, 5));
+    REQUIRE(resampler::get(4, 10)->up() == 2);
+    REQUIRE(resampler::get(4, 10)->down() == 5);
+    REQUIRE(resampler::get(2, 5)->output_size(101) == 41);
+    REQUIRE_THROWS_AS(resampler::get(0, 5), processing_error);
+    REQUIRE_THROWS_AS(resampler::get(1, max_resample_factor + 1),
+                      processing_error);
+    // Bounded: the oldest ratio is rebuilt after max_cached_resamplers new ones
+    const std::shared_ptr<const resampler> oldest{resampler::get(7, 3)};
+    for (size_t i{1}; i <= max_cached_resamplers; ++i) {
+      REQUIRE(resampler::get(1, 100 + i)->down() == 100 + i);
+    }
+    REQUIRE(resampler::get(7, 3) != oldest);
+  }
+}
+
+TEST_CASE("Processing: Resample: Apply") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  // 1 Hz sine sampled at 100 Hz
+  std::vector<double> data(2000);
+  for (size_t i{0}; i < data.size(); ++i) {
+    data[i] = std::sin(2.0 * pi * static_cast<double>(i) * 0.01);
+  }
+  for (const auto &[up, down] : std::vector<std::pair<size_t, size_t>>{
+           {1, 5}, {2, 5}, {5, 2}, {3, 1}}) {
+    CAPTURE(up, down);
+    const std::shared_ptr<const resampler> filter{resampler::get(up, down)};
+    std::vector<double> output(filter->output_size(data.size()));
+    filter->apply(data, output);
+    const double new_delta{0.01 * static_cast<double>(down) /
+                           static_cast<double>(up)};
+    // Away from the edges, the sine is preserved
+    for (size_t i{output.size() / 10}; i < output.size() * 9 / 10; ++i) {
+      const double expected{
+          std::sin(2.0 * pi * static_cast<double>(i) * new_delta)};
+      REQUIRE_THAT(output[i], WithinAbs(expected, 1e-3));
+    }
+    if (down > up) {
+      std::vector<double> in_place{data};
+      REQUIRE(filter->apply(std::span<double>{in_place}) == output.size());
+      for (size_t i{0}; i < output.size(); ++i) {
+        REQUIRE(in_place[i] == output[i]);
+      }
+    } else {
+      std::vector<double> in_place{data};
+      REQUIRE_THROWS_AS(filter->apply(std::span<double>{in_place}),
+                        processing_error);
+    }
+  }
+  SECTION("Anti-Aliasing") {
+    // 30 Hz sine (above the 10 Hz Nyquist frequency after decimation by 5)
+    std::vector<double> high(2000);
+    for (size_t i{0}; i < high.size(); ++i) {
+      high[i] = std::sin(2.0 * pi * 30.0 * static_cast<double>(i) * 0.01);
+    }
+    const size_t size{resampler::get(1, 5)->apply(std::span<double>{high})};
+    for (size_t i{size / 10}; i < size * 9 / 10; ++i) {
+      REQUIRE(std::abs(high[i]) < 1e-3);
+    }
+  }
+}
+
+TEST_CASE("Processing: Resample: Trace") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  Trace trace = gen_fake_trace();
+  std::vector<double> data(1000);
+  for (size_t i{0}; i < data.size(); ++i) {
+    data[i] = 2.0 * std::sin(2.0 * pi * static_cast<double>(i) * 0.005);
+  }
+  trace.data1(data);
+  trace.delta(0.005);
+  trace.b(10.0);
+  SECTION("Decimate") {
+    decimate(&trace, 5);
+    REQUIRE(trace.npts() == 200);
+    REQUIRE(trace.data1_view().size() == 200);
+    REQUIRE_THAT(trace.delta(), WithinAbs(0.025, 1e-12));
+    REQUIRE(trace.b() == 10.0);
+    REQUIRE_THAT(trace.e(), WithinAbs(10.0 + (199.0 * 0.025), 1e-9));
+    REQUIRE_THAT(trace.depmax(), WithinAbs(2.0, 1e-2));
+    REQUIRE_THAT(trace.depmin(), WithinAbs(-2.0, 1e-2));
+  }
+  SECTION("Resample") {
+    resample(&trace, 0.002);
+    REQUIRE(trace.npts() == 2500);
+    REQUIRE_THAT(trace.delta(), WithinAbs(0.002, 1e-12));
+    REQUIRE_THAT(trace.e(), WithinAbs(10.0 + (2499.0 * 0.002), 1e-9));
+    for (size_t i{250}; i < 2250; ++i) {
+      const double expected{
+          2.0 * std::sin(2.0 * pi * static_cast<double>(i) * 0.002)};
+      REQUIRE_THAT(trace.data1_view()[i], WithinAbs(expected, 1e-3));
+    }
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(decimate(&trace, 0), processing_error);
+    REQUIRE_THROWS_AS(resample(&trace, -1.0), processing_error);
+    trace.leven(false);
+    REQUIRE_THROWS_AS(decimate(&trace, 2), processing_error);
+    Trace empty{};
+    empty.leven(true);
+    empty.delta(0.01);
+    REQUIRE_THROWS_AS(decimate(&empty, 2), processing_error);
+  }
+}
+
+TEST_CASE("Processing: To Even: Interpolate") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  // Jittered positions over [0, 10]
+  std::vector<double> x(201);
+  for (size_t i{0}; i < x.size(); ++i) {
+    const double jitter{(i % 3 == 1) ? 0.01 : ((i % 3 == 2) ? -0.015 : 0.0)};
+    x[i] = (static_cast<double>(i) * 0.05) + (i + 1 < x.size() ? jitter : 0.0);
+  }
+  std::vector<double> output(1001);
+  SECTION("Linear Is Exact For Lines") {
+    std::vector<double> y(x.size());
+    for (size_t i{0}; i < x.size(); ++i) {
+      y[i] = 3.0 - (2.0 * x[i]);
+    }
+    for (const interpolation method :
+         {interpolation::linear, interpolation::akima}) {
+      interpolate(x, y, 0.0, 0.01, output, method);
+      for (size_t j{0}; j < output.size(); ++j) {
+        REQUIRE_THAT(output[j],
+                     WithinAbs(3.0 - (2.0 * static_cast<double>(j) * 0.01),
+                               1e-12));
+      }
+    }
+  }
+  SECTION("Akima Is Smooth") {
+    std::vector<double> y(x.size());
+    for (size_t i{0}; i < x.size(); ++i) {
+      y[i] = std::sin(2.0 * pi * 0.2 * x[i]);
+    }
+    std::vector<double> linear(output.size());
+    interpolate(x, y, 0.0, 0.01, linear, interpolation::linear);
+    interpolate(x, y, 0.0, 0.01, output, interpolation::akima);
+    double linear_error{0.0};
+    double akima_error{0.0};
+    for (size_t j{0}; j < output.size(); ++j) {
+      const double expected{
+          std::sin(2.0 * pi * 0.2 * static_cast<double>(j) * 0.01)};
+      linear_error = std::max(linear_error, std::abs(linear[j] - expected));
+      akima_error = std::max(akima_error, std::abs(output[j] - expected));
+    }
+    REQUIRE(akima_error < 1e-4);
+    REQUIRE(akima_error < linear_error);
+  }
+  SECTION("Akima Does Not Overshoot Steps") {
+    std::vector<double> y(x.size(), 0.0);
+    std::fill(y.begin() + 100, y.end(), 1.0);
+    interpolate(x, y, 0.0, 0.01, output, interpolation::akima);
+    for (const double value : output) {
+      REQUIRE(value >= 0.0);
+      REQUIRE(value <= 1.0);
+    }
+  }
+  SECTION("Outside Range") {
+    const std::vector<double> short_x{1.0, 2.0};
+    const std::vector<double> short_y{5.0, 7.0};
+    std::vector<double> result(5);
+    interpolate(short_x, short_y, 0.0, 1.0, result, interpolation::akima);
+    REQUIRE(result == std::vector<double>{5.0, 5.0, 7.0, 7.0, 7.0});
+  }
+}
+
+TEST_CASE("Processing: To Even: Trace") {
+  Trace trace{};
+  trace.leven(false);
+  trace.iftype(itime);
+  const std::vector<double> x{1.0, 1.25, 1.6, 2.0, 2.2, 3.0};
+  std::vector<double> y(x.size());
+  for (size_t i{0}; i < x.size(); ++i) {
+    y[i] = 4.0 * x[i];
+  }
+  trace.data1(y);
+  trace.data2(x);
+  REQUIRE(trace.npts() == 6);
+  SECTION("Convert") {
+    to_even(&trace, 0.1, interpolation::akima);
+    REQUIRE(trace.leven());
+    REQUIRE(trace.data2_view().empty());
+    REQUIRE(trace.npts() == 21);
+    REQUIRE(trace.delta() == 0.1);
+    REQUIRE(trace.b() == 1.0);
+    REQUIRE_THAT(trace.e(), WithinAbs(3.0, 1e-12));
+    REQUIRE_THAT(trace.depmax(), WithinAbs(12.0, 1e-5));
+    for (size_t j{0}; j < 21; ++j) {
+      REQUIRE_THAT(trace.data1_view()[j],
+                   WithinAbs(4.0 * (1.0 + (static_cast<double>(j) * 0.1)),
+                             1e-12));
+    }
+    REQUIRE_THROWS_AS(to_even(&trace, 0.1), processing_error);
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(to_even(&trace, 0.0), processing_error);
+    std::vector<double> repeated{x};
+    repeated[3] = repeated[2];
+    trace.data2(repeated);
+    REQUIRE_THROWS_AS(to_even(&trace, 0.1), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Parallel For") {
+  std::vector<int> hits(1000, 0);
+  parallel_for(hits.size(), [&hits](const size_t i) { hits[i] += 1; }, 4);
+  REQUIRE(std::all_of(hits.begin(), hits.end(),
+                      [](const int hit) { return hit == 1; }));
+  std::atomic<size_t> total{0};
+  parallel_for(100, [&total](const size_t i) { total += i; });
+  REQUIRE(total == 4950);
+  REQUIRE_THROWS_AS(parallel_for(
+                        100,
+                        [](const size_t i) {
+                          if (i == 42) {
+                            throw processing_error("Task failed.");
+                          }
+                        },
+                        4),
+                    processing_error);
+  REQUIRE_NOTHROW(parallel_for(0, [](const size_t) {}));
+}
+
+// Direct (time-domain) normalized cross-correlation
+std::vector<double> direct_xcorr(const std::vector<double> &pattern,
+                                 std::span<const double> data) {
+  std::vector<double> demeaned{pattern};
+  rmean(demeaned);
+  const double pattern_norm{std::sqrt(dot_product(demeaned, demeaned))};
+  const size_t width{pattern.size()};
+  std::vector<double> result(data.size() + 1 - width);
+  for (size_t lag{0}; lag < result.size(); ++lag) {
+    std::vector<double> window(data.begin() + static_cast<long>(lag),
+                               data.begin() + static_cast<long>(lag + width));
+    rmean(window);
+    const double window_norm{std::sqrt(dot_product(window, window))};
+    result[lag] =
+        dot_product(demeaned, window) / (pattern_norm * window_norm);
+  }
+  return result;
+}
+
+TEST_CASE("Processing: Cross-Correlation") {
+  std::vector<double> data(20000);
+  random_vector(&data);
+  // Template 0 is a copy of the data at 12345 (plus an offset and scale)
+  std::vector<std::vector<double>> templates{std::vector<double>(300),
+                                             std::vector<double>(1000),
+                                             std::vector<double>(300)};
+  for (size_t i{0}; i < 300; ++i) {
+    templates[0][i] = 5.0 + (3.0 * data[12345 + i]);
+  }
+  random_vector(&templates[1]);
+  random_vector(&templates[2]);
+  const template_bank bank{templates};
+  REQUIRE(bank.size() == 3);
+  REQUIRE(bank.template_size(1) == 1000);
+  REQUIRE(bank.fft_size() >= 4000);
+  REQUIRE(bank.step() == bank.fft_size() - 999);
+  SECTION("Matches Direct") {
+    const std::vector<std::vector<double>> result{bank.correlate(data)};
+    for (size_t i{0}; i < templates.size(); ++i) {
+      const std::vector<double> expected{direct_xcorr(templates[i], data)};
+      REQUIRE(result[i].size() == expected.size());
+      for (size_t lag{0}; lag < expected.size(); lag += 7) {
+        REQUIRE_THAT(result[i][lag], WithinAbs(expected[lag], 1e-9));
+      }
+    }
+    REQUIRE_THAT(result[0][12345], WithinAbs(1.0, 1e-9));
+    const auto peak{std::max_element(result[0].begin(), result[0].end())};
+    REQUIRE(std::distance(result[0].begin(), peak) == 12345);
+  }
+  SECTION("Parallel Matches Serial") {
+    std::vector<double> other(50000);
+    random_vector(&other);
+    const std::vector<double> short_data(500, 1.0);
+    const std::vector<std::span<const double>> traces{data, other,
+                                                      short_data};
+    const auto result{correlate(bank, traces, 4)};
+    REQUIRE(result.size() == 3);
+    for (size_t trace{0}; trace < 2; ++trace) {
+      const auto expected{bank.correlate(traces[trace])};
+      for (size_t i{0}; i < bank.size(); ++i) {
+        REQUIRE(result[trace][i] == expected[i]);
+      }
+    }
+    REQUIRE(result[2][0].size() == 201);
+    REQUIRE(result[2][1].empty());
+    // Constant data has no variance
+    REQUIRE(std::all_of(result[2][0].begin(), result[2][0].end(),
+                        [](const double value) { return value == 0.0; }));
+  }
+  SECTION("Traces") {
+    std::vector<Trace> traces(2, gen_fake_trace());
+    traces[0].data1(data);
+    const auto result{correlate(bank, traces)};
+    REQUIRE(result[0][0].size() == data.size() - 299);
+    REQUIRE_THAT(result[0][0][12345], WithinAbs(1.0, 1e-9));
+    REQUIRE(result[1][1].size() == traces[1].data1_view().size() - 999);
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(template_bank{{}}, processing_error);
+    REQUIRE_THROWS_AS(template_bank{{std::vector<double>(10, 2.0)}},
+                      processing_error);
+    REQUIRE_THROWS_AS(template_bank{{std::vector<double>{1.0}}},
+                      processing_error);
+    std::vector<double> output(10);
+    const std::vector<std::span<double>> outputs{output};
+    REQUIRE_THROWS_AS(bank.correlate(data, outputs), processing_error);
+  }
+}
+
+// Direct STA/LTA (classic: window averages ending at each sample)
+std::vector<double> direct_sta_lta(const std::vector<double> &data,
+                                   const size_t n_sta, const size_t n_lta,
+                                   const sta_lta_method method) {
+  std::vector<double> result(data.size(), 0.0);
+  double short_term{0.0};
+  double long_term{0.0};
+  for (size_t i{0}; i < data.size(); ++i) {
+    const double energy{data[i] * data[i]};
+    if (method == sta_lta_method::recursive) {
+      short_term += (energy - short_term) / static_cast<double>(n_sta);
+      long_term += (energy - long_term) / static_cast<double>(n_lta);
+    } else {
+      short_term = 0.0;
+      long_term = 0.0;
+      for (size_t j{0}; (j < n_lta) && (j <= i); ++j) {
+        const double value{data[i - j] * data[i - j]};
+        long_term += value / static_cast<double>(n_lta);
+        short_term += (j < n_sta) ? value / static_cast<double>(n_sta) : 0.0;
+      }
+    }
+    if ((i + 1 >= n_lta) && (long_term > 0.0)) {
+      result[i] = short_term / long_term;
+    }
+  }
+  return result;
+}
+
+TEST_CASE("Processing: STA/LTA") {
+  // Noise with a burst at [3000, 3200)
+  std::vector<double> data(6000);
+  random_vector(&data);
+  for (size_t i{3000}; i < 3200; ++i) {
+    data[i] *= 20.0;
+  }
+  for (const sta_lta_method method :
+       {sta_lta_method::classic, sta_lta_method::recursive}) {
+    const std::vector<double> expected{direct_sta_lta(data, 50, 500, method)};
+    SECTION("Matches Direct") {
+      sta_lta detector{50, 500, method};
+      std::vector<double> ratio(data.size());
+      detector.process(data, ratio);
+      REQUIRE(detector.samples() == data.size());
+      for (size_t i{0}; i < data.size(); ++i) {
+        REQUIRE_THAT(ratio[i], WithinAbs(expected[i], 1e-9));
+      }
+    }
+    SECTION("Chunks") {
+      sta_lta detector{50, 500, method};
+      std::vector<double> ratio(data.size());
+      const std::span<const double> input{data};
+      size_t start{0};
+      for (const size_t size :
+           std::array<size_t, 6>{1, 7, 499, 1000, 2, 4491}) {
+        detector.process(input.subspan(start, size),
+                         std::span<double>{ratio}.subspan(start, size));
+        start += size;
+      }
+      REQUIRE(start == data.size());
+      for (size_t i{0}; i < data.size(); ++i) {
+        REQUIRE_THAT(ratio[i], WithinAbs(expected[i], 1e-9));
+      }
+      detector.reset();
+      REQUIRE(detector.samples() == 0);
+    }
+    SECTION("Channels") {
+      constexpr size_t channels{5};
+      std::vector<double> interleaved(data.size() * channels);
+      for (size_t i{0}; i < data.size(); ++i) {
+        for (size_t channel{0}; channel < channels; ++channel) {
+          interleaved[(i * channels) + channel] =
+              data[i] * static_cast<double>(channel + 1);
+        }
+      }
+      sta_lta detector{50, 500, method, channels};
+      std::vector<double> ratio(interleaved.size());
+      detector.process(interleaved, ratio);
+      for (size_t i{0}; i < data.size(); ++i) {
+        for (size_t channel{0}; channel < channels; ++channel) {
+          // The ratio does not depend on the amplitude
+          REQUIRE_THAT(ratio[(i * channels) + channel],
+                       WithinAbs(expected[i], 1e-9));
+        }
+      }
+    }
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(sta_lta(0, 10), processing_error);
+    REQUIRE_THROWS_AS(sta_lta(10, 10), processing_error);
+    REQUIRE_THROWS_AS(sta_lta(1, 10, sta_lta_method::classic, 0),
+                      processing_error);
+  }
+}
+
+TEST_CASE("Processing: Trigger") {
+  SECTION("Windows") {
+    const std::vector<double> ratio{0.0, 4.0, 3.0, 2.0, 0.5,
+                                    5.0, 0.9, 3.9, 4.1, 1.1};
+    trigger detector{3.5, 1.0};
+    std::vector<trigger_window> windows{};
+    detector.scan(std::span<const double>{ratio}.subspan(0, 3), &windows);
+    REQUIRE(detector.active());
+    REQUIRE(windows.empty());
+    detector.scan(std::span<const double>{ratio}.subspan(3), &windows);
+    REQUIRE(windows.size() == 2);
+    REQUIRE(windows[0].on == 1);
+    REQUIRE(windows[0].off == 4);
+    REQUIRE(windows[1].on == 5);
+    REQUIRE(windows[1].off == 6);
+    detector.finish(&windows);
+    REQUIRE(windows.size() == 3);
+    REQUIRE(windows[2].on == 7);
+    REQUIRE(windows[2].off == 10);
+    REQUIRE_FALSE(detector.active());
+    REQUIRE_THROWS_AS(trigger(1.0, 2.0), processing_error);
+  }
+  SECTION("Trace") {
+    Trace trace = gen_fake_trace();
+    std::vector<double> data(6000);
+    random_vector(&data);
+    for (size_t i{3000}; i < 3200; ++i) {
+      data[i] *= 20.0;
+    }
+    trace.data1(data);
+    trace.delta(0.01);
+    trace.b(-5.0);
+    const sta_lta_spec spec{0.5, 5.0, 4.0, 1.5, sta_lta_method::classic};
+    const std::vector<double> ratio{sta_lta_ratio(trace, spec)};
+    const std::vector<double> expected{
+        direct_sta_lta(data, 50, 500, sta_lta_method::classic)};
+    REQUIRE(ratio.size() == expected.size());
+    for (size_t i{0}; i < ratio.size(); ++i) {
+      REQUIRE_THAT(ratio[i], WithinAbs(expected[i], 1e-9));
+    }
+    const std::vector<trigger_window> windows{detect_triggers(trace, spec)};
+    REQUIRE(windows.size() == 1);
+    REQUIRE(windows[0].on >= 3000);
+    REQUIRE(windows[0].on < 3010);
+    REQUIRE(windows[0].off > 3200);
+    REQUIRE(write_onsets(&trace, windows) == 1);
+    REQUIRE_THAT(trace.t0(),
+                 WithinAbs(-5.0 + (static_cast<double>(windows[0].on) * 0.01),
+                           1e-9));
+    REQUIRE(trace.kt0() == "STA/LTA");
+    const std::vector<trigger_window> many(12, windows[0]);
+    REQUIRE(write_onsets(&trace, many, "AUTO") == max_picks);
+    REQUIRE(trace.kt9() == "AUTO");
+    write_pick(&trace, time_marker::t4, 1.5, "P");
+    REQUIRE(trace.t4() == 1.5);
+    REQUIRE(trace.kt4() == "P");
+    REQUIRE_THROWS_AS(write_pick(&trace, time_marker::a, 1.5, "P"),
+                      processing_error);
+    REQUIRE_THROWS_AS(detect_triggers(trace, {0.0, 5.0}), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Coincidence") {
+  const auto make = [](const std::string &station, const std::string &channel,
+                       const double on, const double off) {
+    return timed_trigger{station, station + '.' + channel, on, off};
+  };
+  std::vector<timed_trigger> triggers{
+      make("XX.D", "HHZ", 300.0, 301.0), make("XX.A", "HHZ", 100.0, 104.0),
+      make("XX.A", "HHN", 101.0, 130.0), make("XX.B", "HHZ", 102.0, 103.0),
+      make("XX.C", "HHZ", 105.0, 106.0), make("XX.E", "HHZ", 200.0, 201.0),
+      make("XX.E", "HHN", 200.5, 201.0)};
+  SECTION("Station Count") {
+    const coincidence_spec spec{3.0, 10.0, {}};
+    const std::vector<coincidence_event> events{coincidence(triggers, spec)};
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].on == 100.0);
+    // Station B stops counting at 102 + 10
+    REQUIRE(events[0].off == 112.0);
+    REQUIRE(events[0].peak == 3.0);
+    REQUIRE(events[0].stations.size() == 3);
+  }
+  SECTION("Channels Count Once") {
+    const coincidence_spec spec{2.0, 1.0, {}};
+    const std::vector<coincidence_event> events{coincidence(triggers, spec)};
+    // A overlaps B and then C; E alone (two channels) does not count
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].on == 100.0);
+    REQUIRE(events[0].off == 103.0);
+    REQUIRE(events[0].stations ==
+            std::vector<std::string>{"XX.A", "XX.B"});
+    REQUIRE(events[1].on == 100.0);
+    REQUIRE(events[1].off == 106.0);
+    REQUIRE(events[1].stations ==
+            std::vector<std::string>{"XX.A", "XX.C"});
+  }
+  SECTION("Weights") {
+    coincidence_spec spec{3.0, 10.0, {{"XX.D", 3.0}, {"XX.B", 0.5}}};
+    const std::vector<coincidence_event> events{coincidence(triggers, spec)};
+    // A, B, and C only reach 2.5; D alone reaches 3
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].on == 300.0);
+    REQUIRE(events[0].off == 310.0);
+    REQUIRE(events[0].peak == 3.0);
+    REQUIRE(events[0].stations == std::vector<std::string>{"XX.D"});
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(coincidence(triggers, {0.0, 10.0, {}}),
+                      processing_error);
+    REQUIRE_THROWS_AS(coincidence(triggers, {1.0, -1.0, {}}),
+                      processing_error);
+  }
+}
+
+TEST_CASE("Processing: Coincidence: Traces") {
+  Trace trace = gen_fake_trace();
+  trace.delta(0.01);
+  trace.b(-5.0);
+  const std::vector<trigger_window> windows{{100, 250}};
+  const std::vector<timed_trigger> triggers{timed_triggers(trace, windows)};
+  REQUIRE(triggers.size() == 1);
+  REQUIRE(triggers[0].station == station_key(trace));
+  REQUIRE(triggers[0].station == trace.knetwk() + '.' + trace.kstnm());
+  REQUIRE(triggers[0].channel == triggers[0].station + '.' + trace.kcmpnm());
+  REQUIRE_THAT(triggers[0].on,
+               WithinAbs(trace.reference_epoch() - 5.0 + 1.0, 1e-6));
+  REQUIRE_THAT(triggers[0].off,
+               WithinAbs(trace.reference_epoch() - 5.0 + 2.5, 1e-6));
+  trace.nzyear(unset_int);
+  REQUIRE_THROWS_AS(timed_triggers(trace, windows), processing_error);
+}
+
+TEST_CASE("Processing: Analytic Signal") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  constexpr double delta{0.01};
+  // 1000 samples (a fast size) of a 5 Hz carrier modulated at 0.5 Hz
+  std::vector<double> data(1000);
+  std::vector<double> modulation(data.size());
+  for (size_t i{0}; i < data.size(); ++i) {
+    const double time{static_cast<double>(i) * delta};
+    modulation[i] = 1.0 + (0.5 * std::cos(2.0 * pi * 0.5 * time));
+    data[i] = modulation[i] * std::cos(2.0 * pi * 5.0 * time);
+  }
+  SECTION("Analytic") {
+    std::vector<complex> analytic(data.size());
+    analytic_signal(data, analytic);
+    for (size_t i{0}; i < data.size(); ++i) {
+      REQUIRE_THAT(analytic[i].real(), WithinAbs(data[i], 1e-12));
+    }
+  }
+  SECTION("Envelope") {
+    std::vector<double> result(data.size());
+    instantaneous(data, result, signal_attribute::envelope, delta);
+    for (size_t i{0}; i < data.size(); ++i) {
+      REQUIRE_THAT(result[i], WithinAbs(modulation[i], 1e-9));
+    }
+  }
+  SECTION("Phase and Frequency") {
+    std::vector<double> tone(data.size());
+    for (size_t i{0}; i < data.size(); ++i) {
+      tone[i] = std::cos(2.0 * pi * 5.0 * static_cast<double>(i) * delta);
+    }
+    std::vector<double> phase(tone.size());
+    instantaneous(tone, phase, signal_attribute::phase, delta);
+    for (size_t i{0}; i < tone.size(); ++i) {
+      const double expected{std::remainder(
+          2.0 * pi * 5.0 * static_cast<double>(i) * delta, 2.0 * pi)};
+      const double difference{std::remainder(phase[i] - expected, 2.0 * pi)};
+      REQUIRE_THAT(difference, WithinAbs(0.0, 1e-9));
+    }
+    // In place
+    instantaneous(tone, tone, signal_attribute::frequency, delta);
+    for (const double frequency : tone) {
+      REQUIRE_THAT(frequency, WithinAbs(5.0, 1e-9));
+    }
+  }
+  SECTION("Padded") {
+    // 997 samples (padded to 1000); edges are affected by the padding
+    const std::span<const double> prime{
+        std::span<const double>{data}.first(997)};
+    std::vector<double> result(prime.size());
+    instantaneous(prime, result, signal_attribute::envelope, delta);
+    for (size_t i{100}; i < 897; ++i) {
+      REQUIRE_THAT(result[i], WithinAbs(modulation[i], 2e-2));
+    }
+  }
+}
+
+TEST_CASE("Processing: Analytic Signal: Traces") {
+  std::vector<Trace> traces(5, gen_fake_trace());
+  for (Trace &trace : traces) {
+    std::vector<double> data(2000);
+    random_vector(&data);
+    trace.data1(data);
+  }
+  std::vector<Trace> expected{traces};
+  for (Trace &trace : expected) {
+    envelope(&trace);
+  }
+  envelope(traces, 3);
+  for (size_t i{0}; i < traces.size(); ++i) {
+    REQUIRE(traces[i].data1_view().size() == 2000);
+    REQUIRE(std::equal(traces[i].data1_view().begin(),
+                       traces[i].data1_view().end(),
+                       expected[i].data1_view().begin()));
+    REQUIRE(traces[i].depmin() >= 0.0);
+  }
+  instantaneous(traces, signal_attribute::frequency);
+  traces[2].leven(false);
+  REQUIRE_THROWS_AS(envelope(traces), processing_error);
+  REQUIRE_THROWS_AS(envelope(&traces[2]), processing_error);
+}
+
+TEST_CASE("Processing: Pole-Zero Files") {
+  SECTION("Read") {
+    std::istringstream input{"* comment line\n"
+                             "ZEROS 3\n"
+                             "  1.5 -2.5  * trailing comment\n"
+                             "poles 2\n"
+                             "-0.037 0.037\n"
+                             "-0.037 -0.037\n"
+                             "\n"
+                             "CONSTANT 3.9e+17\n"};
+    const pole_zero pz{read_pole_zero(&input)};
+    REQUIRE(pz.zeros.size() == 3);
+    REQUIRE(pz.zeros[0] == complex{1.5, -2.5});
+    REQUIRE(pz.zeros[1] == complex{0.0, 0.0});
+    REQUIRE(pz.zeros[2] == complex{0.0, 0.0});
+    REQUIRE(pz.poles.size() == 2);
+    REQUIRE(pz.poles[1] == complex{-0.037, -0.037});
+    REQUIRE(pz.constant == 3.9e+17);
+  }
+  SECTION("Invalid") {
+    for (const std::string text :
+         {"", "* only a comment\n", "ZEROS x\n", "ZEROS -1\n",
+          "ZEROS 1\n1.0 2.0\n3.0 4.0\n", "1.0 2.0\nZEROS 1\n",
+          "POLES 1\nPOLES 1\n", "POLES 1\n1.0\n", "POLES 1\nCONSTANT\n"}) {
+      std::istringstream input{text};
+      CAPTURE(text);
+      REQUIRE_THROWS_AS(read_pole_zero(&input), io_error);
+    }
+    REQUIRE_THROWS_AS(read_pole_zero(std::filesystem::path{"missing.pz"}),
+                      io_error);
+  }
+  SECTION("File") {
+    const std::filesystem::path path{"test_response.pz"};
+    {
+      std::ofstream file{path};
+      file << "ZEROS 1\nPOLES 1\n-1.0 0.0\nCONSTANT 2.0\n";
+    }
+    const pole_zero pz{read_pole_zero(path)};
+    std::filesystem::remove(path);
+    REQUIRE(pz.zeros.size() == 1);
+    REQUIRE(pz.poles.size() == 1);
+    REQUIRE(pz.constant == 2.0);
+  }
+}
+
+TEST_CASE("Processing: Instrument Response") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  const pole_zero pz{{{0.0, 0.0}, {0.0, 0.0}},
+                     {{-0.037, 0.037}, {-0.037, -0.037}, {-50.0, 0.0}},
+                     1.0e+9};
+  SECTION("Evaluate") {
+    // H(s) = 2 / (s + 1)
+    const pole_zero simple{{}, {{-1.0, 0.0}}, 2.0};
+    const complex value{evaluate_response(simple, 1.0 / (2.0 * pi))};
+    REQUIRE_THAT(value.real(), WithinAbs(1.0, 1e-12));
+    REQUIRE_THAT(value.imag(), WithinAbs(-1.0, 1e-12));
+  }
+  SECTION("Prefilter") {
+    const response_prefilter prefilter{0.5, 1.0, 10.0, 20.0};
+    REQUIRE(prefilter_weight(prefilter, 0.25) == 0.0);
+    REQUIRE_THAT(prefilter_weight(prefilter, 0.75), WithinAbs(0.5, 1e-12));
+    REQUIRE(prefilter_weight(prefilter, 5.0) == 1.0);
+    REQUIRE_THAT(prefilter_weight(prefilter, 15.0), WithinAbs(0.5, 1e-12));
+    REQUIRE(prefilter_weight(prefilter, 25.0) == 0.0);
+    REQUIRE(prefilter_weight({}, 25.0) == 1.0);
+  }
+  SECTION("Remove") {
+    // 1 Hz displacement (1000 samples at 100 Hz, a fast size)
+    constexpr double delta{0.01};
+    constexpr double frequency{1.0};
+    const size_t size{1000};
+    std::vector<double> displacement(size);
+    for (size_t i{0}; i < size; ++i) {
+      displacement[i] =
+          std::sin(2.0 * pi * frequency * static_cast<double>(i) * delta);
+    }
+    std::vector<complex> spectrum{rfft(displacement)};
+    for (size_t k{0}; k < spectrum.size(); ++k) {
+      spectrum[k] *= evaluate_response(
+          pz, static_cast<double>(k) / (static_cast<double>(size) * delta));
+    }
+    Trace trace{gen_fake_trace()};
+    trace.data1(irfft(spectrum, size));
+    trace.delta(delta);
+    Trace velocity{trace};
+    remove_response(&trace, pz, {0.05, 0.1, 20.0, 40.0}, idisp, 0.0);
+    REQUIRE(trace.idep() == idisp);
+    REQUIRE_THAT(trace.depmax(), WithinAbs(1.0, 1e-9));
+    for (size_t i{0}; i < size; ++i) {
+      REQUIRE_THAT(trace.data1_view()[i], WithinAbs(displacement[i], 1e-9));
+    }
+    remove_response(&velocity, pz, {}, ivel);
+    REQUIRE(velocity.idep() == ivel);
+    for (size_t i{0}; i < size; ++i) {
+      const double expected{2.0 * pi * frequency *
+                            std::cos(2.0 * pi * frequency *
+                                     static_cast<double>(i) * delta)};
+      REQUIRE_THAT(velocity.data1_view()[i], WithinAbs(expected, 1e-9));
+    }
+  }
+  SECTION("Water Level") {
+    const response_plan plan{pz, 1000, 0.01, {}, idisp, 20.0};
+    // |1/H| is at most 10 / max|H|
+    double peak{0.0};
+    for (size_t k{0}; k < 501; ++k) {
+      peak = std::max(peak, std::abs(evaluate_response(
+                                pz, static_cast<double>(k) / 10.0)));
+    }
+    for (const complex value : plan.values()) {
+      REQUIRE(std::abs(value) <= (10.0 / peak) * (1.0 + 1e-12));
+    }
+    REQUIRE(plan.values().size() == 501);
+    REQUIRE(plan.size() == 1000);
+  }
+  SECTION("Cache") {
+    const auto first{response_plan::get(pz, 1000, 0.01, {}, idisp, 60.0)};
+    const auto second{response_plan::get(pz, 1000, 0.01, {}, idisp, 60.0)};
+    const auto third{response_plan::get(pz, 1000, 0.01, {}, ivel, 60.0)};
+    REQUIRE(first == second);
+    REQUIRE(first != third);
+    for (size_t i{0}; i < max_cached_responses; ++i) {
+      std::ignore = response_plan::get(pz, 1001 + i, 0.01, {}, idisp, 60.0);
+    }
+    REQUIRE(response_plan::get(pz, 1000, 0.01, {}, idisp, 60.0) != first);
+  }
+  SECTION("Invalid") {
+    Trace trace{gen_fake_trace()};
+    REQUIRE_THROWS_AS(remove_response(&trace, pz, {}, itime),
+                      processing_error);
+    REQUIRE_THROWS_AS(remove_response(&trace, pz, {2.0, 1.0, 3.0, 4.0}),
+                      processing_error);
+    trace.leven(false);
+    REQUIRE_THROWS_AS(remove_response(&trace, pz), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Merge") {
+  const auto piece{[](const double begin, const std::vector<double> &values,
+                      const std::string &component = "HHZ") {
+    Trace trace{gen_fake_trace()};
+    trace.delta(0.5);
+    trace.b(begin);
+    trace.kcmpnm(component);
+    trace.data1(values);
+    trace.e(begin + (0.5 * static_cast<double>(values.size() - 1)));
+    return trace;
+  }};
+  SECTION("Adjacent") {
+    // Out of order, with a rounding error in the start times
+    const std::vector<Trace> pieces{piece(3.0 + 1e-4, {7.0, 8.0}),
+                                    piece(0.0, {1.0, 2.0, 3.0}),
+                                    piece(1.5, {4.0, 5.0, 6.0})};
+    const std::vector<Trace> merged{merge(pieces)};
+    REQUIRE(merged.size() == 1);
+    REQUIRE(merged[0].npts() == 8);
+    REQUIRE(merged[0].b() == 0.0);
+    REQUIRE_THAT(merged[0].e(), WithinAbs(3.5, 1e-6));
+    REQUIRE(merged[0].depmax() == 8.0F);
+    const std::span<const double> data{merged[0].data1_view()};
+    REQUIRE(std::vector<double>(data.begin(), data.end()) ==
+            std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+  }
+  SECTION("Overlaps") {
+    const std::vector<Trace> pieces{piece(0.0, {1.0, 1.0, 1.0, 1.0}),
+                                    piece(1.0, {3.0, 3.0, 3.0, 3.0}),
+                                    piece(0.5, {5.0})};
+    const std::vector<std::pair<overlap_policy, std::vector<double>>> cases{
+        {overlap_policy::keep_first, {1.0, 1.0, 1.0, 1.0, 3.0, 3.0}},
+        {overlap_policy::keep_last, {1.0, 5.0, 3.0, 3.0, 3.0, 3.0}},
+        {overlap_policy::average, {1.0, 3.0, 2.0, 2.0, 3.0, 3.0}}};
+    for (const auto &[overlap, expected] : cases) {
+      const std::vector<Trace> merged{
+          merge(pieces, {overlap, gap_policy::split})};
+      REQUIRE(merged.size() == 1);
+      const std::span<const double> data{merged[0].data1_view()};
+      REQUIRE(std::vector<double>(data.begin(), data.end()) == expected);
+    }
+  }
+  SECTION("Gaps") {
+    const std::vector<Trace> pieces{piece(0.0, {1.0, 2.0}),
+                                    piece(2.0, {6.0, 7.0})};
+    const std::vector<Trace> split{merge(pieces)};
+    REQUIRE(split.size() == 2);
+    REQUIRE(split[0].npts() == 2);
+    REQUIRE(split[1].npts() == 2);
+    REQUIRE(split[1].b() == 2.0);
+    const std::vector<std::pair<gap_policy, std::vector<double>>> cases{
+        {gap_policy::zero, {1.0, 2.0, 0.0, 0.0, 6.0, 7.0}},
+        {gap_policy::interpolate,
+         {1.0, 2.0, 10.0 / 3.0, 14.0 / 3.0, 6.0, 7.0}}};
+    for (const auto &[gap, expected] : cases) {
+      const std::vector<Trace> merged{
+          merge(pieces, {overlap_policy::keep_first, gap})};
+      REQUIRE(merged.size() == 1);
+      const std::span<const double> data{merged[0].data1_view()};
+      for (size_t i{0}; i < expected.size(); ++i) {
+        REQUIRE_THAT(data[i], WithinAbs(expected[i], 1e-12));
+      }
+    }
+    const std::vector<Trace> nan{
+        merge(pieces, {overlap_policy::keep_first, gap_policy::nan})};
+    REQUIRE(nan[0].npts() == 6);
+    REQUIRE(std::isnan(nan[0].data1_view()[2]));
+    REQUIRE(std::isnan(nan[0].data1_view()[3]));
+    REQUIRE(nan[0].data1_view()[4] == 6.0);
+  }
+  SECTION("Channels") {
+    const std::vector<Trace> pieces{piece(1.0, {3.0}, "HHN"),
+                                    piece(0.0, {1.0, 2.0}, "HHE"),
+                                    piece(0.0, {1.0, 2.0}, "HHN"),
+                                    piece(5.0, {}, "HHE")};
+    const std::vector<Trace> merged{merge(pieces)};
+    REQUIRE(merged.size() == 2);
+    REQUIRE(merged[0].kcmpnm() == "HHE");
+    REQUIRE(merged[0].npts() == 2);
+    REQUIRE(merged[1].kcmpnm() == "HHN");
+    REQUIRE(merged[1].npts() == 3);
+    REQUIRE(merge(std::vector<Trace>{}).empty());
+  }
+  SECTION("Errors") {
+    std::vector<Trace> pieces{piece(0.0, {1.0}), piece(1.0, {1.0})};
+    pieces[1].delta(0.25);
+    REQUIRE_THROWS_AS(merge(pieces), processing_error);
+    pieces[1].delta(0.5);
+    pieces[1].nzyear(unset_int);
+    REQUIRE_THROWS_AS(merge(pieces), processing_error);
+    pieces[1].nzyear(2023);
+    pieces[0].leven(false);
+    REQUIRE_THROWS_AS(merge(pieces), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Rotation") {
+  constexpr double baz{30.0};
+  std::vector<double> signal(100);
+  random_vector(&signal);
+  const auto component{[&signal](const std::string &name,
+                                 const double azimuth, const double inclination,
+                                 const std::array<double, 3> &motion) {
+    // motion: (Z, N, E) direction of the particle motion
+    Trace trace{gen_fake_trace()};
+    trace.kcmpnm(name);
+    trace.baz(static_cast<float>(baz));
+    trace.cmpaz(static_cast<float>(azimuth));
+    trace.cmpinc(static_cast<float>(inclination));
+    const double az_rad{azimuth * rad_per_deg};
+    const double inc_rad{inclination * rad_per_deg};
+    const double projection{
+        (motion[0] * std::cos(inc_rad)) +
+        (motion[1] * std::sin(inc_rad) * std::cos(az_rad)) +
+        (motion[2] * std::sin(inc_rad) * std::sin(az_rad))};
+    std::vector<double> data(signal.size());
+    for (size_t i{0}; i < signal.size(); ++i) {
+      data[i] = projection * signal[i];
+    }
+    trace.data1(data);
+    return trace;
+  }};
+  const auto horizontal{[](const double azimuth) {
+    return std::array<double, 3>{0.0, std::cos(azimuth * rad_per_deg),
+                                 std::sin(azimuth * rad_per_deg)};
+  }};
+  const auto require_data{[&signal](const Trace &trace, const double scale) {
+    for (size_t i{0}; i < signal.size(); ++i) {
+      REQUIRE_THAT(trace.data1_view()[i],
+                   WithinAbs(scale * signal[i], 1e-9));
+    }
+  }};
+  SECTION("Kernel") {
+    std::vector<double> first{1.0, 2.0};
+    std::vector<double> second{3.0, 4.0};
+    rotate_components(first, second, {0.0, 1.0, -1.0, 0.0});
+    REQUIRE(first == std::vector<double>{3.0, 4.0});
+    REQUIRE(second == std::vector<double>{-1.0, -2.0});
+  }
+  SECTION("Radial") {
+    for (const std::array<double, 2> azimuths :
+         {std::array<double, 2>{0.0, 90.0}, std::array<double, 2>{10.0, 100.0},
+          std::array<double, 2>{45.0, 315.0}}) {
+      CAPTURE(azimuths);
+      Trace first{component("HHN", azimuths[0], 90.0, horizontal(baz + 180))};
+      Trace second{
+          component("HHE", azimuths[1], 90.0, horizontal(baz + 180))};
+      rotate_to_rt(&first, &second);
+      require_data(first, 1.0);
+      require_data(second, 0.0);
+      REQUIRE(first.kcmpnm() == "HHR");
+      REQUIRE(second.kcmpnm() == "HHT");
+      REQUIRE(first.cmpaz() == 210.0F);
+      REQUIRE(second.cmpaz() == 300.0F);
+      REQUIRE(first.cmpinc() == 90.0F);
+    }
+  }
+  SECTION("Transverse") {
+    Trace first{component("HH1", 20.0, 90.0, horizontal(baz + 270))};
+    Trace second{component("HH2", 110.0, 90.0, horizontal(baz + 270))};
+    rotate_to_rt(&first, &second);
+    require_data(first, 0.0);
+    require_data(second, 1.0);
+  }
+  SECTION("LQT") {
+    constexpr double incidence{20.0};
+    const double ray{incidence * rad_per_deg};
+    const double beta{baz * rad_per_deg};
+    const std::array<double, 3> longitudinal{std::cos(ray),
+                                             -std::sin(ray) * std::cos(beta),
+                                             -std::sin(ray) * std::sin(beta)};
+    Trace vertical{component("HHZ", 0.0, 0.0, longitudinal)};
+    Trace north{component("HHN", 0.0, 90.0, longitudinal)};
+    Trace east{component("HHE", 90.0, 90.0, longitudinal)};
+    east.kcmpnm(unset_word);
+    rotate_to_lqt(&vertical, &north, &east, incidence);
+    require_data(vertical, 1.0);
+    require_data(north, 0.0);
+    require_data(east, 0.0);
+    REQUIRE(vertical.kcmpnm() == "HHL");
+    REQUIRE(north.kcmpnm() == "HHQ");
+    REQUIRE(east.kcmpnm() == "T");
+    REQUIRE(vertical.cmpinc() == 20.0F);
+    REQUIRE(north.cmpinc() == 70.0F);
+    REQUIRE(north.cmpaz() == 30.0F);
+    // Transverse motion matches rotate_to_rt
+    Trace z_comp{component("HHZ", 0.0, 0.0, horizontal(baz + 270))};
+    Trace n_comp{component("HHN", 0.0, 90.0, horizontal(baz + 270))};
+    Trace e_comp{component("HHE", 90.0, 90.0, horizontal(baz + 270))};
+    rotate_to_lqt(&z_comp, &n_comp, &e_comp, incidence);
+    require_data(z_comp, 0.0);
+    require_data(n_comp, 0.0);
+    require_data(e_comp, 1.0);
+  }
+  SECTION("Errors") {
+    Trace first{component("HHN", 0.0, 90.0, horizontal(0.0))};
+    Trace second{component("HHE", 90.0, 90.0, horizontal(0.0))};
+    Trace vertical{component("HHZ", 0.0, 0.0, horizontal(0.0))};
+    Trace copy{second};
+    copy.cmpaz(180.0F);
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = second;
+    copy.cmpinc(45.0F);
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = second;
+    copy.cmpaz(unset_float);
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = first;
+    copy.baz(unset_float);
+    REQUIRE_THROWS_AS(rotate_to_rt(&copy, &second), processing_error);
+    REQUIRE_THROWS_AS(rotate_to_lqt(&copy, &second, &vertical, 0.0),
+                      processing_error);
+    REQUIRE_THROWS_AS(rotate_to_lqt(&first, &first, &vertical, 0.0),
+                      processing_error);
+    copy = second;
+    copy.b(second.b() + second.delta());
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = second;
+    copy.nzyear(unset_int);
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = second;
+    copy.delta(second.delta() * 2.0);
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    copy = second;
+    copy.data1(std::vector<double>(10));
+    REQUIRE_THROWS_AS(rotate_to_rt(&first, &copy), processing_error);
+    // Aligned without reference times
+    first.nzyear(unset_int);
+    second.nzyear(unset_int);
+    REQUIRE_NOTHROW(rotate_to_rt(&first, &second));
+  }
+}
+
+TEST_CASE("Processing: Integration and Differentiation") {
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.5);
+  trace.b(1.0);
+  SECTION("Integrate") {
+    trace.data1(std::vector<double>(5, 1.0));
+    trace.idep(iacc);
+    Trace rectangle{trace};
+    integrate(&trace);
+    REQUIRE(trace.npts() == 4);
+    REQUIRE(trace.b() == 1.25);
+    REQUIRE(trace.e() == 2.75);
+    REQUIRE(trace.idep() == ivel);
+    REQUIRE(trace.depmax() == 2.0F);
+    const std::span<const double> data{trace.data1_view()};
+    REQUIRE(std::vector<double>(data.begin(), data.end()) ==
+            std::vector<double>{0.5, 1.0, 1.5, 2.0});
+    integrate(&trace);
+    REQUIRE(trace.idep() == idisp);
+    integrate(&trace);
+    REQUIRE(trace.idep() == iunkn);
+    integrate(&rectangle, integration_method::rectangle);
+    REQUIRE(rectangle.npts() == 5);
+    REQUIRE(rectangle.b() == 1.0);
+    REQUIRE(rectangle.e() == 3.0);
+    const std::span<const double> sums{rectangle.data1_view()};
+    REQUIRE(std::vector<double>(sums.begin(), sums.end()) ==
+            std::vector<double>{0.5, 1.0, 1.5, 2.0, 2.5});
+  }
+  SECTION("Differentiate") {
+    // Cubic (exact for five-point; central has an error of delta^2)
+    std::vector<double> data(10);
+    for (size_t i{0}; i < data.size(); ++i) {
+      const double time{1.0 + (0.5 * static_cast<double>(i))};
+      data[i] = time * time * time;
+    }
+    trace.data1(data);
+    trace.idep(idisp);
+    Trace five{trace};
+    differentiate(&trace);
+    REQUIRE(trace.npts() == 8);
+    REQUIRE(trace.b() == 1.5);
+    REQUIRE(trace.e() == 5.0);
+    REQUIRE(trace.idep() == ivel);
+    for (size_t i{0}; i < 8; ++i) {
+      const double time{1.5 + (0.5 * static_cast<double>(i))};
+      REQUIRE_THAT(trace.data1_view()[i],
+                   WithinAbs((3.0 * time * time) + 0.25, 1e-12));
+    }
+    differentiate(&five, difference_method::five_point);
+    REQUIRE(five.npts() == 6);
+    REQUIRE(five.b() == 2.0);
+    REQUIRE(five.e() == 4.5);
+    for (size_t i{0}; i < 6; ++i) {
+      const double time{2.0 + (0.5 * static_cast<double>(i))};
+      REQUIRE_THAT(five.data1_view()[i], WithinAbs(3.0 * time * time, 1e-12));
+    }
+    differentiate(&trace);
+    REQUIRE(trace.idep() == iacc);
+    differentiate(&trace);
+    REQUIRE(trace.idep() == iunkn);
+  }
+  SECTION("Round Trip") {
+    constexpr double pi{std::numbers::pi_v<double>};
+    std::vector<double> data(1000);
+    for (size_t i{0}; i < data.size(); ++i) {
+      data[i] = std::cos(2.0 * pi * 0.01 * static_cast<double>(i));
+    }
+    std::vector<double> result{data};
+    REQUIRE(integrate(result, 1.0, integration_method::rectangle) == 1000);
+    REQUIRE(differentiate(result, 1.0, difference_method::five_point) == 996);
+    // Backward sums differentiated (centered 1.5 samples ahead of the data)
+    for (size_t i{0}; i < 996; ++i) {
+      REQUIRE_THAT(result[i],
+                   WithinAbs(0.5 * (data[i + 2] + data[i + 3]), 1e-3));
+    }
+  }
+  SECTION("Errors") {
+    trace.data1(std::vector<double>{1.0, 2.0});
+    REQUIRE_THROWS_AS(differentiate(&trace), processing_error);
+    trace.data1(std::vector<double>{1.0});
+    REQUIRE_THROWS_AS(integrate(&trace), processing_error);
+    REQUIRE(differentiate(std::span<double>{}, 1.0,
+                          difference_method::five_point) == 0);
+    trace.data1(std::vector<double>{1.0, 2.0, 3.0});
+    trace.leven(false);
+    REQUIRE_THROWS_AS(integrate(&trace), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Spectrogram") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.01);
+  trace.b(2.0);
+  // 2 Hz sine (amplitude 3) on a constant
+  std::vector<double> data(1000);
+  for (size_t i{0}; i < data.size(); ++i) {
+    data[i] =
+        5.0 + (3.0 * std::sin(2.0 * pi * 2.0 * static_cast<double>(i) * 0.01));
+  }
+  trace.data1(data);
+  SECTION("Frames") {
+    const spectrogram_matrix result{spectrogram(trace, 200, 100, 400)};
+    REQUIRE(result.frames == 9);
+    REQUIRE(result.bins == 201);
+    REQUIRE(result.values.size() == 9 * 201);
+    REQUIRE_THAT(result.start, WithinAbs(2.995, 1e-12));
+    REQUIRE_THAT(result.time_step, WithinAbs(1.0, 1e-12));
+    REQUIRE_THAT(result.frequency_step, WithinAbs(0.25, 1e-12));
+    for (size_t index{0}; index < result.frames; ++index) {
+      const std::span<const double> frame{result.frame(index)};
+      REQUIRE(frame.size() == 201);
+      // Peak at 2 Hz, mean removed
+      REQUIRE(std::max_element(frame.begin(), frame.end()) - frame.begin() ==
+              8);
+      REQUIRE(frame[0] < 1e-6 * frame[8]);
+      // Integral of the PSD is the mean square of the sine
+      double total{0.0};
+      for (const double value : frame) {
+        total += value * result.frequency_step;
+      }
+      REQUIRE_THAT(total, WithinAbs(4.5, 1e-6));
+    }
+  }
+  SECTION("Tapers") {
+    for (const taper_window taper :
+         {taper_window::hann, taper_window::hamming, taper_window::cosine}) {
+      const spectrogram_matrix result{spectrogram(trace, 100, 0, 0, taper)};
+      REQUIRE(result.frames == 10);
+      REQUIRE(result.bins == 51);
+      double total{0.0};
+      for (const double value : result.frame(3)) {
+        total += value * result.frequency_step;
+      }
+      REQUIRE_THAT(total, WithinAbs(4.5, 1e-6));
+    }
+  }
+  SECTION("Traces") {
+    std::vector<Trace> traces(5, trace);
+    for (Trace &copy : traces) {
+      std::vector<double> values(
+          1000 + (100 * static_cast<size_t>(&copy - traces.data())));
+      random_vector(&values);
+      copy.data1(values);
+    }
+    const std::vector<spectrogram_matrix> results{
+        spectrogram(traces, 128, 64, 0, taper_window::hann, 3)};
+    REQUIRE(results.size() == 5);
+    for (size_t i{0}; i < traces.size(); ++i) {
+      const spectrogram_matrix single{spectrogram(traces[i], 128, 64)};
+      REQUIRE(results[i].frames == single.frames);
+      REQUIRE(results[i].values == single.values);
+    }
+    const spectrogram_plan plan{128, 64};
+    REQUIRE(plan.frames(127) == 0);
+    REQUIRE(plan.frames(128) == 1);
+    REQUIRE(plan.frames(255) == 2);
+    std::vector<double> output(10);
+    REQUIRE_THROWS_AS(plan.apply(traces[0].data1_view(), 0.01, output),
+                      processing_error);
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(spectrogram(trace, 0, 0), processing_error);
+    REQUIRE_THROWS_AS(spectrogram(trace, 100, 100), processing_error);
+    REQUIRE_THROWS_AS(spectrogram(trace, 100, 50, 64), processing_error);
+    trace.leven(false);
+    REQUIRE_THROWS_AS(spectrogram(trace, 100, 50), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Stacking") {
+  Trace trace{gen_fake_trace()};
+  trace.delta(0.5);
+  SECTION("Markers") {
+    trace.a(3.0);
+    trace.t3(4.5);
+    REQUIRE(marker_time(trace, time_marker::a) == 3.0);
+    REQUIRE(marker_time(trace, time_marker::t3) == 4.5);
+    REQUIRE(marker_time(trace, time_marker::b) == trace.b());
+    trace.t9(unset_double);
+    REQUIRE(marker_time(trace, time_marker::t9) == unset_double);
+  }
+  SECTION("Alignment") {
+    // Spike at the arrival, with different begin times and arrivals
+    std::vector<Trace> traces(4, trace);
+    for (size_t i{0}; i < traces.size(); ++i) {
+      std::vector<double> data(20, 0.0);
+      data[5 + (2 * i)] = 1.0;
+      traces[i].b(-1.0 + static_cast<double>(i));
+      traces[i].a(traces[i].b() + (0.5 * static_cast<double>(5 + (2 * i))));
+      traces[i].data1(data);
+    }
+    const stacker result{
+        stack(traces, time_marker::a, {8, 0.5, -2.0, stack_method::linear})};
+    REQUIRE(result.count() == 4);
+    const std::vector<double> values{result.result()};
+    REQUIRE(values == std::vector<double>{0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0,
+                                          0.0});
+    const Trace stacked{result.to_trace()};
+    REQUIRE(stacked.npts() == 8);
+    REQUIRE(stacked.b() == -2.0);
+    REQUIRE(stacked.e() == 1.5);
+    REQUIRE(stacked.delta() == 0.5);
+    REQUIRE(stacked.depmax() == 1.0F);
+  }
+  SECTION("Coverage") {
+    stacker partial{{5, 1.0, 0.0, stack_method::linear}};
+    partial.add(std::vector<double>{1.0, 1.0, 1.0}, -1);
+    partial.add(std::vector<double>{3.0, 3.0, 3.0}, 1);
+    partial.add(std::vector<double>{9.0}, 10);
+    REQUIRE(partial.count() == 3);
+    REQUIRE(partial.result() ==
+            std::vector<double>{1.0, 2.0, 3.0, 3.0, 0.0});
+  }
+  SECTION("Nth Root") {
+    stacker root{{2, 1.0, 0.0, stack_method::nth_root, 2.0}};
+    root.add(std::vector<double>{1.0, -4.0}, 0);
+    root.add(std::vector<double>{16.0, 4.0}, 0);
+    const std::vector<double> values{root.result()};
+    REQUIRE_THAT(values[0], WithinAbs(6.25, 1e-12));
+    REQUIRE_THAT(values[1], WithinAbs(0.0, 1e-12));
+  }
+  SECTION("Phase Weighted") {
+    constexpr double pi{std::numbers::pi_v<double>};
+    std::vector<double> wave(1000);
+    for (size_t i{0}; i < wave.size(); ++i) {
+      wave[i] = std::cos(2.0 * pi * 0.05 * static_cast<double>(i));
+    }
+    std::vector<double> inverted(wave.size());
+    for (size_t i{0}; i < wave.size(); ++i) {
+      inverted[i] = -wave[i];
+    }
+    stacker coherent{{1000, 1.0, 0.0, stack_method::phase_weighted, 2.0}};
+    coherent.add(wave, 0);
+    coherent.add(wave, 0);
+    stacker incoherent{coherent.spec()};
+    incoherent.add(wave, 0);
+    incoherent.add(inverted, 0);
+    const std::vector<double> same{coherent.result()};
+    const std::vector<double> opposite{incoherent.result()};
+    for (size_t i{0}; i < wave.size(); ++i) {
+      REQUIRE_THAT(same[i], WithinAbs(wave[i], 1e-9));
+      REQUIRE_THAT(opposite[i], WithinAbs(0.0, 1e-9));
+    }
+  }
+  SECTION("Parallel") {
+    std::vector<Trace> traces(23, trace);
+    for (Trace &input : traces) {
+      std::vector<double> data(100);
+      random_vector(&data);
+      input.data1(data);
+    }
+    for (const stack_method method :
+         {stack_method::linear, stack_method::nth_root,
+          stack_method::phase_weighted}) {
+      const stack_spec spec{80, 0.5, trace.b() + 5.0, method, 3.0};
+      stacker sequential{spec};
+      for (const Trace &input : traces) {
+        sequential.add(input, 0.0);
+      }
+      const stacker parallel{stack(
+          traces.size(),
+          [&traces](const size_t i, stacker *partial) {
+            partial->add(traces[i], 0.0);
+          },
+          spec, 4)};
+      REQUIRE(parallel.count() == 23);
+      const std::vector<double> expected{sequential.result()};
+      const std::vector<double> values{parallel.result()};
+      for (size_t i{0}; i < values.size(); ++i) {
+        REQUIRE_THAT(values[i], WithinAbs(expected[i], 1e-9));
+      }
+    }
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(stacker({0, 1.0}), processing_error);
+    REQUIRE_THROWS_AS(stacker({10, 0.0}), processing_error);
+    REQUIRE_THROWS_AS(stacker({10, 1.0, 0.0, stack_method::nth_root, 0.0}),
+                      processing_error);
+    stacker result{{10, 0.5}};
+    trace.a(unset_double);
+    REQUIRE_THROWS_AS(result.add(trace, time_marker::a), processing_error);
+    trace.delta(0.25);
+    REQUIRE_THROWS_AS(result.add(trace, 0.0), processing_error);
+    REQUIRE_THROWS_AS(result.merge(stacker{{10, 0.25}}), processing_error);
+    REQUIRE(result.count() == 0);
+  }
+}
+
+TEST_CASE("Processing: Array Processing") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  constexpr double delta{0.01};
+  const std::vector<std::array<double, 2>> offsets{
+      {0.0, 0.0}, {0.01, 0.0}, {0.0, 0.012}, {-0.008, 0.005}, {0.004, -0.01}};
+  std::vector<Trace> traces(offsets.size(), gen_fake_trace());
+  for (size_t j{0}; j < traces.size(); ++j) {
+    traces[j].stla(40.0 + offsets[j][0]);
+    traces[j].stlo(-110.0 + offsets[j][1]);
+    traces[j].delta(delta);
+  }
+  const array_geometry geometry{array_coordinates(traces)};
+  // Plane wave (slowness on the grid) of a Gaussian-windowed 2 Hz sine
+  constexpr double slowness_east{0.2};
+  constexpr double slowness_north{-0.1};
+  const auto wavelet{[](const double time) {
+    return std::exp(-(time - 10.0) * (time - 10.0)) *
+           std::sin(2.0 * pi * 2.0 * time);
+  }};
+  for (size_t j{0}; j < traces.size(); ++j) {
+    const double delay{(slowness_east * geometry.east[j]) +
+                       (slowness_north * geometry.north[j])};
+    std::vector<double> data(2000);
+    for (size_t i{0}; i < data.size(); ++i) {
+      data[i] = wavelet((static_cast<double>(i) * delta) - delay);
+    }
+    traces[j].data1(data);
+  }
+  SECTION("Geometry") {
+    REQUIRE(geometry.east.size() == 5);
+    REQUIRE_THAT(geometry.latitude, WithinAbs(40.0012, 1e-9));
+    REQUIRE_THAT(geometry.longitude, WithinAbs(-109.9986, 1e-9));
+    // 0.01 degrees of latitude is about 1.1 km
+    REQUIRE_THAT(geometry.north[1] - geometry.north[0],
+                 WithinAbs(0.01 * earth_radius * rad_per_deg, 1e-9));
+    const slowness_grid grid{0.5, 11};
+    REQUIRE_THAT(grid.value(0), WithinAbs(-0.5, 1e-12));
+    REQUIRE_THAT(grid.value(7), WithinAbs(0.2, 1e-12));
+    REQUIRE_THAT(grid.value(10), WithinAbs(0.5, 1e-12));
+    Trace missing{traces[0]};
+    missing.stla(unset_double);
+    REQUIRE_THROWS_AS(array_coordinates(std::vector<Trace>{missing}),
+                      processing_error);
+    REQUIRE_THROWS_AS(array_coordinates(std::vector<Trace>{}),
+                      processing_error);
+  }
+  SECTION("F-K") {
+    const fk_plan plan{geometry, {0.5, 11}, 2000, delta, 0.5, 5.0};
+    REQUIRE(plan.stations() == 5);
+    REQUIRE(plan.window() == 2000);
+    REQUIRE(plan.grid().points == 11);
+    const fk_result result{plan.power(traces, 0, 2)};
+    REQUIRE(result.power.size() == 121);
+    REQUIRE(result.peak > 0.99);
+    REQUIRE(result.peak <= 1.0 + 1e-9);
+    REQUIRE_THAT(result.slowness_east, WithinAbs(slowness_east, 1e-12));
+    REQUIRE_THAT(result.slowness_north, WithinAbs(slowness_north, 1e-12));
+    REQUIRE_THAT(result.back_azimuth, WithinAbs(296.565051177, 1e-6));
+    REQUIRE_THAT(result.velocity, WithinAbs(1.0 / std::hypot(0.2, 0.1), 1e-9));
+    // Single-threaded and windowed
+    const fk_result serial{plan.power(traces, 0, 1)};
+    REQUIRE(serial.power == result.power);
+    const fk_plan windowed{geometry, {0.5, 11}, 500, delta, 0.5, 5.0};
+    const fk_result part{windowed.power(traces, 750)};
+    REQUIRE_THAT(part.slowness_east, WithinAbs(slowness_east, 1e-12));
+    REQUIRE_THAT(part.slowness_north, WithinAbs(slowness_north, 1e-12));
+  }
+  SECTION("Delay and Sum") {
+    const Trace beam{
+        delay_and_sum(traces, geometry, slowness_east, slowness_north)};
+    REQUIRE(beam.kstnm() == "BEAM");
+    REQUIRE(beam.npts() == 2000);
+    REQUIRE_THAT(beam.stla(), WithinAbs(geometry.latitude, 1e-9));
+    for (size_t i{0}; i < 2000; ++i) {
+      REQUIRE_THAT(beam.data1_view()[i],
+                   WithinAbs(wavelet(static_cast<double>(i) * delta), 0.1));
+    }
+    const Trace wrong{delay_and_sum(traces, geometry, -slowness_east,
+                                    -slowness_north)};
+    REQUIRE(wrong.depmax() < 0.9F * beam.depmax());
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(fk_plan(geometry, {0.5, 11}, 2000, delta, 6.0, 5.0),
+                      processing_error);
+    REQUIRE_THROWS_AS(fk_plan(geometry, {0.5, 0}, 2000, delta, 0.5, 5.0),
+                      processing_error);
+    REQUIRE_THROWS_AS(fk_plan({}, {0.5, 11}, 2000, delta, 0.5, 5.0),
+                      processing_error);
+    const fk_plan plan{geometry, {0.5, 11}, 500, delta, 0.5, 5.0};
+    REQUIRE_THROWS_AS(plan.power(traces, 1600), processing_error);
+    REQUIRE_THROWS_AS(plan.power(std::span<const Trace>{traces}.first(4), 0),
+                      processing_error);
+    const fk_plan coarse{geometry, {0.5, 11}, 500, 0.02, 0.5, 5.0};
+    REQUIRE_THROWS_AS(coarse.power(traces, 0), processing_error);
+    traces[2].b(traces[2].b() + 1.0);
+    REQUIRE_THROWS_AS(plan.power(traces, 0), processing_error);
+    REQUIRE_THROWS_AS(delay_and_sum(traces, geometry, 0.0, 0.0),
+                      processing_error);
+    REQUIRE_THROWS_AS(delay_and_sum(std::span<const Trace>{traces}.first(2),
+                                    geometry, 0.0, 0.0),
+                      processing_error);
+  }
+}
+
+TEST_CASE("Processing: Amplitude Metrics") {
+  std::vector<double> data(1037);
+  random_vector(&data);
+  SECTION("Against Direct Computation") {
+    for (const auto &[window, overlap] :
+         std::vector<std::array<size_t, 2>>{
+             {100, 0}, {100, 50}, {64, 40}, {30, 29}, {1, 0}}) {
+      const amplitude_spec spec{window, overlap, {0.0, 50.0, 95.0, 100.0}};
+      const amplitude_metrics result{amplitudes(data, spec)};
+      const size_t step{window - overlap};
+      REQUIRE(result.windows == 1 + ((data.size() - window) / step));
+      REQUIRE(result.rms.size() == result.windows);
+      REQUIRE(result.percentiles.size() == 4 * result.windows);
+      REQUIRE_THAT(result.time_step, WithinAbs(static_cast<double>(step), 0));
+      for (size_t index{0}; index < result.windows; ++index) {
+        std::vector<double> values(window);
+        double sum{0.0};
+        for (size_t i{0}; i < window; ++i) {
+          values[i] = std::abs(data[(index * step) + i]);
+          sum += values[i] * values[i];
+        }
+        std::ranges::sort(values);
+        REQUIRE_THAT(result.rms[index],
+                     WithinAbs(std::sqrt(sum / static_cast<double>(window)),
+                               1e-9));
+        REQUIRE(result.peak[index] == values.back());
+        REQUIRE(result.percentiles[index * 4] == values.front());
+        REQUIRE(result.percentiles[(index * 4) + 3] == values.back());
+        const double middle{0.5 * static_cast<double>(window - 1)};
+        const auto lower{static_cast<size_t>(middle)};
+        const double median{
+            lower + 1 < window
+                ? values[lower] + ((middle - static_cast<double>(lower)) *
+                                   (values[lower + 1] - values[lower]))
+                : values[lower]};
+        REQUIRE_THAT(result.percentiles[(index * 4) + 1],
+                     WithinAbs(median, 1e-12));
+      }
+    }
+  }
+  SECTION("Traces") {
+    Trace trace{gen_fake_trace()};
+    trace.data1(data);
+    const amplitude_spec spec{200, 100};
+    const amplitude_metrics result{amplitudes(trace, spec)};
+    REQUIRE(result.windows == 9);
+    REQUIRE(result.percentiles.empty());
+    REQUIRE_THAT(result.start,
+                 WithinAbs(trace.b() + (99.5 * trace.delta()), 1e-12));
+    REQUIRE_THAT(result.time_step, WithinAbs(100.0 * trace.delta(), 1e-12));
+    const std::vector<Trace> traces(3, trace);
+    const std::vector<amplitude_metrics> batch{amplitudes(traces, spec, 2)};
+    REQUIRE(batch.size() == 3);
+    for (const amplitude_metrics &metrics : batch) {
+      REQUIRE(metrics.rms == result.rms);
+      REQUIRE(metrics.peak == result.peak);
+    }
+    // Short data has no windows
+    REQUIRE(amplitudes(std::span{data}.first(10), spec).windows == 0);
+  }
+  SECTION("Errors") {
+    REQUIRE_THROWS_AS(amplitudes(data, {0, 0}), processing_error);
+    REQUIRE_THROWS_AS(amplitudes(data, {100, 100}), processing_error);
+    REQUIRE_THROWS_AS(amplitudes(data, {100, 0, {101.0}}), processing_error);
+    REQUIRE_THROWS_AS(amplitudes(data, {100, 0, {-1.0}}), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Level of Detail") {
+  Trace trace{gen_fake_trace()};
+  std::vector<double> data(1000);
+  random_vector(&data);
+  trace.data1(data);
+  const lod_pyramid pyramid{build_lod(trace)};
+  SECTION("Pyramid") {
+    // 250, 63, 16, 4, 1 blocks
+    REQUIRE(pyramid.levels.size() == 5);
+    REQUIRE(pyramid.npts == 1000);
+    REQUIRE(pyramid.block(0) == 4);
+    REQUIRE(pyramid.block(2) == 64);
+    for (size_t level{0}; level < pyramid.levels.size(); ++level) {
+      const size_t block{pyramid.block(level)};
+      REQUIRE(pyramid.levels[level].size() ==
+              2 * ((data.size() + block - 1) / block));
+      for (size_t i{0}; i < pyramid.levels[level].size() / 2; ++i) {
+        const auto [minimum, maximum]{std::ranges::minmax(
+            std::span{data}.subspan(i * block).first(
+                std::min(block, data.size() - (i * block))))};
+        REQUIRE(pyramid.levels[level][2 * i] ==
+                static_cast<float>(minimum));
+        REQUIRE(pyramid.levels[level][(2 * i) + 1] ==
+                static_cast<float>(maximum));
+      }
+    }
+    const auto [minimum, maximum]{std::ranges::minmax(data)};
+    REQUIRE(pyramid.levels.back()[0] == static_cast<float>(minimum));
+    REQUIRE(pyramid.levels.back()[1] == static_cast<float>(maximum));
+    trace.data1({});
+    REQUIRE(build_lod(trace).levels.empty());
+  }
+  SECTION("Range") {
+    // Whole trace in 10 pixels: 100 samples per pixel, 64-sample blocks
+    const double t1{trace.b() + (1000.0 * trace.delta())};
+    const lod_envelope envelope{lod_range(pyramid, trace.b(), t1, 10)};
+    REQUIRE(envelope.level == 2);
+    REQUIRE(envelope.minimum.size() == 10);
+    REQUIRE_THAT(envelope.step, WithinAbs(100.0 * trace.delta(), 1e-12));
+    for (size_t pixel{0}; pixel < 10; ++pixel) {
+      // Never narrower than the data, no wider than the covering blocks
+      const auto [minimum, maximum]{
+          std::ranges::minmax(std::span{data}.subspan(pixel * 100, 100))};
+      const size_t first{(pixel * 100) / 64 * 64};
+      const size_t last{std::min(((pixel * 100) + 99) / 64 * 64 + 64,
+                                 data.size())};
+      const auto [lower, upper]{std::ranges::minmax(
+          std::span{data}.subspan(first, last - first))};
+      REQUIRE(envelope.minimum[pixel] <= static_cast<float>(minimum));
+      REQUIRE(envelope.maximum[pixel] >= static_cast<float>(maximum));
+      REQUIRE(envelope.minimum[pixel] >= static_cast<float>(lower));
+      REQUIRE(envelope.maximum[pixel] <= static_cast<float>(upper));
+    }
+    // Pixels outside the data have no envelope
+    const lod_envelope outside{
+        lod_range(pyramid, trace.b() - 10.0, trace.b() + 40.0, 5)};
+    REQUIRE(std::isnan(outside.minimum[0]));
+    REQUIRE(std::isnan(outside.maximum[0]));
+    REQUIRE_FALSE(std::isnan(outside.minimum[1]));
+    REQUIRE_FALSE(std::isnan(outside.maximum[3]));
+    REQUIRE(std::isnan(outside.maximum[4]));
+    // Zoomed in: finest level
+    const double t_zoom{trace.b() + (10.0 * trace.delta())};
+    const lod_envelope zoomed{lod_range(pyramid, trace.b(), t_zoom, 10)};
+    REQUIRE(zoomed.level == 0);
+    REQUIRE(zoomed.minimum[0] <= static_cast<float>(data[0]));
+    REQUIRE_THROWS_AS(lod_range(pyramid, 1.0, 1.0, 10), processing_error);
+    REQUIRE_THROWS_AS(lod_range(pyramid, 0.0, 1.0, 0), processing_error);
+  }
+  SECTION("Persistence") {
+    REQUIRE(lod_path("data/test.SAC") == "data/test.SAC.lod");
+    std::stringstream stream{};
+    write_lod(pyramid, &stream);
+    const lod_pyramid read{read_lod(&stream)};
+    REQUIRE(read.npts == pyramid.npts);
+    REQUIRE(read.begin == pyramid.begin);
+    REQUIRE(read.delta == pyramid.delta);
+    REQUIRE(read.levels == pyramid.levels);
+    const std::string bytes{stream.str()};
+    std::string corrupt{bytes};
+    corrupt[100] = static_cast<char>(corrupt[100] ^ 1);
+    std::istringstream flipped{corrupt};
+    REQUIRE_THROWS_AS(read_lod(&flipped), io_error);
+    std::istringstream truncated{bytes.substr(0, bytes.size() - 2)};
+    REQUIRE_THROWS_AS(read_lod(&truncated), io_error);
+    std::istringstream wrong{"SACLOD99" + bytes.substr(8)};
+    REQUIRE_THROWS_AS(read_lod(&wrong), io_error);
+    REQUIRE_THROWS_AS(read_lod(std::filesystem::path{"missing.lod"}),
+                      io_error);
+  }
+}
+
+TEST_CASE("Processing: Time Shifting") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  // Band-limited (well below Nyquist) and tapered to zero at the edges
+  const auto signal{[](const double sample) {
+    const double time{(sample - 200.0) / 40.0};
+    return std::exp(-time * time) *
+           (std::sin(2.0 * pi * 0.05 * sample) +
+            (0.5 * std::cos(2.0 * pi * 0.13 * sample)));
+  }};
+  std::vector<double> data(400);
+  for (size_t i{0}; i < data.size(); ++i) {
+    data[i] = signal(static_cast<double>(i));
+  }
+  SECTION("Fractional Shift") {
+    // Windowed-sinc ripple is about 1e-4; the phase ramp is exact
+    for (const auto &[method, tolerance] :
+         std::vector<std::pair<shift_method, double>>{
+             {shift_method::sinc, 3e-4}, {shift_method::fft, 1e-9}}) {
+      for (const double shift : {0.3, -0.45, 2.7, -11.25}) {
+        std::vector<double> shifted{data};
+        fractional_shift(shifted, shift, method);
+        for (size_t i{0}; i < data.size(); ++i) {
+          REQUIRE_THAT(shifted[i], WithinAbs(signal(static_cast<double>(i) -
+                                                    shift),
+                                             tolerance));
+        }
+      }
+    }
+    // Whole samples are exact moves
+    std::vector<double> shifted{data};
+    fractional_shift(shifted, 5.0);
+    REQUIRE(shifted[0] == 0.0);
+    for (size_t i{5}; i < data.size(); ++i) {
+      REQUIRE(shifted[i] == data[i - 5]);
+    }
+    fractional_shift(shifted, 1000.0);
+    REQUIRE(std::ranges::all_of(shifted, [](double v) { return v == 0.0; }));
+  }
+  SECTION("Traces") {
+    Trace trace{gen_fake_trace()};
+    trace.data1(data);
+    const double delta{trace.delta()};
+    const double b_value{trace.b()};
+    // 3.4 samples: 3 in b, 0.4 in the data
+    time_shift(&trace, 3.4 * delta);
+    REQUIRE_THAT(trace.b(), WithinAbs(b_value + (3.0 * delta), 1e-9));
+    REQUIRE_THAT(trace.e(), WithinAbs(trace.b() + (399.0 * delta), 1e-9));
+    for (size_t i{0}; i < data.size(); ++i) {
+      REQUIRE_THAT(trace.data1_view()[i],
+                   WithinAbs(signal(static_cast<double>(i) - 0.4), 3e-4));
+    }
+    trace.leven(false);
+    REQUIRE_THROWS_AS(time_shift(&trace, 1.0), processing_error);
+  }
+  SECTION("Align on Marker") {
+    std::vector<Trace> traces(3, gen_fake_trace());
+    const std::array<double, 3> fractions{0.0, 0.3, -0.4};
+    for (size_t j{0}; j < traces.size(); ++j) {
+      traces[j].data1(data);
+      traces[j].a(traces[j].b() +
+                  ((100.0 + fractions[j]) * traces[j].delta()));
+    }
+    const std::vector<Trace> original{traces};
+    align(traces, time_marker::a, shift_method::sinc, 2);
+    for (size_t j{0}; j < traces.size(); ++j) {
+      const double delta{traces[j].delta()};
+      const double samples{(traces[j].a() - traces[j].b()) / delta};
+      REQUIRE_THAT(samples - std::round(samples), WithinAbs(0.0, 1e-6));
+      REQUIRE_THAT(traces[j].b(),
+                   WithinAbs(original[j].b() + (fractions[j] * delta), 1e-9));
+      REQUIRE(traces[j].a() == original[j].a());
+      for (size_t i{0}; i < data.size(); ++i) {
+        // Same waveform at the new sample times
+        REQUIRE_THAT(traces[j].data1_view()[i],
+                     WithinAbs(signal(static_cast<double>(i) + fractions[j]),
+                               3e-4));
+      }
+    }
+    traces[1].a(unset_double);
+    REQUIRE_THROWS_AS(align(traces, time_marker::a), processing_error);
+  }
+  SECTION("Align on Absolute Time") {
+    std::vector<Trace> traces(2, gen_fake_trace());
+    const double delta{traces[0].delta()};
+    traces[0].data1(data);
+    traces[1].data1(data);
+    traces[1].b(traces[0].b() + (10.3 * delta));
+    traces[1].nzmsec(traces[1].nzmsec() + 1);
+    align(traces, shift_method::fft);
+    for (const Trace &trace : traces) {
+      const double samples{(std::fmod(trace.reference_epoch(), delta) +
+                            std::fmod(trace.b(), delta)) /
+                           delta};
+      REQUIRE_THAT(samples - std::round(samples), WithinAbs(0.0, 1e-6));
+    }
+    traces[1].delta(2.0 * delta);
+    REQUIRE_THROWS_AS(align(traces), processing_error);
+    traces[1].delta(delta);
+    traces[1].nzyear(unset_int);
+    REQUIRE_THROWS_AS(align(traces), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Noise Correlation") {
+  // Station 1 records station 0's noise 7 samples later, station 2 is
+  // independent noise
+  constexpr size_t delay{7};
+  std::vector<double> noise(4000 + delay);
+  random_vector(&noise);
+  std::vector<double> other(4000);
+  random_vector(&other);
+  std::vector<Trace> traces(3, gen_fake_trace());
+  traces[0].data1(std::vector<double>(noise.begin() + delay, noise.end()));
+  traces[1].data1(std::vector<double>(noise.begin(), noise.end() - delay));
+  traces[2].data1(other);
+  const double delta{traces[0].delta()};
+  SECTION("Against Direct Correlation") {
+    noise_spec spec{};
+    spec.window = 1000;
+    spec.overlap = 500;
+    spec.max_lag = 20;
+    spec.normalization = temporal_normalization::none;
+    spec.whiten = false;
+    noise_correlator correlator{3, delta, spec};
+    REQUIRE(correlator.pairs() == 3);
+    REQUIRE(correlator.fft_size() >= 1020);
+    REQUIRE(correlator.bins() == (correlator.fft_size() / 2) + 1);
+    REQUIRE(correlator.add(traces, 2) == 7);
+    REQUIRE(correlator.windows() == 7);
+    // Chunked windows match a single-threaded stack
+    noise_correlator serial{3, delta, spec};
+    REQUIRE(serial.add(traces, 1) == 7);
+    const std::vector<double> chunked{correlator.correlation(0, 1)};
+    const std::vector<double> single{serial.correlation(0, 1)};
+    for (size_t i{0}; i < chunked.size(); ++i) {
+      REQUIRE_THAT(chunked[i], WithinAbs(single[i], 1e-9));
+    }
+    for (const auto &[first, second] :
+         std::vector<std::pair<size_t, size_t>>{{0, 1}, {1, 2}, {2, 0}}) {
+      const std::vector<double> result{correlator.correlation(first, second)};
+      REQUIRE(result.size() == 41);
+      for (std::ptrdiff_t lag{-20}; lag <= 20; ++lag) {
+        double expected{0.0};
+        for (size_t start{0}; start + 1000 <= 4000; start += 500) {
+          const std::span<const double> x{
+              traces[first].data1_view().subspan(start, 1000)};
+          const std::span<const double> y{
+              traces[second].data1_view().subspan(start, 1000)};
+          const double x_mean{std::accumulate(x.begin(), x.end(), 0.0) /
+                              1000.0};
+          const double y_mean{std::accumulate(y.begin(), y.end(), 0.0) /
+                              1000.0};
+          for (std::ptrdiff_t t{0}; t < 1000; ++t) {
+            if ((t + lag >= 0) && (t + lag < 1000)) {
+              expected += (x[static_cast<size_t>(t)] - x_mean) *
+                          (y[static_cast<size_t>(t + lag)] - y_mean);
+            }
+          }
+        }
+        REQUIRE_THAT(result[static_cast<size_t>(lag + 20)],
+                     WithinAbs(expected / 7.0, 1e-9));
+      }
+    }
+  }
+  SECTION("One-Bit and Whitening") {
+    for (const temporal_normalization normalization :
+         {temporal_normalization::one_bit,
+          temporal_normalization::running_mean}) {
+      noise_spec spec{};
+      spec.window = 1000;
+      spec.max_lag = 50;
+      spec.normalization = normalization;
+      spec.running_window = 51;
+      spec.smoothing = 3;
+      spec.band = {0.5, 1.0, 15.0, 18.0};
+      noise_correlator correlator{3, delta, spec};
+      REQUIRE(correlator.bins() < correlator.fft_size() / 2);
+      REQUIRE(correlator.add(traces) == 4);
+      const std::vector<double> result{correlator.correlation(0, 1)};
+      const auto peak{std::ranges::max_element(result) - result.begin()};
+      REQUIRE(peak == 50 + delay);
+      const std::vector<double> reversed{correlator.correlation(1, 0)};
+      REQUIRE(std::ranges::max_element(reversed) - reversed.begin() ==
+              50 - static_cast<std::ptrdiff_t>(delay));
+      // Uncorrelated pair is much weaker
+      const std::vector<double> independent{correlator.correlation(0, 2)};
+      REQUIRE(std::ranges::max(independent) < 0.5 * result[50 + delay]);
+    }
+  }
+  SECTION("Merge") {
+    noise_spec spec{};
+    spec.window = 1000;
+    spec.max_lag = 10;
+    noise_correlator whole{3, delta, spec};
+    whole.add(traces);
+    noise_correlator first{3, delta, spec};
+    noise_correlator second{3, delta, spec};
+    std::vector<Trace> halves{traces};
+    for (Trace &trace : halves) {
+      const std::span<const double> data{trace.data1_view()};
+      trace.data1(std::vector<double>(data.begin(), data.begin() + 2000));
+    }
+    first.add(halves);
+    for (size_t i{0}; i < 3; ++i) {
+      const std::span<const double> data{traces[i].data1_view()};
+      halves[i].data1(std::vector<double>(data.begin() + 2000, data.end()));
+    }
+    second.add(halves);
+    first.merge(second);
+    REQUIRE(first.windows() == whole.windows());
+    const std::vector<double> merged{first.correlation(0, 1)};
+    const std::vector<double> direct{whole.correlation(0, 1)};
+    for (size_t i{0}; i < merged.size(); ++i) {
+      REQUIRE_THAT(merged[i], WithinAbs(direct[i], 1e-9));
+    }
+    spec.max_lag = 5;
+    REQUIRE_THROWS_AS(first.merge(noise_correlator{3, delta, spec}),
+                      processing_error);
+  }
+  SECTION("Errors") {
+    noise_spec spec{};
+    spec.window = 1000;
+    spec.max_lag = 10;
+    REQUIRE(noise_correlator{3, delta, spec}.correlation(0, 1) ==
+            std::vector<double>(21, 0.0));
+    REQUIRE_THROWS_AS(noise_correlator(1, delta, spec), processing_error);
+    REQUIRE_THROWS_AS(noise_correlator(3, 0.0, spec), processing_error);
+    spec.max_lag = 1000;
+    REQUIRE_THROWS_AS(noise_correlator(3, delta, spec), processing_error);
+    spec.max_lag = 10;
+    spec.normalization = temporal_normalization::running_mean;
+    REQUIRE_THROWS_AS(noise_correlator(3, delta, spec), processing_error);
+    spec.normalization = temporal_normalization::one_bit;
+    spec.band = {2.0, 1.0, 3.0, 4.0};
+    REQUIRE_THROWS_AS(noise_correlator(3, delta, spec), processing_error);
+    spec.band = {};
+    noise_correlator correlator{3, delta, spec};
+    REQUIRE_THROWS_AS(correlator.correlation(1, 1), processing_error);
+    REQUIRE_THROWS_AS(correlator.correlation(0, 3), processing_error);
+    REQUIRE_THROWS_AS(
+        correlator.add(std::span<const Trace>{traces}.first(2)),
+        processing_error);
+    traces[1].b(traces[1].b() + 1.0);
+    REQUIRE_THROWS_AS(correlator.add(traces), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Welch PSD and PPSD") {
+  // Uniform white noise on [-1, 1]: variance 1/3, PSD 2 * delta / 3
+  std::vector<double> data(40'000);
+  random_vector(&data);
+  Trace trace{gen_fake_trace()};
+  trace.data1(data);
+  const double delta{trace.delta()};
+  SECTION("Welch") {
+    const power_spectrum psd{psd_welch(trace, 1000, 500)};
+    REQUIRE(psd.segments == 79);
+    REQUIRE(psd.values.size() == 501);
+    REQUIRE_THAT(psd.frequency_step, WithinAbs(1.0 / (1000.0 * delta), 1e-12));
+    // Mean of the spectrogram frames, without storing them
+    const spectrogram_matrix matrix{spectrogram(trace, 1000, 500)};
+    for (size_t k{0}; k < psd.values.size(); ++k) {
+      double sum{0.0};
+      for (size_t frame{0}; frame < matrix.frames; ++frame) {
+        sum += matrix.frame(frame)[k];
+      }
+      REQUIRE_THAT(psd.values[k], WithinAbs(sum / 79.0, 1e-12));
+    }
+    const double mean{
+        std::accumulate(psd.values.begin() + 1, psd.values.end() - 1, 0.0) /
+        499.0};
+    REQUIRE_THAT(mean, WithinAbs(2.0 * delta / 3.0, 0.05 * 2.0 * delta / 3.0));
+    const std::vector<Trace> traces(3, trace);
+    const std::vector<power_spectrum> batch{psd_welch(traces, 1000, 500, 0,
+                                                      taper_window::hann, 2)};
+    REQUIRE(batch.size() == 3);
+    REQUIRE(batch[2].values == psd.values);
+    Trace short_trace{trace};
+    short_trace.data1(std::vector<double>(10, 1.0));
+    REQUIRE(psd_welch(short_trace, 1000, 500).segments == 0);
+    REQUIRE_THROWS_AS(psd_welch(trace, 1000, 1000), processing_error);
+  }
+  SECTION("PPSD") {
+    const ppsd_spec spec{0.01, 100.0, 4, 1.0, -200.0, -50.0, 1.0};
+    ppsd histogram{spec};
+    REQUIRE(histogram.periods() == 54);
+    REQUIRE(histogram.powers() == 150);
+    REQUIRE_THAT(histogram.period(4), WithinAbs(0.02, 1e-12));
+    REQUIRE_THAT(histogram.power(0), WithinAbs(-199.5, 1e-12));
+    // Flat PSD at -95.5 dB, 0.01 Hz steps up to 10 Hz
+    const std::vector<double> flat(1001, std::pow(10.0, -9.55));
+    histogram.add(flat, 0.01);
+    histogram.add(flat, 0.01);
+    REQUIRE(histogram.count() == 2);
+    const std::vector<double> modes{histogram.mode()};
+    for (size_t index{0}; index < histogram.periods(); ++index) {
+      const double frequency{1.0 / histogram.period(index)};
+      // Resolved: the whole octave lies between 0.01 Hz and Nyquist
+      const bool resolved{(frequency * std::sqrt(2.0) <= 10.0) &&
+                          (frequency / std::sqrt(2.0) >= 0.01 - 1e-12)};
+      if (resolved) {
+        REQUIRE_THAT(modes[index], WithinAbs(-95.5, 1e-12));
+        REQUIRE(histogram.histogram()[(index * 150) + 104] == 2);
+      } else if ((frequency * std::sqrt(2.0) > 10.0) ||
+                 (frequency / std::sqrt(2.0) < 0.005)) {
+        REQUIRE(std::isnan(modes[index]));
+      }
+    }
+    // Out-of-range powers count in the edge bins
+    histogram.add(std::vector<double>(1001, 1.0), 0.01);
+    histogram.add(std::vector<double>(1001, 1e-30), 0.01);
+    REQUIRE(histogram.histogram()[(20 * 150) + 149] == 1);
+    REQUIRE(histogram.histogram()[20 * 150] == 1);
+    const std::vector<double> median{histogram.percentile(50.0)};
+    REQUIRE_THAT(median[20], WithinAbs(-95.5, 1e-12));
+    REQUIRE_THAT(histogram.percentile(100.0)[20], WithinAbs(-50.5, 1e-12));
+    REQUIRE_THAT(histogram.percentile(0.0)[20], WithinAbs(-199.5, 1e-12));
+    REQUIRE(std::isnan(histogram.percentile(50.0)[0]));
+    REQUIRE_THROWS_AS(histogram.percentile(101.0), processing_error);
+    REQUIRE_THROWS_AS(histogram.add(flat, 0.0), processing_error);
+  }
+  SECTION("PPSD of Traces") {
+    const spectrogram_plan welch{1000, 750};
+    std::vector<Trace> days(5, trace);
+    for (Trace &day : days) {
+      random_vector(&data);
+      day.data1(data);
+    }
+    const ppsd_spec spec{0.1, 10.0, 8, 1.0, -100.0, 0.0, 0.5};
+    ppsd sequential{spec};
+    size_t segments{0};
+    for (const Trace &day : days) {
+      segments += sequential.add(day, 10'000, 5'000, welch);
+    }
+    REQUIRE(segments == 35);
+    REQUIRE(sequential.count() == 35);
+    const ppsd parallel{probabilistic_psd(days, 10'000, 5'000, welch, spec, 2)};
+    REQUIRE(parallel.count() == 35);
+    REQUIRE(std::ranges::equal(parallel.histogram(), sequential.histogram()));
+    // White noise: 10 log10(2 delta / 3), about -17.8 dB
+    for (const double level : parallel.percentile(50.0)) {
+      REQUIRE_THAT(level, WithinAbs(10.0 * std::log10(2.0 * delta / 3.0), 1.0));
+    }
+    ppsd merged{spec};
+    merged.merge(sequential);
+    merged.merge(parallel);
+    REQUIRE(merged.count() == 70);
+    REQUIRE_THROWS_AS(merged.merge(ppsd{}), processing_error);
+    REQUIRE_THROWS_AS(sequential.add(trace, 500, 0, welch), processing_error);
+    REQUIRE_THROWS_AS(ppsd(ppsd_spec{0.0}), processing_error);
+    REQUIRE_THROWS_AS(ppsd(ppsd_spec{1.0, 10.0, 0}), processing_error);
+  }
+}
+
+TEST_CASE("Processing: Phase Picking") {
+  constexpr double pi{std::numbers::pi_v<double>};
+  // Weak noise, then a strong 4 Hz arrival at sample 600
+  constexpr size_t onset{600};
+  std::vector<double> data(1200);
+  random_vector(&data, -0.05, 0.05);
+  for (size_t i{onset}; i < data.size(); ++i) {
+    const double time{static_cast<double>(i - onset) * 0.025};
+    data[i] += std::exp(-time) * std::sin(2.0 * pi * 4.0 * time + 0.5);
+  }
+  Trace trace{gen_fake_trace()};
+  trace.data1(data);
+  const double delta{trace.delta()};
+  const double onset_time{trace.b() + (static_cast<double>(onset) * delta)};
+  SECTION("Characteristic Functions") {
+    const std::span<const double> window{std::span{data}.subspan(500, 60)};
+    std::vector<double> aic(window.size());
+    aic_function(window, aic);
+    REQUIRE(std::isinf(aic[0]));
+    REQUIRE(std::isinf(aic[1]));
+    REQUIRE(std::isinf(aic[59]));
+    for (size_t k{2}; k < 59; ++k) {
+      const auto variance{[](std::span<const double> values) {
+        const double mean{std::accumulate(values.begin(), values.end(), 0.0) /
+                          static_cast<double>(values.size())};
+        double sum{0.0};
+        for (const double value : values) {
+          sum += (value - mean) * (value - mean);
+        }
+        return sum / static_cast<double>(values.size());
+      }};
+      const double expected{
+          (static_cast<double>(k) * std::log(variance(window.first(k)))) +
+          (static_cast<double>(60 - k) *
+           std::log(variance(window.subspan(k))))};
+      REQUIRE_THAT(aic[k], WithinAbs(expected, 1e-9));
+    }
+    std::vector<double> kurtosis(data.size());
+    kurtosis_function(data, 40, kurtosis);
+    REQUIRE(kurtosis[38] == 0.0);
+    for (const size_t i : {39UL, 100UL, 620UL, 1199UL}) {
+      const std::span<const double> values{
+          std::span{data}.subspan(i - 39, 40)};
+      const double mean{std::accumulate(values.begin(), values.end(), 0.0) /
+                        40.0};
+      double m2{0.0};
+      double m4{0.0};
+      for (const double value : values) {
+        const double square{(value - mean) * (value - mean)};
+        m2 += square / 40.0;
+        m4 += square * square / 40.0;
+      }
+      REQUIRE_THAT(kurtosis[i], WithinAbs((m4 / (m2 * m2)) - 3.0, 1e-6));
+    }
+  }
+  SECTION("Pickers") {
+    for (const auto &[method, tolerance] :
+         std::vector<std::pair<picker_method, double>>{
+             {picker_method::aic, 2.0},
+             {picker_method::kurtosis, 4.0},
+             {picker_method::sta_lta, 3.0}}) {
+      Trace picked{trace};
+      pick_spec spec{};
+      spec.method = method;
+      spec.before = 3.0;
+      spec.after = 3.0;
+      spec.window = 0.25;
+      spec.lta = 2.5;
+      spec.marker = time_marker::t3;
+      const phase_pick pick{pick_phase(&picked, onset_time + 0.3, spec)};
+      REQUIRE_THAT(pick.time, WithinAbs(onset_time, tolerance * delta));
+      REQUIRE(pick.snr > 5.0);
+      REQUIRE(picked.t3() == pick.time);
+      REQUIRE(picked.t0() == trace.t0());
+    }
+    pick_spec spec{};
+    spec.label = "P";
+    spec.min_snr = 1000.0;
+    Trace rejected{trace};
+    const phase_pick low{pick_phase(&rejected, onset_time, spec)};
+    REQUIRE(low.time == unset_double);
+    REQUIRE(low.snr > 0.0);
+    REQUIRE(rejected.t0() == trace.t0());
+    spec.min_snr = 0.0;
+    REQUIRE(pick_phase(&rejected, unset_double, spec).time == unset_double);
+    // No onset above the STA/LTA threshold
+    spec.method = picker_method::sta_lta;
+    spec.on = 1000.0;
+    REQUIRE(pick_phase(&rejected, onset_time, spec).time == unset_double);
+  }
+  SECTION("Batch") {
+    std::vector<Trace> traces(4, trace);
+    for (Trace &copy : traces) {
+      copy.a(onset_time - 0.4);
+    }
+    traces[2].a(unset_double);
+    pick_spec spec{};
+    spec.marker = time_marker::t9;
+    const std::vector<phase_pick> picks{
+        pick_phases(traces, time_marker::a, spec, 2)};
+    REQUIRE(picks.size() == 4);
+    for (size_t i{0}; i < traces.size(); ++i) {
+      if (i == 2) {
+        REQUIRE(picks[i].time == unset_double);
+        REQUIRE(traces[i].t9() == trace.t9());
+      } else {
+        REQUIRE_THAT(picks[i].time, WithinAbs(onset_time, 2.0 * delta));
+        REQUIRE(traces[i].t9() == picks[i].time);
+        REQUIRE(traces[i].kt9() == "AIC");
+      }
+    }
+  }
+  SECTION("Errors") {
+    pick_spec spec{};
+    spec.marker = time_marker::a;
+    REQUIRE_THROWS_AS(pick_phase(&trace, onset_time, spec), processing_error);
+    spec.marker = time_marker::t0;
+    spec.window = 0.0;
+    REQUIRE_THROWS_AS(pick_phase(&trace, onset_time, spec), processing_error);
+    spec.window = 1.0;
+    spec.method = picker_method::sta_lta;
+    spec.lta = 0.5;
+    REQUIRE_THROWS_AS(pick_phase(&trace, onset_time, spec), processing_error);
+    std::vector<Trace> traces(2, trace);
+    traces[1].leven(false);
+    REQUIRE_THROWS_AS(pick_phases(traces, time_marker::a, pick_spec{}),
+                      processing_error);
+  }
+}
+// NOLINTEND(readability-magic-numbers)
+}  // namespace sacfmt
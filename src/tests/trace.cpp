@@ -5,6 +5,8 @@
 #include "sac-format/util.hpp"
 // Standard Library
 //   https://en.cppreference.com/w/cpp/standard_library
+// std::istreambuf_iterator
+#include <iterator>
 // Catch2 https://github.com/catchorg/Catch2/tree/v3.4.0
 #define CATCH_CONFIG_FAST_COMPILE
 #define CATCH_CONFIG_MAIN
@@ -695,6 +697,71 @@ TEST_CASE("Trace: Equality: Inequality: Data2") {
   REQUIRE(trace1 != trace2);
 }
 
+TEST_CASE("Trace: Equality: ULP Distance") {
+  REQUIRE(ulp_distance(1.0F, 1.0F) == 0);
+  REQUIRE(ulp_distance(0.0F, -0.0F) == 0);
+  REQUIRE(ulp_distance(1.0F, std::nextafter(1.0F, 2.0F)) == 1);
+  REQUIRE(ulp_distance(std::nextafter(1.0F, 2.0F), 1.0F) == 1);
+  const float tiny{std::numeric_limits<float>::denorm_min()};
+  REQUIRE(ulp_distance(tiny, -tiny) == 2);
+  REQUIRE(ulp_distance(std::numeric_limits<float>::quiet_NaN(), 1.0F) ==
+          std::numeric_limits<std::int64_t>::max());
+}
+
+TEST_CASE("Trace: Equality: First Mismatch") {
+  std::vector<double> data1(1000);
+  random_vector(&data1);
+  std::vector<double> data2{data1};
+  REQUIRE(first_mismatch(data1, data2) == no_mismatch);
+  SECTION("Mismatch Inside Block") {
+    data2[150] += 1.0;
+    data2[900] += 1.0;
+    REQUIRE(first_mismatch(data1, data2) == 150);
+  }
+  SECTION("Mismatch At End") {
+    data2.back() += 1.0;
+    REQUIRE(first_mismatch(data1, data2) == data1.size() - 1);
+  }
+  SECTION("ULP Tolerance") {
+    data1.assign(100, 1.0);
+    data2.assign(100, static_cast<double>(std::nextafter(1.0F, 2.0F)));
+    REQUIRE(first_mismatch(data1, data2, {0.0, 0}) == 0);
+    REQUIRE(first_mismatch(data1, data2, {0.0, 1}) == no_mismatch);
+  }
+}
+
+TEST_CASE("Trace: Equality: Compare") {
+  Trace trace1{gen_fake_trace()};
+  Trace trace2{trace1};
+  REQUIRE(compare(trace1, trace2).equal());
+  trace2.kinst("Other");
+  trace2.lpspol(!trace1.lpspol());
+  std::vector<double> data{trace2.data1()};
+  data[70000] += 0.5;
+  data[80000] -= 2.0;
+  trace2.data1(data);
+  const trace_comparison result{compare(trace1, trace2)};
+  REQUIRE_FALSE(result.equal());
+  REQUIRE(result.headers.size() == 2);
+  REQUIRE(result.headers[0] == name::lpspol);
+  REQUIRE(result.headers[1] == name::kinst);
+  REQUIRE(result.data1.first_mismatch == 70000);
+  REQUIRE(result.data1.mismatches == 2);
+  REQUIRE_THAT(result.data1.max_abs_error, WithinAbs(2.0, 1e-12));
+  REQUIRE(result.data2.mismatches == 0);
+  SECTION("Different Lengths") {
+    trace2 = trace1;
+    data = trace1.data1();
+    data.resize(data.size() - 10);
+    trace2.data1(data);
+    const trace_comparison lengths{compare(trace1, trace2)};
+    REQUIRE(lengths.headers.size() == 1);
+    REQUIRE(lengths.headers[0] == name::npts);
+    REQUIRE(lengths.data1.first_mismatch == data.size());
+    REQUIRE(lengths.data1.mismatches == 10);
+  }
+}
+
 // Constants for Trace I/O
 const fs::path tmp_dir{fs::temp_directory_path()};
 const fs::path tmp_file{tmp_dir / "test.sac"};
@@ -1141,6 +1208,117 @@ TEST_CASE("Trace: I/O: Random Data Vectors: Modify Data") {
   REQUIRE(trace != in);
 }
 
+TEST_CASE("Trace: I/O: Fingerprint: CRC-32C") {
+  const std::string check{"123456789"};
+  REQUIRE(crc32c(check) == 0xE3069283U);
+  REQUIRE(crc32c(std::string{}) == 0U);
+  // Chaining matches a single pass
+  REQUIRE(crc32c(check.substr(4), crc32c(check.substr(0, 4))) ==
+          crc32c(check));
+}
+
+TEST_CASE("Trace: I/O: Fingerprint: Read/Write") {
+  Trace trace = gen_fake_trace();
+  REQUIRE(!Trace{}.fingerprint().has_value());
+  std::vector data{trace.data1()};
+  random_vector(&data);
+  trace.data1(data);
+  const std::uint32_t written{trace.write(tmp_file)};
+  // Writing does not modify the Trace
+  REQUIRE(!trace.fingerprint().has_value());
+  Trace in{tmp_file};
+  REQUIRE(in.fingerprint() == written);
+  // Matches the checksum of the file bytes
+  std::ifstream file(tmp_file, std::ios::binary);
+  const std::string bytes{std::istreambuf_iterator<char>(file),
+                          std::istreambuf_iterator<char>()};
+  file.close();
+  REQUIRE(in.fingerprint().value() == crc32c(bytes));
+  SECTION("Modified") {
+    // Copies keep it, changes drop it
+    REQUIRE(Trace{in}.fingerprint() == written);
+    Trace header{in};
+    header.kstnm("OTHER");
+    REQUIRE(!header.fingerprint().has_value());
+    Trace view{in};
+    view.data1_view()[0] += 1.0;
+    REQUIRE(!view.fingerprint().has_value());
+    Trace values{in};
+    values.data1(data);
+    REQUIRE(!values.fingerprint().has_value());
+  }
+  SECTION("Sidecar") {
+    write_fingerprint(tmp_file, in.fingerprint().value());
+    REQUIRE(read_fingerprint(tmp_file) == in.fingerprint().value());
+    fs::remove(fingerprint_path(tmp_file));
+    REQUIRE_THROWS_AS(read_fingerprint(tmp_file), io_error);
+  }
+  SECTION("Changed Data") {
+    data[0] += 1.0;
+    trace.data1(data);
+    trace.write(tmp_file);
+    REQUIRE(Trace{tmp_file}.fingerprint() != in.fingerprint());
+  }
+  fs::remove(tmp_file);
+}
+
+TEST_CASE("Trace: Stats: Update") {
+  Trace trace = gen_fake_trace();
+  std::vector data{trace.data1()};
+  random_vector(&data);
+  // Odd size exercises the lane remainder
+  data.push_back(3.5);
+  trace.data1(data);
+  const data_stats stats{trace.update_stats()};
+  const double size{static_cast<double>(data.size())};
+  double sum{0.0};
+  double square{0.0};
+  for (const double value : data) {
+    sum += value;
+    square += value * value;
+  }
+  const double mean{sum / size};
+  double variance{0.0};
+  for (const double value : data) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= size;
+  REQUIRE(stats.count == data.size());
+  REQUIRE(stats.min == *std::min_element(data.begin(), data.end()));
+  REQUIRE(stats.max == *std::max_element(data.begin(), data.end()));
+  REQUIRE_THAT(stats.mean, WithinAbs(mean, 1e-9));
+  REQUIRE_THAT(stats.rms, WithinAbs(std::sqrt(square / size), 1e-9));
+  REQUIRE_THAT(stats.stddev, WithinAbs(std::sqrt(variance), 1e-9));
+  REQUIRE(trace.depmin() == static_cast<float>(stats.min));
+  REQUIRE(trace.depmax() == static_cast<float>(stats.max));
+  REQUIRE(trace.depmen() == static_cast<float>(stats.mean));
+  SECTION("Empty") {
+    Trace empty{};
+    empty.depmin(1.0F);
+    REQUIRE(empty.update_stats().count == 0);
+    REQUIRE(empty.depmin() == unset_float);
+    REQUIRE(empty.depmen() == unset_float);
+  }
+}
+
+TEST_CASE("Trace: I/O: Stats On Write") {
+  Trace trace = gen_fake_trace();
+  std::vector data{trace.data1()};
+  random_vector(&data);
+  trace.data1(data);
+  trace.depmin(unset_float);
+  trace.write(tmp_file, false, true);
+  Trace in{tmp_file};
+  fs::remove(tmp_file);
+  // Original is untouched
+  REQUIRE(trace.depmin() == unset_float);
+  trace.update_stats();
+  REQUIRE(in.depmin() == trace.depmin());
+  REQUIRE(in.depmax() == trace.depmax());
+  REQUIRE(in.depmen() == trace.depmen());
+  REQUIRE(in == trace);
+}
+
 TEST_CASE("Trace: I/O: Legacy Format: nVHdr Conversions") {
   Trace trace = gen_fake_trace();
   trace.nvhdr(6);